@@ -205,17 +205,38 @@ RF_API void* rf_libc_allocator_wrapper(struct rf_allocator* this_allocator, rf_s
 #define RF_NULL_IO                                (RF_LIT(rf_io_callbacks) {0})
 #define RF_FILE_SIZE(io, filename)                ((io).file_size_proc((io).user_data, filename))
 #define RF_READ_FILE(io, filename, dst, dst_size) ((io).read_file_proc((io).user_data, filename, dst, dst_size))
-#define RF_DEFAULT_IO (RF_LIT(rf_io_callbacks)    { NULL, rf_libc_get_file_size, rf_libc_load_file_into_buffer })
+#define RF_OPEN_FILE(io, filename)                ((io).open_file_proc((io).user_data, filename))
+#define RF_READ_STREAM(io, file, dst, dst_size)   ((io).read_stream_proc((io).user_data, file, dst, dst_size))
+#define RF_SKIP_STREAM(io, file, amount)          ((io).skip_stream_proc((io).user_data, file, amount))
+#define RF_STREAM_EOF(io, file)                   ((io).stream_eof_proc((io).user_data, file))
+#define RF_CLOSE_FILE(io, file)                   ((io).close_file_proc((io).user_data, file))
+#define RF_IO_SUPPORTS_STREAMING(io)              ((io).open_file_proc && (io).read_stream_proc && (io).skip_stream_proc && (io).stream_eof_proc && (io).close_file_proc)
+#define RF_DEFAULT_IO (RF_LIT(rf_io_callbacks)    { NULL, rf_libc_get_file_size, rf_libc_load_file_into_buffer, rf_libc_open_file, rf_libc_read_stream, rf_libc_skip_stream, rf_libc_stream_eof, rf_libc_close_file })
 
+/*
+ * The streaming procs are optional, loaders that support streaming use them when all of them are set and read the file in small pieces
+ * instead of loading all of it into a temporary buffer first. Io callbacks with only the first two procs keep working as before.
+ */
 typedef struct rf_io_callbacks
 {
     void*  user_data;
-    rf_int (*file_size_proc) (void* user_data, const char* filename);
-    bool   (*read_file_proc) (void* user_data, const char* filename, void* dst, rf_int dst_size); // Returns true if operation was successful
+    rf_int (*file_size_proc)   (void* user_data, const char* filename);
+    bool   (*read_file_proc)   (void* user_data, const char* filename, void* dst, rf_int dst_size); // Returns true if operation was successful
+
+    void*  (*open_file_proc)   (void* user_data, const char* filename); // Returns a handle passed to the other streaming procs or NULL on failure
+    rf_int (*read_stream_proc) (void* user_data, void* file, void* dst, rf_int dst_size); // Returns the number of bytes read, less than dst_size only at the end of the file or on error
+    void   (*skip_stream_proc) (void* user_data, void* file, rf_int amount); // Moves the read position by amount bytes, amount can be negative
+    bool   (*stream_eof_proc)  (void* user_data, void* file); // Returns true once the end of the file was reached or a read failed
+    void   (*close_file_proc)  (void* user_data, void* file);
 } rf_io_callbacks;
 
 RF_API rf_int rf_libc_get_file_size(void* user_data, const char* filename);
 RF_API bool rf_libc_load_file_into_buffer(void* user_data, const char* filename, void* dst, rf_int dst_size);
+RF_API void* rf_libc_open_file(void* user_data, const char* filename);
+RF_API rf_int rf_libc_read_stream(void* user_data, void* file, void* dst, rf_int dst_size);
+RF_API void rf_libc_skip_stream(void* user_data, void* file, rf_int amount);
+RF_API bool rf_libc_stream_eof(void* user_data, void* file);
+RF_API void rf_libc_close_file(void* user_data, void* file);
 
 #pragma endregion
 
@@ -289,6 +310,39 @@ RF_API rf_int rf_libc_rand_wrapper(rf_int min, rf_int max);
 
 #pragma endregion
 
+#pragma region job system
+
+#define RF_NULL_JOB_SYSTEM   (RF_LIT(rf_job_system) {0})
+#define RF_SERIAL_JOB_SYSTEM (RF_LIT(rf_job_system) { NULL, rf_serial_parallel_for })
+
+#if defined(RAYFORK_ENABLE_THREADS)
+    #define RF_DEFAULT_JOB_SYSTEM       (RF_LIT(rf_job_system) { NULL, rf_threads_parallel_for })
+    #define RF_SPAWN_THREADS_JOB_SYSTEM (RF_LIT(rf_job_system) { NULL, rf_threads_spawn_parallel_for })
+#else
+    #define RF_DEFAULT_JOB_SYSTEM RF_SERIAL_JOB_SYSTEM
+#endif
+
+typedef void (*rf_job_proc)(void* job_data, rf_int job_index);
+
+typedef struct rf_job_system
+{
+    void* user_data;
+    void (*parallel_for_proc)(void* user_data, rf_job_proc job_proc, void* job_data, rf_int job_count); // Must call job_proc once for every index in [0, job_count) and return only after all the calls finished
+} rf_job_system;
+
+RF_API void rf_set_job_system(rf_job_system job_system); // If no job system is set RF_DEFAULT_JOB_SYSTEM is used
+
+RF_API void rf_serial_parallel_for(void* user_data, rf_job_proc job_proc, void* job_data, rf_int job_count);
+
+#if defined(RAYFORK_ENABLE_THREADS)
+RF_API void rf_threads_parallel_for(void* user_data, rf_job_proc job_proc, void* job_data, rf_int job_count); // Runs the jobs on a pool with one thread per core, started on the first call. user_data can optionally point to an int with the max amount of threads to use
+RF_API void rf_threads_spawn_parallel_for(void* user_data, rf_job_proc job_proc, void* job_data, rf_int job_count); // Same as rf_threads_parallel_for but starts and joins new threads on every call instead of using the pool
+RF_API int rf_threads_count(void); // Threads of the pool that run the jobs of rf_threads_parallel_for, the calling thread included
+RF_API void rf_threads_shutdown(void); // Stops and joins the threads of the pool, the next rf_threads_parallel_for starts them again
+#endif
+
+#pragma endregion
+
 #endif
 /*** End of inlined file: rayfork-std.h ***/
 
@@ -519,6 +573,11 @@ RF_API bool rf_check_collision_point_rec(rf_vec2 point, rf_rec rec); // Check if
 RF_API bool rf_check_collision_point_circle(rf_vec2 point, rf_vec2 center, float radius); // Check if point is inside circle
 RF_API bool rf_check_collision_point_triangle(rf_vec2 point, rf_vec2 p1, rf_vec2 p2, rf_vec2 p3); // Check if point is inside a triangle
 
+RF_API int rf_check_collision_circles_batch(rf_vec2 center, float radius, const float* x, const float* y, const float* radii, int count, int* hits); // Check collision between a circle and an array of circles, returns the number of indices written to hits
+RF_API int rf_check_collision_circle_rec_batch(rf_vec2 center, float radius, const float* x, const float* y, const float* width, const float* height, int count, int* hits); // Check collision between a circle and an array of rectangles, returns the number of indices written to hits
+RF_API int rf_check_collision_recs_batch(rf_rec rec, const float* x, const float* y, const float* width, const float* height, int count, int* hits); // Check collision between a rectangle and an array of rectangles, returns the number of indices written to hits
+RF_API void rf_move_wrap_batch(float* x, float* y, const float* speed_x, const float* speed_y, const float* margins, int count, rf_rec bounds); // Move an array of points by their speeds, wrapping the ones that leave bounds by more than their margin to the opposite side
+
 RF_API rf_rec rf_get_collision_rec(rf_rec rec1, rf_rec rec2); // Get collision rectangle for two rectangles collision
 
 RF_API bool rf_check_collision_spheres(rf_vec3 center_a, float radius_a, rf_vec3 center_b, float radius_b); // Detect collision between two spheres
@@ -536,6 +595,45 @@ RF_API rf_ray_hit_info rf_collision_ray_ground(rf_ray ray, float ground_height);
 
 #pragma endregion
 
+#pragma region spatial grid
+
+/*
+ * Uniform grid broadphase for 2d collisions. Rebuild it every frame from the recs of the entities, then query an area or
+ * enumerate the overlapping pairs and run the exact collision checks only on those.
+ */
+typedef struct rf_spatial_grid
+{
+    rf_rec bounds;    // Area split in cells, entities outside of it are put in the border cells
+    float  cell_size;
+    int    cells_x;
+    int    cells_y;
+
+    rf_rec* recs;     // Recs of the entities from the last build, indexed by entity
+    int     count;
+    int     capacity;
+
+    int* cell_start;   // Entities of cell c are cell_entries[cell_start[c]] to cell_entries[cell_start[c + 1] - 1]
+    int* cell_entries; // Entity indices sorted by cell, an entity is in every cell its rec touches
+    int  entries_capacity;
+
+    rf_allocator allocator;
+    bool valid;
+} rf_spatial_grid;
+
+typedef struct rf_spatial_grid_pair
+{
+    int a;
+    int b;
+} rf_spatial_grid_pair;
+
+RF_API rf_spatial_grid rf_load_spatial_grid(rf_rec bounds, float cell_size, int capacity, rf_allocator allocator);
+RF_API bool rf_spatial_grid_build(rf_spatial_grid* grid, const rf_rec* recs, int count); // Replace the entities of the grid, O(count + cells)
+RF_API int rf_spatial_grid_query(const rf_spatial_grid* grid, rf_rec area, int* dst, int dst_size); // Get the entities whose rec overlaps area
+RF_API int rf_spatial_grid_pairs(const rf_spatial_grid* grid, rf_spatial_grid_pair* dst, int dst_size); // Get every pair of entities whose recs overlap
+RF_API void rf_unload_spatial_grid(rf_spatial_grid grid);
+
+#pragma endregion
+
 #pragma region base64
 
 typedef struct rf_base64_output
@@ -800,6 +898,70 @@ typedef struct rf_gif
     };
 } rf_gif;
 
+/*
+ * Plays a gif by decoding one frame at a time, only the decoder state and the last frames are kept in memory.
+ * The frame image is owned by the player and changes every time the player moves to another frame.
+ */
+typedef struct rf_gif_player
+{
+    rf_image frame;       // The current frame in RGBA
+    int      frame_index; // Index of the current frame, goes back to 0 when the animation loops
+    int      frame_delay; // How long the current frame is shown in milliseconds
+    float    frame_time;  // How long the current frame has been shown in seconds
+    bool     valid;
+
+    struct rf_gif_decoder* decoder;
+} rf_gif_player;
+
+/*
+ * One bit per pixel of a sprite, used for pixel perfect collisions.
+ * Bit i of word w in a row is the pixel at x = w * 64 + i. Every row has a zero word before and after its pixels
+ * so the collision test can read shifted words without checking the row ends.
+ */
+typedef struct rf_collision_mask
+{
+    uint64_t* bits;
+    int       width;
+    int       height;
+    int       words_per_row; // Words in a row including the two padding words
+    int       min_x, min_y;  // Bounds of the set pixels, min is bigger than max when no pixel is set
+    int       max_x, max_y;
+    bool      valid;
+} rf_collision_mask;
+
+#define RF_IMAGE_PIPELINE_MAX_OPS (16)
+
+typedef enum rf_image_op_type
+{
+    RF_IMAGE_OP_COLOR_TINT,
+    RF_IMAGE_OP_COLOR_INVERT,
+    RF_IMAGE_OP_COLOR_GRAYSCALE,
+    RF_IMAGE_OP_COLOR_CONTRAST,
+    RF_IMAGE_OP_COLOR_BRIGHTNESS,
+    RF_IMAGE_OP_COLOR_REPLACE,
+    RF_IMAGE_OP_FLIP_VERTICAL,
+    RF_IMAGE_OP_FLIP_HORIZONTAL,
+    RF_IMAGE_OP_ROTATE_CW,
+    RF_IMAGE_OP_ROTATE_CCW,
+} rf_image_op_type;
+
+typedef struct rf_image_op
+{
+    rf_image_op_type type;
+    rf_color color;   // Tint color or color to replace
+    rf_color replace; // Replacement color
+    float value;      // Contrast or brightness
+} rf_image_op;
+
+// Records image operations so that they can be executed in a single pass over the image with rf_image_pipeline_execute
+typedef struct rf_image_pipeline
+{
+    rf_image image;
+    rf_image_op ops[RF_IMAGE_PIPELINE_MAX_OPS];
+    int ops_count;
+    bool valid;
+} rf_image_pipeline;
+
 #pragma region extract image data functions
 RF_API int rf_image_size(rf_image image);
 RF_API int rf_image_size_in_format(rf_image image, rf_pixel_format format);
@@ -810,8 +972,12 @@ RF_API bool rf_image_get_pixels_as_normalized_to_buffer(rf_image image, rf_vec4*
 RF_API rf_color* rf_image_pixels_to_rgba32(rf_image image, rf_allocator allocator);
 RF_API rf_vec4* rf_image_compute_pixels_to_normalized(rf_image image, rf_allocator allocator);
 
-RF_API void rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size);
-RF_API rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator);
+RF_API rf_int rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size, rf_allocator temp_allocator);
+RF_API rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator, rf_allocator temp_allocator);
+RF_API rf_int rf_image_gen_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size, rf_allocator temp_allocator);
+RF_API rf_palette rf_image_gen_palette(rf_image image, rf_int palette_size, rf_allocator allocator, rf_allocator temp_allocator);
+RF_API rf_image rf_image_quantize_to_buffer(rf_image image, rf_palette palette, bool dither, rf_color* dst, rf_int dst_size, rf_allocator temp_allocator);
+RF_API rf_image rf_image_quantize(rf_image image, rf_palette palette, bool dither, rf_allocator allocator, rf_allocator temp_allocator);
 RF_API rf_rec rf_image_alpha_border(rf_image image, float threshold);
 #pragma endregion
 
@@ -835,9 +1001,26 @@ RF_API int rf_mipmaps_image_size(rf_mipmaps_image image);
 RF_API rf_mipmaps_stats rf_compute_mipmaps_stats(rf_image image, int desired_mipmaps_count);
 RF_API rf_mipmaps_image rf_image_gen_mipmaps_to_buffer(rf_image image, int gen_mipmaps_count, void* dst, rf_int dst_size, rf_allocator temp_allocator);  // Generate all mipmap levels for a provided image. image.data is scaled to include mipmap levels. Mipmaps format is the same as base image
 RF_API rf_mipmaps_image rf_image_gen_mipmaps(rf_image image, int desired_mipmaps_count, rf_allocator allocator, rf_allocator temp_allocator);
+RF_API rf_mipmaps_image rf_image_gen_srgb_mipmaps_to_buffer(rf_image image, int gen_mipmaps_count, void* dst, rf_int dst_size, rf_allocator temp_allocator); // Same as rf_image_gen_mipmaps_to_buffer but color channels are averaged in linear space
+RF_API rf_mipmaps_image rf_image_gen_srgb_mipmaps(rf_image image, int desired_mipmaps_count, rf_allocator allocator, rf_allocator temp_allocator);
 RF_API void rf_unload_mipmaps_image(rf_mipmaps_image image, rf_allocator allocator);
 #pragma endregion
 
+#pragma region block compression
+RF_API bool rf_supports_block_compression(rf_compressed_pixel_format format); // DXT1, DXT3, DXT5, ETC1, ETC2 RGB and ETC2 EAC RGBA can be encoded at runtime
+RF_API rf_image rf_image_compress_to_buffer(rf_image image, rf_compressed_pixel_format dst_format, void* dst, rf_int dst_size, rf_allocator temp_allocator); // Encode an uncompressed image to a block compressed format, the blocks are encoded in parallel on the job system
+RF_API rf_image rf_image_compress(rf_image image, rf_compressed_pixel_format dst_format, rf_allocator allocator, rf_allocator temp_allocator);
+#pragma endregion
+
+#pragma region collision mask
+RF_API rf_int rf_collision_mask_size(int width, int height);
+RF_API rf_collision_mask rf_collision_mask_from_image_to_buffer(rf_image image, float threshold, void* dst, rf_int dst_size, rf_allocator temp_allocator); // Pixels with an alpha above threshold * 255 are set
+RF_API rf_collision_mask rf_collision_mask_from_image(rf_image image, float threshold, rf_allocator allocator, rf_allocator temp_allocator);
+RF_API bool rf_collision_mask_get(rf_collision_mask mask, int x, int y);
+RF_API bool rf_check_collision_masks(rf_collision_mask a, int a_x, int a_y, rf_collision_mask b, int b_x, int b_y); // Check if any set pixel of a at (a_x, a_y) overlaps a set pixel of b at (b_x, b_y)
+RF_API void rf_unload_collision_mask(rf_collision_mask mask, rf_allocator allocator);
+#pragma endregion
+
 #pragma region dds
 RF_API rf_int rf_get_dds_image_size(const void* src, rf_int src_size);
 RF_API rf_mipmaps_image rf_load_dds_image_to_buffer(const void* src, rf_int src_size, void* dst, rf_int dst_size);
@@ -865,6 +1048,12 @@ RF_API rf_gif rf_load_animated_gif_file(const char* filename, rf_allocator alloc
 RF_API rf_sizei rf_gif_frame_size(rf_gif gif);
 RF_API rf_image rf_get_frame_from_gif(rf_gif gif, int frame);
 RF_API void rf_unload_gif(rf_gif gif, rf_allocator allocator);
+
+RF_API rf_gif_player rf_load_gif_player(const void* data, rf_int data_size, rf_allocator allocator); // The data is read while playing and must outlive the player
+RF_API rf_gif_player rf_load_gif_player_from_file(const char* filename, rf_allocator allocator, rf_io_callbacks io); // Streams the file when the io supports it, otherwise the player keeps a copy of the file
+RF_API bool rf_gif_player_next_frame(rf_gif_player* player); // Decodes the next frame, returns false if the gif is corrupt
+RF_API bool rf_gif_player_update(rf_gif_player* player, float delta_time); // Advances the animation by delta_time seconds, returns true if the frame changed
+RF_API void rf_unload_gif_player(rf_gif_player* player);
 #pragma endregion
 
 #pragma region image gen
@@ -910,7 +1099,10 @@ RF_API rf_image rf_image_alpha_premultiply(rf_image image, rf_allocator allocato
 RF_API rf_rec rf_image_alpha_crop_rec(rf_image image, float threshold);
 RF_API rf_image rf_image_alpha_crop(rf_image image, float threshold, rf_allocator allocator);
 
+RF_API rf_image rf_image_dither_to_buffer(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, void* dst, rf_int dst_size, rf_allocator temp_allocator);
 RF_API rf_image rf_image_dither(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, rf_allocator allocator, rf_allocator temp_allocator);
+RF_API rf_image rf_image_dither_ordered_to_buffer(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, void* dst, rf_int dst_size);
+RF_API rf_image rf_image_dither_ordered(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, rf_allocator allocator);
 
 RF_API void rf_image_flip_vertical_in_place(rf_image* image);
 RF_API rf_image rf_image_flip_vertical_to_buffer(rf_image image, void* dst, rf_int dst_size);
@@ -920,10 +1112,13 @@ RF_API void rf_image_flip_horizontal_in_place(rf_image* image);
 RF_API rf_image rf_image_flip_horizontal_to_buffer(rf_image image, void* dst, rf_int dst_size);
 RF_API rf_image rf_image_flip_horizontal(rf_image image, rf_allocator allocator);
 
+RF_API void rf_image_rotate_cw_in_place(rf_image* image);
 RF_API rf_image rf_image_rotate_cw_to_buffer(rf_image image, void* dst, rf_int dst_size);
-RF_API rf_image rf_image_rotate_cw(rf_image image);
+RF_API rf_image rf_image_rotate_cw(rf_image image, rf_allocator allocator);
+
+RF_API void rf_image_rotate_ccw_in_place(rf_image* image);
 RF_API rf_image rf_image_rotate_ccw_to_buffer(rf_image image, void* dst, rf_int dst_size);
-RF_API rf_image rf_image_rotate_ccw(rf_image image);
+RF_API rf_image rf_image_rotate_ccw(rf_image image, rf_allocator allocator);
 
 RF_API rf_image rf_image_color_tint_to_buffer(rf_image image, rf_color color, void* dst, rf_int dst_size);
 RF_API rf_image rf_image_color_tint(rf_image image, rf_color color);
@@ -938,6 +1133,20 @@ RF_API rf_image rf_image_color_brightness(rf_image image, int brightness);
 RF_API rf_image rf_image_color_replace_to_buffer(rf_image image, rf_color color, rf_color replace, void* dst, rf_int dst_size);
 RF_API rf_image rf_image_color_replace(rf_image image, rf_color color, rf_color replace);
 
+RF_API rf_image_pipeline rf_image_pipeline_begin(rf_image image);
+RF_API void rf_image_pipeline_color_tint(rf_image_pipeline* pipeline, rf_color color);
+RF_API void rf_image_pipeline_color_invert(rf_image_pipeline* pipeline);
+RF_API void rf_image_pipeline_color_grayscale(rf_image_pipeline* pipeline);
+RF_API void rf_image_pipeline_color_contrast(rf_image_pipeline* pipeline, float contrast);
+RF_API void rf_image_pipeline_color_brightness(rf_image_pipeline* pipeline, int brightness);
+RF_API void rf_image_pipeline_color_replace(rf_image_pipeline* pipeline, rf_color color, rf_color replace);
+RF_API void rf_image_pipeline_flip_vertical(rf_image_pipeline* pipeline);
+RF_API void rf_image_pipeline_flip_horizontal(rf_image_pipeline* pipeline);
+RF_API void rf_image_pipeline_rotate_cw(rf_image_pipeline* pipeline);
+RF_API void rf_image_pipeline_rotate_ccw(rf_image_pipeline* pipeline);
+RF_API rf_image rf_image_pipeline_execute_to_buffer(const rf_image_pipeline* pipeline, void* dst, rf_int dst_size);
+RF_API rf_image rf_image_pipeline_execute(const rf_image_pipeline* pipeline, rf_allocator allocator);
+
 RF_API void rf_image_draw(rf_image* dst, rf_image src, rf_rec src_rec, rf_rec dst_rec, rf_color tint, rf_allocator temp_allocator);
 RF_API void rf_image_draw_rectangle(rf_image* dst, rf_rec rec, rf_color color, rf_allocator temp_allocator);
 RF_API void rf_image_draw_rectangle_lines(rf_image* dst, rf_rec rec, int thick, rf_color color, rf_allocator temp_allocator);
@@ -1363,6 +1572,7 @@ RF_API unsigned int rf_gfx_load_texture(void* data, int width, int height, rf_pi
 RF_API unsigned int rf_gfx_load_texture_depth(int width, int height, int bits, bool use_render_buffer); // Load depth texture/renderbuffer (to be attached to fbo)
 RF_API unsigned int rf_gfx_load_texture_cubemap(void* data, int size, rf_pixel_format format); // Load texture cubemap
 RF_API void rf_gfx_update_texture(unsigned int id, int width, int height, rf_pixel_format format, const void* pixels, int pixels_size); // Update GPU texture with new data
+RF_API void rf_gfx_update_texture_rec(unsigned int id, int x, int y, int width, int height, rf_pixel_format format, const void* pixels, int pixels_size); // Update a region of a GPU texture, pixels holds only the region
 RF_API rf_gfx_pixel_format rf_gfx_get_internal_texture_formats(rf_pixel_format format); // Get OpenGL internal formats
 RF_API void rf_gfx_unload_texture(unsigned int id); // Unload texture from GPU memory
 
@@ -2003,10 +2213,13 @@ RF_API rf_texture2d rf_load_texture_from_file(const char* filename, rf_allocator
 RF_API rf_texture2d rf_load_texture_from_file_data(const void* data, rf_int dst_size, rf_allocator temp_allocator); // Load texture from an image file data using stb
 RF_API rf_texture2d rf_load_texture_from_image(rf_image image); // Load texture from image data
 RF_API rf_texture2d rf_load_texture_from_image_with_mipmaps(rf_mipmaps_image image); // Load texture from image data
+RF_API rf_texture2d rf_load_compressed_texture_from_image(rf_image image, rf_compressed_pixel_format format, rf_allocator temp_allocator); // Compress an image on the cpu and load it, uses the image as is if the gpu doesn't support the format
 RF_API rf_texture_cubemap rf_load_texture_cubemap_from_image(rf_image image, rf_cubemap_layout_type layout_type, rf_allocator temp_allocator); // Load cubemap from image, multiple image cubemap layouts supported
 RF_API rf_render_texture2d rf_load_render_texture(int width, int height); // Load texture for rendering (framebuffer)
 
 RF_API void rf_update_texture(rf_texture2d texture, const void* pixels, rf_int pixels_size); // Update GPU texture with new data. Pixels data must match texture.format
+RF_API void rf_update_texture_rec(rf_texture2d texture, rf_rec rec, const void* pixels, rf_int pixels_size); // Update a region of a GPU texture, pixels holds the rows of the region one after another and the parts outside of the texture are skipped
+RF_API void rf_update_texture_from_gif_player(rf_texture2d texture, const rf_gif_player* player); // Upload the current frame of a gif player, the texture must be RGBA and the size of the gif
 RF_API void rf_gen_texture_mipmaps(rf_texture2d* texture); // Generate GPU mipmaps for a texture
 RF_API void rf_set_texture_filter(rf_texture2d texture, rf_texture_filter_mode filter_mode); // Set texture scaling filter mode
 RF_API void rf_set_texture_wrap(rf_texture2d texture, rf_texture_wrap_mode wrap_mode); // Set texture wrapping mode
@@ -2492,6 +2705,8 @@ typedef struct rf_context
 
     rf_logger logger;
     rf_log_type logger_filter;
+
+    rf_job_system job_system;
 } rf_context;
 
 RF_API void rf_init_context(rf_context* ctx);
@@ -2525,6 +2740,7 @@ RF_API void rf_set_shapes_texture(rf_texture2d texture, rf_rec source); // Defin
 RF_API rf_material rf_load_default_material_ez();
 RF_API rf_image rf_get_screen_data_ez();
 RF_API rf_base64_output rf_decode_base64_ez(const unsigned char* input);
+RF_API rf_spatial_grid rf_load_spatial_grid_ez(rf_rec bounds, float cell_size, int capacity);
 RF_API rf_image rf_gfx_read_texture_pixels_ez(rf_texture2d texture);
 
 #pragma region image
@@ -2532,6 +2748,8 @@ RF_API rf_image rf_gfx_read_texture_pixels_ez(rf_texture2d texture);
 RF_API rf_color* rf_image_pixels_to_rgba32_ez(rf_image image);
 RF_API rf_vec4* rf_image_compute_pixels_to_normalized_ez(rf_image image);
 RF_API rf_palette rf_image_extract_palette_ez(rf_image image, int palette_size);
+RF_API rf_palette rf_image_gen_palette_ez(rf_image image, int palette_size);
+RF_API rf_image rf_image_quantize_ez(rf_image image, rf_palette palette, bool dither);
 #pragma endregion
 
 #pragma region loading & unloading functions
@@ -2555,9 +2773,14 @@ RF_API rf_image rf_image_alpha_clear_ez(rf_image image, rf_color color, float th
 RF_API rf_image rf_image_alpha_premultiply_ez(rf_image image);
 RF_API rf_image rf_image_alpha_crop_ez(rf_image image, float threshold);
 RF_API rf_image rf_image_dither_ez(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp);
+RF_API rf_image rf_image_dither_ordered_ez(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp);
 
 RF_API rf_image rf_image_flip_vertical_ez(rf_image image);
 RF_API rf_image rf_image_flip_horizontal_ez(rf_image image);
+RF_API rf_image rf_image_rotate_cw_ez(rf_image image);
+RF_API rf_image rf_image_rotate_ccw_ez(rf_image image);
+
+RF_API rf_image rf_image_pipeline_execute_ez(const rf_image_pipeline* pipeline);
 
 RF_API rf_vec2 rf_get_seed_for_cellular_image_ez(int seeds_per_row, int tile_size, int i);
 
@@ -2573,9 +2796,19 @@ RF_API rf_image rf_gen_image_cellular_ez(int width, int height, int tile_size);
 
 #pragma region mipmaps
 RF_API rf_mipmaps_image rf_image_gen_mipmaps_ez(rf_image image, int gen_mipmaps_count);
+RF_API rf_mipmaps_image rf_image_gen_srgb_mipmaps_ez(rf_image image, int gen_mipmaps_count);
 RF_API void rf_unload_mipmaps_image_ez(rf_mipmaps_image image);
 #pragma endregion
 
+#pragma region block compression
+RF_API rf_image rf_image_compress_ez(rf_image image, rf_compressed_pixel_format dst_format);
+#pragma endregion
+
+#pragma region collision mask
+RF_API rf_collision_mask rf_collision_mask_from_image_ez(rf_image image, float threshold);
+RF_API void rf_unload_collision_mask_ez(rf_collision_mask mask);
+#pragma endregion
+
 #pragma region dds
 RF_API rf_mipmaps_image rf_load_dds_image_ez(const void* src, int src_size);
 RF_API rf_mipmaps_image rf_load_dds_image_from_file_ez(const char* file);
@@ -2596,12 +2829,15 @@ RF_API rf_mipmaps_image rf_load_ktx_image_from_file_ez(const char* file);
 RF_API rf_gif rf_load_animated_gif_ez(const void* data, int data_size);
 RF_API rf_gif rf_load_animated_gif_file_ez(const char* filename);
 RF_API void rf_unload_gif_ez(rf_gif gif);
+RF_API rf_gif_player rf_load_gif_player_ez(const void* data, int data_size);
+RF_API rf_gif_player rf_load_gif_player_from_file_ez(const char* filename);
 #pragma endregion
 
 #pragma region texture
 RF_API rf_texture2d rf_load_texture_from_file_ez(const char* filename);
 RF_API rf_texture2d rf_load_texture_from_file_data_ez(const void* data, int dst_size);
 RF_API rf_texture_cubemap rf_load_texture_cubemap_from_image_ez(rf_image image, rf_cubemap_layout_type layout_type);
+RF_API rf_texture2d rf_load_compressed_texture_from_image_ez(rf_image image, rf_compressed_pixel_format format);
 #pragma endregion
 
 #pragma region font
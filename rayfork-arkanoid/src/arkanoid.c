@@ -20,6 +20,10 @@
 #define LINES_OF_BRICKS         5
 #define BRICKS_PER_LINE        20
 
+#define BALL_SPEED              5.0f
+#define MAX_BALL_BOUNCES        8           // Bounces resolved in one frame, the ball stops for the rest of the frame after
+#define BALL_HIT_TOLERANCE      0.001f      // Fraction of a frame a hit can be late because of rounding and still count
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -43,6 +47,8 @@ typedef struct Brick {
     bool active;
 } Brick;
 
+typedef enum BallHit { HIT_NONE = 0, HIT_WALL, HIT_FLOOR, HIT_PLAYER, HIT_BRICK } BallHit;
+
 //------------------------------------------------------------------------------------
 // Global Variables Declaration
 //------------------------------------------------------------------------------------
@@ -53,6 +59,7 @@ static Player player = { 0 };
 static Ball ball = { 0 };
 static Brick brick[LINES_OF_BRICKS][BRICKS_PER_LINE] = { 0 };
 static rf_vec2 brickSize = { 0 };
+static int activeBricks = 0;
 
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
@@ -63,6 +70,11 @@ static void DrawGame(void);                                      // Draw game (o
 static void UnloadGame(void);                                    // Unload game
 static void UpdateDrawFrame(const platform_input_state* input);  // Update and Draw (one frame)
 
+// Additional module functions
+static bool SweepCircleRec(rf_vec2 position, rf_vec2 speed, float radius, rf_rec rec, float maxTime, float* time, rf_vec2* normal);
+static bool SweepBallBricks(float maxTime, float* time, rf_vec2* normal, int* hitLine, int* hitBrick);
+static void UpdateBall(void);
+
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
@@ -128,6 +140,8 @@ void InitGame(void)
             brick[i][j].active = true;
         }
     }
+
+    activeBricks = LINES_OF_BRICKS * BRICKS_PER_LINE;
 }
 
 // Update game (one frame)
@@ -151,102 +165,20 @@ void UpdateGame(const platform_input_state* input)
                 if (input->keys[KEYCODE_SPACE] == KEY_PRESSED_DOWN)
                 {
                     ball.active = true;
-                    ball.speed = (rf_vec2){ 0, -5 };
+                    ball.speed = (rf_vec2){ 0, -BALL_SPEED };
                 }
             }
 
-            // Ball movement logic
-            if (ball.active)
-            {
-                ball.position.x += ball.speed.x;
-                ball.position.y += ball.speed.y;
-            }
+            // Ball movement and collision logic: the ball is swept along its path and bounces on walls, player and bricks in the order it touches them
+            if (ball.active) UpdateBall();
             else
             {
                 ball.position = (rf_vec2){ player.position.x, window.height * 7 / 8 - 30 };
             }
 
-            // Collision logic: ball vs walls 
-            if (((ball.position.x + ball.radius) >= window.width) || ((ball.position.x - ball.radius) <= 0)) ball.speed.x *= -1;
-            if ((ball.position.y - ball.radius) <= 0) ball.speed.y *= -1;
-            if ((ball.position.y + ball.radius) >= window.height)
-            {
-                ball.speed = (rf_vec2){ 0, 0 };
-                ball.active = false;
-
-                player.life--;
-            }
-
-            // Collision logic: ball vs player
-            if (rf_check_collision_circle_rec(ball.position, ball.radius,
-                (rf_rec) {
-                player.position.x - player.size.x / 2, player.position.y - player.size.y / 2, player.size.x, player.size.y
-            }))
-            {
-                if (ball.speed.y > 0)
-                {
-                    ball.speed.y *= -1;
-                    ball.speed.x = (ball.position.x - player.position.x) / (player.size.x / 2) * 5;
-                }
-            }
-
-                // Collision logic: ball vs bricks
-                for (int i = 0; i < LINES_OF_BRICKS; i++)
-                {
-                    for (int j = 0; j < BRICKS_PER_LINE; j++)
-                    {
-                        if (brick[i][j].active)
-                        {
-                            // Hit below
-                            if (((ball.position.y - ball.radius) <= (brick[i][j].position.y + brickSize.y / 2)) &&
-                                ((ball.position.y - ball.radius) > (brick[i][j].position.y + brickSize.y / 2 + ball.speed.y)) &&
-                                ((fabs(ball.position.x - brick[i][j].position.x)) < (brickSize.x / 2 + ball.radius * 2 / 3)) && (ball.speed.y < 0))
-                            {
-                                brick[i][j].active = false;
-                                ball.speed.y *= -1;
-                            }
-                            // Hit above
-                            else if (((ball.position.y + ball.radius) >= (brick[i][j].position.y - brickSize.y / 2)) &&
-                                ((ball.position.y + ball.radius) < (brick[i][j].position.y - brickSize.y / 2 + ball.speed.y)) &&
-                                ((fabs(ball.position.x - brick[i][j].position.x)) < (brickSize.x / 2 + ball.radius * 2 / 3)) && (ball.speed.y > 0))
-                            {
-                                brick[i][j].active = false;
-                                ball.speed.y *= -1;
-                            }
-                            // Hit left
-                            else if (((ball.position.x + ball.radius) >= (brick[i][j].position.x - brickSize.x / 2)) &&
-                                ((ball.position.x + ball.radius) < (brick[i][j].position.x - brickSize.x / 2 + ball.speed.x)) &&
-                                ((fabs(ball.position.y - brick[i][j].position.y)) < (brickSize.y / 2 + ball.radius * 2 / 3)) && (ball.speed.x > 0))
-                            {
-                                brick[i][j].active = false;
-                                ball.speed.x *= -1;
-                            }
-                            // Hit right
-                            else if (((ball.position.x - ball.radius) <= (brick[i][j].position.x + brickSize.x / 2)) &&
-                                ((ball.position.x - ball.radius) > (brick[i][j].position.x + brickSize.x / 2 + ball.speed.x)) &&
-                                ((fabs(ball.position.y - brick[i][j].position.y)) < (brickSize.y / 2 + ball.radius * 2 / 3)) && (ball.speed.x < 0))
-                            {
-                                brick[i][j].active = false;
-                                ball.speed.x *= -1;
-                            }
-                        }
-                    }
-                }
-
                 // Game over logic
                 if (player.life <= 0) gameOver = true;
-                else
-                {
-                    gameOver = true;
-
-                    for (int i = 0; i < LINES_OF_BRICKS; i++)
-                    {
-                        for (int j = 0; j < BRICKS_PER_LINE; j++)
-                        {
-                            if (brick[i][j].active) gameOver = false;
-                        }
-                    }
-                }
+                else if (activeBricks == 0) gameOver = true;
         }
     }
     else
@@ -303,6 +235,234 @@ void UnloadGame(void)
     // TODO: Unload all dynamic loaded data (textures, sounds, models...)
 }
 
+// Finds when a circle moving from position by speed * time starts touching a rectangle, for a time up to maxTime
+// NOTE: The circle is swept as a ray against the rectangle grown by the radius, with rounded corners
+bool SweepCircleRec(rf_vec2 position, rf_vec2 speed, float radius, rf_rec rec, float maxTime, float* time, rf_vec2* normal)
+{
+    float left = rec.x - radius;
+    float right = rec.x + rec.width + radius;
+    float top = rec.y - radius;
+    float bottom = rec.y + rec.height + radius;
+
+    float enterX = -INFINITY, exitX = INFINITY;
+    float enterY = -INFINITY, exitY = INFINITY;
+
+    if (speed.x != 0)
+    {
+        float t0 = (left - position.x) / speed.x;
+        float t1 = (right - position.x) / speed.x;
+        enterX = fminf(t0, t1);
+        exitX = fmaxf(t0, t1);
+    }
+    else if (position.x < left || position.x > right) return false;
+
+    if (speed.y != 0)
+    {
+        float t0 = (top - position.y) / speed.y;
+        float t1 = (bottom - position.y) / speed.y;
+        enterY = fminf(t0, t1);
+        exitY = fmaxf(t0, t1);
+    }
+    else if (position.y < top || position.y > bottom) return false;
+
+    float enter = fmaxf(enterX, enterY);
+    float exit = fminf(exitX, exitY);
+
+    // Missing or moving away
+    if (enter > exit || exit <= 0 || enter > maxTime) return false;
+
+    // NOTE: The ray can start inside a corner of the grown rectangle without touching the rounded corner
+    rf_vec2 hit = { position.x + speed.x * fmaxf(enter, 0), position.y + speed.y * fmaxf(enter, 0) };
+    bool outsideX = hit.x < rec.x || hit.x > rec.x + rec.width;
+    bool outsideY = hit.y < rec.y || hit.y > rec.y + rec.height;
+
+    if (outsideX && outsideY)
+    {
+        // The ray is in a corner of the grown rectangle, the circle only touches if it reaches the corner point
+        rf_vec2 corner = { hit.x < rec.x ? rec.x : rec.x + rec.width, hit.y < rec.y ? rec.y : rec.y + rec.height };
+        rf_vec2 offset = { position.x - corner.x, position.y - corner.y };
+
+        float a = speed.x * speed.x + speed.y * speed.y;
+        float b = offset.x * speed.x + offset.y * speed.y;
+        float c = offset.x * offset.x + offset.y * offset.y - radius * radius;
+        float discriminant = b * b - a * c;
+
+        if (b >= 0 || discriminant < 0) return false;
+
+        float t = (-b - sqrtf(discriminant)) / a;
+        if (t < -BALL_HIT_TOLERANCE || t > maxTime) return false;
+
+        t = fmaxf(t, 0);
+        *time = t;
+        *normal = (rf_vec2){ (position.x + speed.x * t - corner.x) / radius, (position.y + speed.y * t - corner.y) / radius };
+    }
+    else
+    {
+        // Already overlapping
+        if (enter < -BALL_HIT_TOLERANCE) return false;
+
+        *time = fmaxf(enter, 0);
+        if (enterX > enterY) *normal = (rf_vec2){ speed.x > 0 ? -1.0f : 1.0f, 0 };
+        else *normal = (rf_vec2){ 0, speed.y > 0 ? -1.0f : 1.0f };
+    }
+
+    return true;
+}
+
+// Finds the first brick the ball touches before maxTime
+// NOTE: The center of the ball walks the brick grid cell by cell, every brick touched at a time t has the ball center
+// at time t in one of its neighbour cells, so the walk stops as soon as the best hit is before the end of the current cell
+bool SweepBallBricks(float maxTime, float* time, rf_vec2* normal, int* hitLine, int* hitBrick)
+{
+    float bricksTop = brick[0][0].position.y - brickSize.y / 2;
+    bool found = false;
+    float bestTime = maxTime;
+
+    int column = (int)floorf(ball.position.x / brickSize.x);
+    int line = (int)floorf((ball.position.y - bricksTop) / brickSize.y);
+    int stepX = (ball.speed.x > 0) ? 1 : -1;
+    int stepY = (ball.speed.y > 0) ? 1 : -1;
+
+    float nextX = (ball.speed.x != 0) ? ((column + (ball.speed.x > 0)) * brickSize.x - ball.position.x) / ball.speed.x : INFINITY;
+    float nextY = (ball.speed.y != 0) ? ((line + (ball.speed.y > 0)) * brickSize.y + bricksTop - ball.position.y) / ball.speed.y : INFINITY;
+    float deltaX = (ball.speed.x != 0) ? brickSize.x / fabsf(ball.speed.x) : INFINITY;
+    float deltaY = (ball.speed.y != 0) ? brickSize.y / fabsf(ball.speed.y) : INFINITY;
+
+    while (true)
+    {
+        for (int i = line - 1; i <= line + 1; i++)
+        {
+            if (i < 0 || i >= LINES_OF_BRICKS) continue;
+
+            for (int j = column - 1; j <= column + 1; j++)
+            {
+                if (j < 0 || j >= BRICKS_PER_LINE || !brick[i][j].active) continue;
+
+                rf_rec rec = { brick[i][j].position.x - brickSize.x / 2, brick[i][j].position.y - brickSize.y / 2, brickSize.x, brickSize.y };
+                float t;
+                rf_vec2 n;
+
+                if (SweepCircleRec(ball.position, ball.speed, ball.radius, rec, bestTime, &t, &n) && (!found || t < bestTime))
+                {
+                    found = true;
+                    bestTime = t;
+                    *normal = n;
+                    *hitLine = i;
+                    *hitBrick = j;
+                }
+            }
+        }
+
+        float cellExit = fminf(nextX, nextY);
+        if (cellExit >= bestTime) break;
+
+        if (nextX < nextY)
+        {
+            column += stepX;
+            nextX += deltaX;
+        }
+        else
+        {
+            line += stepY;
+            nextY += deltaY;
+        }
+    }
+
+    *time = bestTime;
+
+    return found;
+}
+
+// Moves the ball through one frame, resolving every bounce in the order they happen so the ball never goes through a brick
+void UpdateBall(void)
+{
+    float timeLeft = 1.0f;
+
+    for (int bounce = 0; (bounce < MAX_BALL_BOUNCES) && (timeLeft > 0); bounce++)
+    {
+        BallHit hit = HIT_NONE;
+        float hitTime = timeLeft;
+        rf_vec2 normal = { 0 };
+        int hitLine = 0;
+        int hitBrick = 0;
+
+        // Walls, a ball that is already past a wall bounces immediately
+        if (ball.speed.x > 0)
+        {
+            float t = fmaxf((window.width - ball.radius - ball.position.x) / ball.speed.x, 0);
+            if (t <= hitTime) { hit = HIT_WALL; hitTime = t; normal = (rf_vec2){ -1, 0 }; }
+        }
+        else if (ball.speed.x < 0)
+        {
+            float t = fmaxf((ball.radius - ball.position.x) / ball.speed.x, 0);
+            if (t <= hitTime) { hit = HIT_WALL; hitTime = t; normal = (rf_vec2){ 1, 0 }; }
+        }
+
+        if (ball.speed.y < 0)
+        {
+            float t = fmaxf((ball.radius - ball.position.y) / ball.speed.y, 0);
+            if (t <= hitTime) { hit = HIT_WALL; hitTime = t; normal = (rf_vec2){ 0, 1 }; }
+        }
+        else if (ball.speed.y > 0)
+        {
+            float t = fmaxf((window.height - ball.radius - ball.position.y) / ball.speed.y, 0);
+            if (t <= hitTime) { hit = HIT_FLOOR; hitTime = t; }
+        }
+
+        // Player, only when the ball comes down like before
+        float t;
+        rf_vec2 n;
+        rf_rec playerRec = { player.position.x - player.size.x / 2, player.position.y - player.size.y / 2, player.size.x, player.size.y };
+
+        if ((ball.speed.y > 0) && SweepCircleRec(ball.position, ball.speed, ball.radius, playerRec, hitTime, &t, &n) && (t < hitTime))
+        {
+            hit = HIT_PLAYER;
+            hitTime = t;
+        }
+
+        if (SweepBallBricks(hitTime, &t, &n, &hitLine, &hitBrick) && (t < hitTime || hit == HIT_NONE))
+        {
+            hit = HIT_BRICK;
+            hitTime = t;
+            normal = n;
+        }
+
+        ball.position.x += ball.speed.x * hitTime;
+        ball.position.y += ball.speed.y * hitTime;
+        timeLeft -= hitTime;
+
+        switch (hit)
+        {
+            case HIT_NONE: return;
+            case HIT_FLOOR:
+            {
+                ball.speed = (rf_vec2){ 0, 0 };
+                ball.active = false;
+
+                player.life--;
+            } return;
+            case HIT_PLAYER:
+            {
+                ball.speed.y *= -1;
+                ball.speed.x = (ball.position.x - player.position.x) / (player.size.x / 2) * BALL_SPEED;
+            } break;
+            case HIT_BRICK:
+            {
+                brick[hitLine][hitBrick].active = false;
+                activeBricks--;
+            } // fallthrough
+            case HIT_WALL:
+            {
+                // Reflect the speed on the normal of the surface
+                float dot = ball.speed.x * normal.x + ball.speed.y * normal.y;
+                ball.speed.x -= 2 * dot * normal.x;
+                ball.speed.y -= 2 * dot * normal.y;
+            } break;
+            default: break;
+        }
+    }
+}
+
 // Update and Draw (one frame)
 void UpdateDrawFrame(const platform_input_state* input)
 {
@@ -23,6 +23,7 @@
 #define METEORS_SPEED       2
 #define MAX_MEDIUM_METEORS  8
 #define MAX_SMALL_METEORS   16
+#define MAX_METEORS         (MAX_MEDIUM_METEORS + MAX_SMALL_METEORS)
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -297,16 +298,37 @@ void UpdateGame(const platform_input_state* input)
             // Collision Player to meteors
             player.collider = (rf_vec3){ player.position.x + sin(player.rotation * RF_DEG2RAD) * (shipHeight / 2.5f), player.position.y - cos(player.rotation * RF_DEG2RAD) * (shipHeight / 2.5f), 12 };
 
+            // NOTE: The active meteors are gathered in separate arrays so all of them are checked with one batch call
+            float meteorX[MAX_METEORS];
+            float meteorY[MAX_METEORS];
+            float meteorRadius[MAX_METEORS];
+            int meteorsCount = 0;
+
             for (int a = 0; a < MAX_MEDIUM_METEORS; a++)
             {
-                if (rf_check_collision_circles((rf_vec2) { player.collider.x, player.collider.y }, player.collider.z, mediumMeteor[a].position, mediumMeteor[a].radius) && mediumMeteor[a].active) gameOver = true;
+                if (mediumMeteor[a].active)
+                {
+                    meteorX[meteorsCount] = mediumMeteor[a].position.x;
+                    meteorY[meteorsCount] = mediumMeteor[a].position.y;
+                    meteorRadius[meteorsCount] = mediumMeteor[a].radius;
+                    meteorsCount++;
+                }
             }
 
             for (int a = 0; a < MAX_SMALL_METEORS; a++)
             {
-                if (rf_check_collision_circles((rf_vec2) { player.collider.x, player.collider.y }, player.collider.z, smallMeteor[a].position, smallMeteor[a].radius) && smallMeteor[a].active) gameOver = true;
+                if (smallMeteor[a].active)
+                {
+                    meteorX[meteorsCount] = smallMeteor[a].position.x;
+                    meteorY[meteorsCount] = smallMeteor[a].position.y;
+                    meteorRadius[meteorsCount] = smallMeteor[a].radius;
+                    meteorsCount++;
+                }
             }
 
+            int hits[MAX_METEORS];
+            if (rf_check_collision_circles_batch((rf_vec2) { player.collider.x, player.collider.y }, player.collider.z, meteorX, meteorY, meteorRadius, meteorsCount, hits) > 0) gameOver = true;
+
             // Meteor logic
 
             for (int i = 0; i < MAX_MEDIUM_METEORS; i++)
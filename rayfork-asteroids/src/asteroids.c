@@ -21,9 +21,16 @@
 #define PLAYER_MAX_SHOOTS   10
 
 #define METEORS_SPEED       2
+
+// Big meteors a game starts with, can be defined when building to stress test with many meteors
+#ifndef MAX_BIG_METEORS
 #define MAX_BIG_METEORS     4
-#define MAX_MEDIUM_METEORS  8
-#define MAX_SMALL_METEORS   16
+#endif
+
+// Every big meteor splits into 2 medium ones and each of those into 2 small ones
+#define MAX_METEORS         (MAX_BIG_METEORS*7)
+
+#define METEORS_GRID_CELL   80.0f
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -47,13 +54,7 @@ typedef struct Shoot {
     rf_color color;
 } Shoot;
 
-typedef struct Meteor {
-    rf_vec2 position;
-    rf_vec2 speed;
-    float radius;
-    bool active;
-    rf_color color;
-} Meteor;
+typedef enum MeteorSize { METEOR_BIG, METEOR_MEDIUM, METEOR_SMALL } MeteorSize;
 
 //------------------------------------------------------------------------------------
 // Global Variables Declaration
@@ -67,14 +68,25 @@ static float shipHeight = 0.0f;
 
 static Player player = { 0 };
 static Shoot shoot[PLAYER_MAX_SHOOTS] = { 0 };
-static Meteor bigMeteor[MAX_BIG_METEORS] = { 0 };
-static Meteor mediumMeteor[MAX_MEDIUM_METEORS] = { 0 };
-static Meteor smallMeteor[MAX_SMALL_METEORS] = { 0 };
-
-static int midMeteorsCount = 0;
-static int smallMeteorsCount = 0;
 static int destroyedMeteorsCount = 0;
 
+// Meteor pool as separate arrays for the batch movement and collision checks, and a grid for the shoots
+// NOTE: Active meteors are kept at the front, destroyed ones are kept after them to be drawn faded
+static float meteorX[MAX_METEORS] = { 0 };
+static float meteorY[MAX_METEORS] = { 0 };
+static float meteorSpeedX[MAX_METEORS] = { 0 };
+static float meteorSpeedY[MAX_METEORS] = { 0 };
+static float meteorRadius[MAX_METEORS] = { 0 };
+static MeteorSize meteorSize[MAX_METEORS] = { 0 };
+static int activeMeteorsCount = 0;
+static int meteorsCount = 0;
+
+static const float meteorSizeRadius[] = { 40, 20, 10 };
+
+static rf_spatial_grid meteorGrid = { 0 };
+static rf_rec meteorRecs[MAX_METEORS] = { 0 };
+static int meteorHits[MAX_METEORS] = { 0 };
+
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
 //------------------------------------------------------------------------------------
@@ -84,6 +96,13 @@ static void DrawGame(void);                                      // Draw game (o
 static void UnloadGame(void);                                    // Unload game
 static void UpdateDrawFrame(const platform_input_state* input);  // Update and Draw (one frame)
 
+// Additional module functions
+static void SpawnMeteor(MeteorSize size, rf_vec2 position, rf_vec2 speed);
+static void DestroyMeteor(int id);
+static void CopyMeteor(int dst, int src);
+static void UpdateMeteorGrid(void);
+static int FindMeteorCollision(rf_vec2 center, float radius, const int* destroyed, int destroyedCount);
+
 // Returns a random value between min and max (both included)
 int GetRandomValue(int min, int max)
 {
@@ -123,6 +142,8 @@ extern void game_init(rf_gfx_backend_data* gfx_data)
     batch = rf_create_default_render_batch(RF_DEFAULT_ALLOCATOR);
     rf_set_active_render_batch(&batch);
 
+    meteorGrid = rf_load_spatial_grid((rf_rec){ 0, 0, window.width, window.height }, METEORS_GRID_CELL, MAX_METEORS, RF_DEFAULT_ALLOCATOR);
+
     InitGame();
 }
 
@@ -167,6 +188,9 @@ void InitGame(void)
         shoot[i].color = RF_WHITE;
     }
 
+    activeMeteorsCount = 0;
+    meteorsCount = 0;
+
     for (int i = 0; i < MAX_BIG_METEORS; i++)
     {
         posx = GetRandomValue(0, window.width);
@@ -187,8 +211,6 @@ void InitGame(void)
             else correctRange = true;
         }
 
-        bigMeteor[i].position = (rf_vec2){ posx, posy };
-
         correctRange = false;
         velx = GetRandomValue(-METEORS_SPEED, METEORS_SPEED);
         vely = GetRandomValue(-METEORS_SPEED, METEORS_SPEED);
@@ -203,32 +225,8 @@ void InitGame(void)
             else correctRange = true;
         }
 
-        bigMeteor[i].speed = (rf_vec2){ velx, vely };
-        bigMeteor[i].radius = 40;
-        bigMeteor[i].active = true;
-        bigMeteor[i].color = RF_BLUE;
-    }
-
-    for (int i = 0; i < MAX_MEDIUM_METEORS; i++)
-    {
-        mediumMeteor[i].position = (rf_vec2){ -100, -100 };
-        mediumMeteor[i].speed = (rf_vec2){ 0,0 };
-        mediumMeteor[i].radius = 20;
-        mediumMeteor[i].active = false;
-        mediumMeteor[i].color = RF_BLUE;
-    }
-
-    for (int i = 0; i < MAX_SMALL_METEORS; i++)
-    {
-        smallMeteor[i].position = (rf_vec2){ -100, -100 };
-        smallMeteor[i].speed = (rf_vec2){ 0,0 };
-        smallMeteor[i].radius = 10;
-        smallMeteor[i].active = false;
-        smallMeteor[i].color = RF_BLUE;
+        SpawnMeteor(METEOR_BIG, (rf_vec2){ posx, posy }, (rf_vec2){ velx, vely });
     }
-
-    midMeteorsCount = 0;
-    smallMeteorsCount = 0;
 }
 
 // Update game (one frame)
@@ -342,157 +340,68 @@ void UpdateGame(const platform_input_state* input)
             // Collision logic: player vs meteors
             player.collider = (rf_vec3){ player.position.x + sin(player.rotation * RF_DEG2RAD) * (shipHeight / 2.5f), player.position.y - cos(player.rotation * RF_DEG2RAD) * (shipHeight / 2.5f), 12 };
 
-            for (int a = 0; a < MAX_BIG_METEORS; a++)
-            {
-                if (rf_check_collision_circles((rf_vec2) { player.collider.x, player.collider.y }, player.collider.z, bigMeteor[a].position, bigMeteor[a].radius) && bigMeteor[a].active) gameOver = true;
-            }
+            if (rf_check_collision_circles_batch((rf_vec2) { player.collider.x, player.collider.y }, player.collider.z, meteorX, meteorY, meteorRadius, activeMeteorsCount, meteorHits) > 0) gameOver = true;
 
-            for (int a = 0; a < MAX_MEDIUM_METEORS; a++)
-            {
-                if (rf_check_collision_circles((rf_vec2) { player.collider.x, player.collider.y }, player.collider.z, mediumMeteor[a].position, mediumMeteor[a].radius) && mediumMeteor[a].active) gameOver = true;
-            }
+            // Meteors logic: movement and collision against the walls, they wrap to the other side
+            rf_move_wrap_batch(meteorX, meteorY, meteorSpeedX, meteorSpeedY, meteorRadius, activeMeteorsCount, (rf_rec){ 0, 0, window.width, window.height });
 
-            for (int a = 0; a < MAX_SMALL_METEORS; a++)
-            {
-                if (rf_check_collision_circles((rf_vec2) { player.collider.x, player.collider.y }, player.collider.z, smallMeteor[a].position, smallMeteor[a].radius) && smallMeteor[a].active) gameOver = true;
-            }
+            // Collision logic: player-shoots vs meteors
+            // NOTE: The pool is only changed after all the shoots are checked so the grid stays valid
+            int destroyed[PLAYER_MAX_SHOOTS];
+            float destroyedRotation[PLAYER_MAX_SHOOTS];
+            int destroyedCount = 0;
 
-            // Meteors logic: big meteors
-            for (int i = 0; i < MAX_BIG_METEORS; i++)
-            {
-                if (bigMeteor[i].active)
-                {
-                    // Movement
-                    bigMeteor[i].position.x += bigMeteor[i].speed.x;
-                    bigMeteor[i].position.y += bigMeteor[i].speed.y;
-
-                    // Collision logic: meteor vs wall
-                    if (bigMeteor[i].position.x > window.width + bigMeteor[i].radius) bigMeteor[i].position.x = -(bigMeteor[i].radius);
-                    else if (bigMeteor[i].position.x < 0 - bigMeteor[i].radius) bigMeteor[i].position.x = window.width + bigMeteor[i].radius;
-                    if (bigMeteor[i].position.y > window.height + bigMeteor[i].radius) bigMeteor[i].position.y = -(bigMeteor[i].radius);
-                    else if (bigMeteor[i].position.y < 0 - bigMeteor[i].radius) bigMeteor[i].position.y = window.height + bigMeteor[i].radius;
-                }
-            }
+            UpdateMeteorGrid();
 
-            // Meteors logic: medium meteors
-            for (int i = 0; i < MAX_MEDIUM_METEORS; i++)
+            for (int i = 0; i < PLAYER_MAX_SHOOTS; i++)
             {
-                if (mediumMeteor[i].active)
+                if ((shoot[i].active))
                 {
-                    // Movement
-                    mediumMeteor[i].position.x += mediumMeteor[i].speed.x;
-                    mediumMeteor[i].position.y += mediumMeteor[i].speed.y;
-
-                    // Collision logic: meteor vs wall
-                    if (mediumMeteor[i].position.x > window.width + mediumMeteor[i].radius) mediumMeteor[i].position.x = -(mediumMeteor[i].radius);
-                    else if (mediumMeteor[i].position.x < 0 - mediumMeteor[i].radius) mediumMeteor[i].position.x = window.width + mediumMeteor[i].radius;
-                    if (mediumMeteor[i].position.y > window.height + mediumMeteor[i].radius) mediumMeteor[i].position.y = -(mediumMeteor[i].radius);
-                    else if (mediumMeteor[i].position.y < 0 - mediumMeteor[i].radius) mediumMeteor[i].position.y = window.height + mediumMeteor[i].radius;
+                    int id = FindMeteorCollision(shoot[i].position, shoot[i].radius, destroyed, destroyedCount);
+
+                    if (id == -1) continue;
+
+                    shoot[i].active = false;
+                    shoot[i].lifeSpawn = 0;
+                    destroyedMeteorsCount++;
+
+                    destroyed[destroyedCount] = id;
+                    destroyedRotation[destroyedCount] = shoot[i].rotation;
+                    destroyedCount++;
                 }
             }
 
-            // Meteors logic: small meteors
-            for (int i = 0; i < MAX_SMALL_METEORS; i++)
+            // Big and medium meteors split in two, going back and forth along the shoot
+            for (int i = 0; i < destroyedCount; i++)
             {
-                if (smallMeteor[i].active)
-                {
-                    // Movement
-                    smallMeteor[i].position.x += smallMeteor[i].speed.x;
-                    smallMeteor[i].position.y += smallMeteor[i].speed.y;
-
-                    // Collision logic: meteor vs wall
-                    if (smallMeteor[i].position.x > window.width + smallMeteor[i].radius) smallMeteor[i].position.x = -(smallMeteor[i].radius);
-                    else if (smallMeteor[i].position.x < 0 - smallMeteor[i].radius) smallMeteor[i].position.x = window.width + smallMeteor[i].radius;
-                    if (smallMeteor[i].position.y > window.height + smallMeteor[i].radius) smallMeteor[i].position.y = -(smallMeteor[i].radius);
-                    else if (smallMeteor[i].position.y < 0 - smallMeteor[i].radius) smallMeteor[i].position.y = window.height + smallMeteor[i].radius;
-                }
+                int id = destroyed[i];
+
+                if (meteorSize[id] == METEOR_SMALL) continue;
+
+                rf_vec2 position = { meteorX[id], meteorY[id] };
+                rf_vec2 speed = { cos(destroyedRotation[i] * RF_DEG2RAD) * METEORS_SPEED, sin(destroyedRotation[i] * RF_DEG2RAD) * METEORS_SPEED };
+
+                SpawnMeteor(meteorSize[id] + 1, position, (rf_vec2){ speed.x * -1, speed.y * -1 });
+                SpawnMeteor(meteorSize[id] + 1, position, speed);
             }
 
-            // Collision logic: player-shoots vs meteors
-            for (int i = 0; i < PLAYER_MAX_SHOOTS; i++)
+            // Highest ids first, so a swap never moves another meteor destroyed this frame
+            for (int i = 0; i < destroyedCount; i++)
             {
-                if ((shoot[i].active))
-                {
-                    for (int a = 0; a < MAX_BIG_METEORS; a++)
-                    {
-                        if (bigMeteor[a].active && rf_check_collision_circles(shoot[i].position, shoot[i].radius, bigMeteor[a].position, bigMeteor[a].radius))
-                        {
-                            shoot[i].active = false;
-                            shoot[i].lifeSpawn = 0;
-                            bigMeteor[a].active = false;
-                            destroyedMeteorsCount++;
-
-                            for (int j = 0; j < 2; j++)
-                            {
-                                if (midMeteorsCount % 2 == 0)
-                                {
-                                    mediumMeteor[midMeteorsCount].position = (rf_vec2){ bigMeteor[a].position.x, bigMeteor[a].position.y };
-                                    mediumMeteor[midMeteorsCount].speed = (rf_vec2){ cos(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED * -1, sin(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED * -1 };
-                                }
-                                else
-                                {
-                                    mediumMeteor[midMeteorsCount].position = (rf_vec2){ bigMeteor[a].position.x, bigMeteor[a].position.y };
-                                    mediumMeteor[midMeteorsCount].speed = (rf_vec2){ cos(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED, sin(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED };
-                                }
-
-                                mediumMeteor[midMeteorsCount].active = true;
-                                midMeteorsCount++;
-                            }
-                            //bigMeteor[a].position = (rf_vec2){-100, -100};
-                            bigMeteor[a].color = RF_RED;
-                            a = MAX_BIG_METEORS;
-                        }
-                    }
-
-                    for (int b = 0; b < MAX_MEDIUM_METEORS; b++)
-                    {
-                        if (mediumMeteor[b].active && rf_check_collision_circles(shoot[i].position, shoot[i].radius, mediumMeteor[b].position, mediumMeteor[b].radius))
-                        {
-                            shoot[i].active = false;
-                            shoot[i].lifeSpawn = 0;
-                            mediumMeteor[b].active = false;
-                            destroyedMeteorsCount++;
-
-                            for (int j = 0; j < 2; j++)
-                            {
-                                if (smallMeteorsCount % 2 == 0)
-                                {
-                                    smallMeteor[smallMeteorsCount].position = (rf_vec2){ mediumMeteor[b].position.x, mediumMeteor[b].position.y };
-                                    smallMeteor[smallMeteorsCount].speed = (rf_vec2){ cos(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED * -1, sin(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED * -1 };
-                                }
-                                else
-                                {
-                                    smallMeteor[smallMeteorsCount].position = (rf_vec2){ mediumMeteor[b].position.x, mediumMeteor[b].position.y };
-                                    smallMeteor[smallMeteorsCount].speed = (rf_vec2){ cos(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED, sin(shoot[i].rotation * RF_DEG2RAD) * METEORS_SPEED };
-                                }
-
-                                smallMeteor[smallMeteorsCount].active = true;
-                                smallMeteorsCount++;
-                            }
-                            //mediumMeteor[b].position = (rf_vec2){-100, -100};
-                            mediumMeteor[b].color = RF_GREEN;
-                            b = MAX_MEDIUM_METEORS;
-                        }
-                    }
+                int highest = i;
 
-                    for (int c = 0; c < MAX_SMALL_METEORS; c++)
-                    {
-                        if (smallMeteor[c].active && rf_check_collision_circles(shoot[i].position, shoot[i].radius, smallMeteor[c].position, smallMeteor[c].radius))
-                        {
-                            shoot[i].active = false;
-                            shoot[i].lifeSpawn = 0;
-                            smallMeteor[c].active = false;
-                            destroyedMeteorsCount++;
-                            smallMeteor[c].color = RF_YELLOW;
-                            // smallMeteor[c].position = (rf_vec2){-100, -100};
-                            c = MAX_SMALL_METEORS;
-                        }
-                    }
+                for (int j = i + 1; j < destroyedCount; j++)
+                {
+                    if (destroyed[j] > destroyed[highest]) highest = j;
                 }
+
+                int id = destroyed[highest];
+                destroyed[highest] = destroyed[i];
+                DestroyMeteor(id);
             }
         }
 
-        if (destroyedMeteorsCount == MAX_BIG_METEORS + MAX_MEDIUM_METEORS + MAX_SMALL_METEORS) victory = true;
+        if (destroyedMeteorsCount == MAX_METEORS) victory = true;
     }
     else
     {
@@ -520,22 +429,14 @@ void DrawGame(void)
             rf_draw_triangle(v1, v2, v3, RF_MAROON);
 
             // Draw meteors
-            for (int i = 0; i < MAX_BIG_METEORS; i++)
+            for (int i = activeMeteorsCount; i < meteorsCount; i++)
             {
-                if (bigMeteor[i].active) rf_draw_circle_v(bigMeteor[i].position, bigMeteor[i].radius, RF_DARKGRAY);
-                else rf_draw_circle_v(bigMeteor[i].position, bigMeteor[i].radius, rf_fade(RF_LIGHTGRAY, 0.3f));
+                rf_draw_circle_v((rf_vec2){ meteorX[i], meteorY[i] }, meteorRadius[i], rf_fade(RF_LIGHTGRAY, 0.3f));
             }
 
-            for (int i = 0; i < MAX_MEDIUM_METEORS; i++)
+            for (int i = 0; i < activeMeteorsCount; i++)
             {
-                if (mediumMeteor[i].active) rf_draw_circle_v(mediumMeteor[i].position, mediumMeteor[i].radius, RF_GRAY);
-                else rf_draw_circle_v(mediumMeteor[i].position, mediumMeteor[i].radius, rf_fade(RF_LIGHTGRAY, 0.3f));
-            }
-
-            for (int i = 0; i < MAX_SMALL_METEORS; i++)
-            {
-                if (smallMeteor[i].active) rf_draw_circle_v(smallMeteor[i].position, smallMeteor[i].radius, RF_GRAY);
-                else rf_draw_circle_v(smallMeteor[i].position, smallMeteor[i].radius, rf_fade(RF_LIGHTGRAY, 0.3f));
+                rf_draw_circle_v((rf_vec2){ meteorX[i], meteorY[i] }, meteorRadius[i], (meteorSize[i] == METEOR_BIG)? RF_DARKGRAY : RF_GRAY);
             }
 
             // Draw shoot
@@ -557,6 +458,92 @@ void DrawGame(void)
 void UnloadGame(void)
 {
     // TODO: Unload all dynamic loaded data (textures, sounds, models...)
+    rf_unload_spatial_grid(meteorGrid);
+}
+
+// Add a meteor at the end of the active ones, the first destroyed one is moved to the end of the pool
+void SpawnMeteor(MeteorSize size, rf_vec2 position, rf_vec2 speed)
+{
+    if (meteorsCount == MAX_METEORS) return;
+
+    if (activeMeteorsCount < meteorsCount) CopyMeteor(meteorsCount, activeMeteorsCount);
+
+    int id = activeMeteorsCount;
+    meteorX[id] = position.x;
+    meteorY[id] = position.y;
+    meteorSpeedX[id] = speed.x;
+    meteorSpeedY[id] = speed.y;
+    meteorRadius[id] = meteorSizeRadius[size];
+    meteorSize[id] = size;
+
+    activeMeteorsCount++;
+    meteorsCount++;
+}
+
+// Swap an active meteor with the last active one, so it becomes the first destroyed one
+void DestroyMeteor(int id)
+{
+    int last = activeMeteorsCount - 1;
+
+    rf_vec2 position = { meteorX[id], meteorY[id] };
+    rf_vec2 speed = { meteorSpeedX[id], meteorSpeedY[id] };
+    float radius = meteorRadius[id];
+    MeteorSize size = meteorSize[id];
+
+    CopyMeteor(id, last);
+
+    meteorX[last] = position.x;
+    meteorY[last] = position.y;
+    meteorSpeedX[last] = speed.x;
+    meteorSpeedY[last] = speed.y;
+    meteorRadius[last] = radius;
+    meteorSize[last] = size;
+
+    activeMeteorsCount--;
+}
+
+void CopyMeteor(int dst, int src)
+{
+    meteorX[dst] = meteorX[src];
+    meteorY[dst] = meteorY[src];
+    meteorSpeedX[dst] = meteorSpeedX[src];
+    meteorSpeedY[dst] = meteorSpeedY[src];
+    meteorRadius[dst] = meteorRadius[src];
+    meteorSize[dst] = meteorSize[src];
+}
+
+// Rebuild the grid of the active meteors, the grid ids are their indices in the pool
+void UpdateMeteorGrid(void)
+{
+    for (int i = 0; i < activeMeteorsCount; i++)
+    {
+        meteorRecs[i] = (rf_rec){ meteorX[i] - meteorRadius[i], meteorY[i] - meteorRadius[i], meteorRadius[i] * 2, meteorRadius[i] * 2 };
+    }
+
+    rf_spatial_grid_build(&meteorGrid, meteorRecs, activeMeteorsCount);
+}
+
+// Returns the biggest of the active meteors colliding with a circle, the first one in the pool on a tie, -1 if none does
+// NOTE: Meteors destroyed this frame stay in the pool until all the shoots are checked, so they are skipped
+int FindMeteorCollision(rf_vec2 center, float radius, const int* destroyed, int destroyedCount)
+{
+    int count = rf_spatial_grid_query(&meteorGrid, (rf_rec){ center.x - radius, center.y - radius, radius * 2, radius * 2 }, meteorHits, MAX_METEORS);
+    int result = -1;
+
+    for (int i = 0; i < count; i++)
+    {
+        int id = meteorHits[i];
+        bool skip = !rf_check_collision_circles(center, radius, (rf_vec2){ meteorX[id], meteorY[id] }, meteorRadius[id]);
+
+        for (int j = 0; j < destroyedCount; j++)
+        {
+            if (destroyed[j] == id) skip = true;
+        }
+
+        if (!skip && ((result == -1) || (meteorSize[id] < meteorSize[result]) || ((meteorSize[id] == meteorSize[result]) && (id < result)))) result = id;
+    }
+
+    return result;
 }
 
 // Update and Draw (one frame)
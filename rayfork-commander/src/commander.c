@@ -16,18 +16,20 @@
 //----------------------------------------------------------------------------------
 // Some Defines
 //----------------------------------------------------------------------------------
-#define MAX_MISSILES                100
-#define MAX_INTERCEPTORS            30
-#define MAX_EXPLOSIONS              100
+#define MAX_MISSILES                1000        // Enough for barrage mode, the normal mode uses a tenth
+#define MAX_INTERCEPTORS            300
+#define MAX_EXPLOSIONS              1000
 #define LAUNCHERS_AMOUNT            3           // Not a variable, should not be changed
 #define BUILDINGS_AMOUNT            6           // Not a variable, should not be changed
 
 #define LAUNCHER_SIZE               80
 #define BUILDING_SIZE               60
 #define EXPLOSION_RADIUS            40
+#define EXPLOSIONS_GRID_CELL        (EXPLOSION_RADIUS * 2)
 
 #define MISSILE_SPEED               1
 #define MISSILE_LAUNCH_FRAMES       80
+#define BARRAGE_LAUNCH_FRAMES       1           // Barrage mode launches a missile every frame
 #define INTERCEPTOR_SPEED           10
 #define EXPLOSION_INCREASE_TIME     90          // In frames
 #define EXPLOSION_TOTAL_TIME        210         // In frames
@@ -42,8 +44,6 @@ typedef struct Missile {
     rf_vec2 position;
     rf_vec2 objective;
     rf_vec2 speed;
-
-    bool active;
 } Missile;
 
 typedef struct Interceptor {
@@ -51,15 +51,12 @@ typedef struct Interceptor {
     rf_vec2 position;
     rf_vec2 objective;
     rf_vec2 speed;
-
-    bool active;
 } Interceptor;
 
 typedef struct Explosion {
     rf_vec2 position;
     float radiusMultiplier;
     int frame;
-    bool active;
 } Explosion;
 
 typedef struct Launcher {
@@ -79,13 +76,23 @@ static int framesCounter = 0;
 static bool gameOver = false;
 static bool pause = false;
 static int score = 0;
+static bool barrage = false;
 
+// Missiles, interceptors and explosions are dense lists of the active ones, removed by swapping with the last one
 static Missile missile[MAX_MISSILES] = { 0 };
 static Interceptor interceptor[MAX_INTERCEPTORS] = { 0 };
 static Explosion explosion[MAX_EXPLOSIONS] = { 0 };
+static int missilesCount = 0;
+static int interceptorsCount = 0;
+static int explosionsCount = 0;
+
 static Launcher launcher[LAUNCHERS_AMOUNT] = { 0 };
 static Building building[BUILDINGS_AMOUNT] = { 0 };
-static int explosionIndex = 0;
+
+// Broadphase of the active explosions, grid ids are explosion indices
+static rf_spatial_grid explosionGrid = { 0 };
+static rf_rec explosionRecs[MAX_EXPLOSIONS] = { 0 };
+static int explosionCandidates[MAX_EXPLOSIONS] = { 0 };
 
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
@@ -99,6 +106,9 @@ static void UpdateDrawFrame(const platform_input_state* input);  // Update and D
 // Additional module functions
 static void UpdateOutgoingFire(const platform_input_state* input);
 static void UpdateIncomingFire(const platform_input_state* input);
+static void UpdateExplosionGrid(void);
+static void AddExplosion(rf_vec2 position);
+static bool CheckMissileHitGround(rf_vec2 position);
 
 // Formatting of text with variables to 'embed'
 // WARNING: String returned will expire after this function is called MAX_TEXTFORMAT_BUFFERS times
@@ -166,6 +176,8 @@ extern void game_init(rf_gfx_backend_data* gfx_data)
     batch = rf_create_default_render_batch(RF_DEFAULT_ALLOCATOR);
     rf_set_active_render_batch(&batch);
 
+    explosionGrid = rf_load_spatial_grid((rf_rec){ 0, 0, window.width, window.height }, EXPLOSIONS_GRID_CELL, MAX_EXPLOSIONS, RF_DEFAULT_ALLOCATOR);
+
     InitGame();
 }
 
@@ -181,33 +193,10 @@ extern void game_update(const platform_input_state* input)
 // Initialize game variables
 void InitGame()
 {
-    // Initialize missiles
-    for (int i = 0; i < MAX_MISSILES; i++)
-    {
-        missile[i].origin = (rf_vec2){ 0, 0 };
-        missile[i].speed = (rf_vec2){ 0, 0 };
-        missile[i].position = (rf_vec2){ 0, 0 };
-
-        missile[i].active = false;
-    }
-
-    // Initialize interceptors
-    for (int i = 0; i < MAX_INTERCEPTORS; i++)
-    {
-        interceptor[i].origin = (rf_vec2){ 0, 0 };
-        interceptor[i].speed = (rf_vec2){ 0, 0 };
-        interceptor[i].position = (rf_vec2){ 0, 0 };
-
-        interceptor[i].active = false;
-    }
-
-    // Initialize explosions
-    for (int i = 0; i < MAX_EXPLOSIONS; i++)
-    {
-        explosion[i].position = (rf_vec2){ 0, 0 };
-        explosion[i].frame = 0;
-        explosion[i].active = false;
-    }
+    // Initialize missiles, interceptors and explosions
+    missilesCount = 0;
+    interceptorsCount = 0;
+    explosionsCount = 0;
 
     // Initialize buildings and launchers
     int sparcing = window.width / (LAUNCHERS_AMOUNT + BUILDINGS_AMOUNT + 1);
@@ -242,146 +231,91 @@ void UpdateGame(const platform_input_state* input)
         {
             framesCounter++;
 
-            static
-                float distance;
+            if (input->keys[KEYCODE_B] == KEY_PRESSED_DOWN) barrage = !barrage;
 
             // Interceptors update
-            for (int i = 0; i < MAX_INTERCEPTORS; i++)
+            for (int i = 0; i < interceptorsCount;)
             {
-                if (interceptor[i].active)
-                {
-                    // Update position
-                    interceptor[i].position.x += interceptor[i].speed.x;
-                    interceptor[i].position.y += interceptor[i].speed.y;
-
-                    // Distance to objective
-                    distance = sqrt(pow(interceptor[i].position.x - interceptor[i].objective.x, 2) +
-                        pow(interceptor[i].position.y - interceptor[i].objective.y, 2));
+                // Update position
+                interceptor[i].position.x += interceptor[i].speed.x;
+                interceptor[i].position.y += interceptor[i].speed.y;
 
-                    if (distance < INTERCEPTOR_SPEED)
-                    {
-                        // Interceptor dissapears
-                        interceptor[i].active = false;
+                // Distance to objective, squared
+                float dx = interceptor[i].position.x - interceptor[i].objective.x;
+                float dy = interceptor[i].position.y - interceptor[i].objective.y;
 
-                        // Explosion
-                        explosion[explosionIndex].position = interceptor[i].position;
-                        explosion[explosionIndex].active = true;
-                        explosion[explosionIndex].frame = 0;
-                        explosionIndex++;
-                        if (explosionIndex == MAX_EXPLOSIONS) explosionIndex = 0;
-
-                        break;
-                    }
+                if (dx*dx + dy*dy < INTERCEPTOR_SPEED*INTERCEPTOR_SPEED)
+                {
+                    // Interceptor dissapears and explodes
+                    AddExplosion(interceptor[i].position);
+                    interceptor[i] = interceptor[--interceptorsCount];
                 }
+                else i++;
             }
 
             // Missiles update
-            for (int i = 0; i < MAX_MISSILES; i++)
+            // NOTE: Explosions started by missiles in this update are added to the grid on the next frame
+            UpdateExplosionGrid();
+
+            for (int i = 0; i < missilesCount;)
             {
-                if (missile[i].active)
+                // Update position
+                missile[i].position.x += missile[i].speed.x;
+                missile[i].position.y += missile[i].speed.y;
+
+                bool destroyed = false;
+
+                // Collision and missile out of bounds
+                if (missile[i].position.y > window.height) destroyed = true;
+                else if (CheckMissileHitGround(missile[i].position))
                 {
-                    // Update position
-                    missile[i].position.x += missile[i].speed.x;
-                    missile[i].position.y += missile[i].speed.y;
+                    // Explosion, the launcher or building was destroyed
+                    AddExplosion(missile[i].position);
+                    destroyed = true;
+                }
+                else
+                {
+                    // CHeck collision with explosions
+                    int candidatesCount = rf_spatial_grid_query(&explosionGrid, (rf_rec){ missile[i].position.x, missile[i].position.y, 0, 0 }, explosionCandidates, MAX_EXPLOSIONS);
 
-                    // Collision and missile out of bounds
-                    if (missile[i].position.y > window.height) missile[i].active = false;
-                    else
+                    for (int k = 0; k < candidatesCount; k++)
                     {
-                        // CHeck collision with launchers
-                        for (int j = 0; j < LAUNCHERS_AMOUNT; j++)
-                        {
-                            if (launcher[j].active)
-                            {
-                                if (rf_check_collision_point_rec(missile[i].position, (rf_rec) {
-                                    launcher[j].position.x - LAUNCHER_SIZE / 2, launcher[j].position.y - LAUNCHER_SIZE / 2,
-                                        LAUNCHER_SIZE, LAUNCHER_SIZE
-                                }))
-                                {
-                                    // Missile dissapears
-                                    missile[i].active = false;
-
-                                    // Explosion and destroy building
-                                    launcher[j].active = false;
-
-                                    explosion[explosionIndex].position = missile[i].position;
-                                    explosion[explosionIndex].active = true;
-                                    explosion[explosionIndex].frame = 0;
-                                    explosionIndex++;
-                                    if (explosionIndex == MAX_EXPLOSIONS) explosionIndex = 0;
-
-                                    break;
-                                }
-                            }
-                        }
+                        int j = explosionCandidates[k];
+                        float radius = EXPLOSION_RADIUS * explosion[j].radiusMultiplier;
+                        float dx = missile[i].position.x - explosion[j].position.x;
+                        float dy = missile[i].position.y - explosion[j].position.y;
 
-                        // CHeck collision with buildings
-                        for (int j = 0; j < BUILDINGS_AMOUNT; j++)
+                        if (dx*dx + dy*dy <= radius*radius)
                         {
-                            if (building[j].active)
-                            {
-                                if (rf_check_collision_point_rec(missile[i].position, (rf_rec) {
-                                    building[j].position.x - BUILDING_SIZE / 2, building[j].position.y - BUILDING_SIZE / 2,
-                                        BUILDING_SIZE, BUILDING_SIZE
-                                }))
-                                {
-                                    // Missile dissapears
-                                    missile[i].active = false;
-
-                                    // Explosion and destroy building
-                                    building[j].active = false;
-
-                                    explosion[explosionIndex].position = missile[i].position;
-                                    explosion[explosionIndex].active = true;
-                                    explosion[explosionIndex].frame = 0;
-                                    explosionIndex++;
-                                    if (explosionIndex == MAX_EXPLOSIONS) explosionIndex = 0;
-
-                                    break;
-                                }
-                            }
-                        }
+                            // Missile dissapears and we earn 100 points
+                            score += 100;
+                            AddExplosion(missile[i].position);
+                            destroyed = true;
 
-                        // CHeck collision with explosions
-                        for (int j = 0; j < MAX_EXPLOSIONS; j++)
-                        {
-                            if (explosion[j].active)
-                            {
-                                if (rf_check_collision_point_circle(missile[i].position, explosion[j].position, EXPLOSION_RADIUS * explosion[j].radiusMultiplier))
-                                {
-                                    // Missile dissapears and we earn 100 points
-                                    missile[i].active = false;
-                                    score += 100;
-
-                                    explosion[explosionIndex].position = missile[i].position;
-                                    explosion[explosionIndex].active = true;
-                                    explosion[explosionIndex].frame = 0;
-                                    explosionIndex++;
-                                    if (explosionIndex == MAX_EXPLOSIONS) explosionIndex = 0;
-
-                                    break;
-                                }
-                            }
+                            break;
                         }
                     }
                 }
+
+                // Missile dissapears
+                if (destroyed) missile[i] = missile[--missilesCount];
+                else i++;
             }
 
             // Explosions update
-            for (int i = 0; i < MAX_EXPLOSIONS; i++)
+            for (int i = 0; i < explosionsCount;)
             {
-                if (explosion[i].active)
-                {
-                    explosion[i].frame++;
+                explosion[i].frame++;
 
-                    if (explosion[i].frame <= EXPLOSION_INCREASE_TIME) explosion[i].radiusMultiplier = explosion[i].frame / (float)EXPLOSION_INCREASE_TIME;
-                    else if (explosion[i].frame <= EXPLOSION_TOTAL_TIME) explosion[i].radiusMultiplier = 1 - (explosion[i].frame - (float)EXPLOSION_INCREASE_TIME) / (float)EXPLOSION_TOTAL_TIME;
-                    else
-                    {
-                        explosion[i].frame = 0;
-                        explosion[i].active = false;
-                    }
+                if (explosion[i].frame <= EXPLOSION_INCREASE_TIME) explosion[i].radiusMultiplier = explosion[i].frame / (float)EXPLOSION_INCREASE_TIME;
+                else if (explosion[i].frame <= EXPLOSION_TOTAL_TIME) explosion[i].radiusMultiplier = 1 - (explosion[i].frame - (float)EXPLOSION_INCREASE_TIME) / (float)EXPLOSION_TOTAL_TIME;
+                else
+                {
+                    explosion[i] = explosion[--explosionsCount];
+                    continue;
                 }
+
+                i++;
             }
 
             // Fire logic
@@ -425,31 +359,25 @@ void DrawGame(void)
         if (!gameOver)
         {
             // Draw missiles
-            for (int i = 0; i < MAX_MISSILES; i++)
+            for (int i = 0; i < missilesCount; i++)
             {
-                if (missile[i].active)
-                {
-                    rf_draw_line(missile[i].origin.x, missile[i].origin.y, missile[i].position.x, missile[i].position.y, RF_RED);
+                rf_draw_line(missile[i].origin.x, missile[i].origin.y, missile[i].position.x, missile[i].position.y, RF_RED);
 
-                    if (framesCounter % 16 < 8) rf_draw_circle(missile[i].position.x, missile[i].position.y, 3, RF_YELLOW);
-                }
+                if (framesCounter % 16 < 8) rf_draw_circle(missile[i].position.x, missile[i].position.y, 3, RF_YELLOW);
             }
 
             // Draw interceptors
-            for (int i = 0; i < MAX_INTERCEPTORS; i++)
+            for (int i = 0; i < interceptorsCount; i++)
             {
-                if (interceptor[i].active)
-                {
-                    rf_draw_line(interceptor[i].origin.x, interceptor[i].origin.y, interceptor[i].position.x, interceptor[i].position.y, RF_GREEN);
+                rf_draw_line(interceptor[i].origin.x, interceptor[i].origin.y, interceptor[i].position.x, interceptor[i].position.y, RF_GREEN);
 
-                    if (framesCounter % 16 < 8) rf_draw_circle(interceptor[i].position.x, interceptor[i].position.y, 3, RF_BLUE);
-                }
+                if (framesCounter % 16 < 8) rf_draw_circle(interceptor[i].position.x, interceptor[i].position.y, 3, RF_BLUE);
             }
 
             // Draw explosions
-            for (int i = 0; i < MAX_EXPLOSIONS; i++)
+            for (int i = 0; i < explosionsCount; i++)
             {
-                if (explosion[i].active) rf_draw_circle(explosion[i].position.x, explosion[i].position.y, EXPLOSION_RADIUS * explosion[i].radiusMultiplier, EXPLOSION_COLOR);
+                rf_draw_circle(explosion[i].position.x, explosion[i].position.y, EXPLOSION_RADIUS * explosion[i].radiusMultiplier, EXPLOSION_COLOR);
             }
 
             // Draw buildings and launchers
@@ -465,6 +393,7 @@ void DrawGame(void)
 
             // Draw score
             rf_draw_text(TextFormat("SCORE %4i", score), 20, 20, 40, RF_LIGHTGRAY);
+            rf_draw_text(barrage? "[B] BARRAGE: ON" : "[B] BARRAGE: OFF", 20, 70, 10, RF_LIGHTGRAY);
 
             if (pause) rf_draw_text("GAME PAUSED", window.width / 2 - rf_measure_text(rf_get_default_font(), "GAME PAUSED", 40, 0).width / 2, window.height / 2 - 40, 40, RF_GRAY);
         }
@@ -477,6 +406,7 @@ void DrawGame(void)
 void UnloadGame(void)
 {
     // TODO: Unload all dynamic loaded data (textures, sounds, models...)
+    rf_unload_spatial_grid(explosionGrid);
 }
 
 // Update and Draw (one frame)
@@ -491,72 +421,116 @@ void UpdateDrawFrame(const platform_input_state* input)
 //--------------------------------------------------------------------------------------
 static void UpdateOutgoingFire(const platform_input_state* input)
 {
-    static int interceptorNumber = 0;
     int launcherShooting = 0;
 
     if (input->left_mouse_btn == BTN_PRESSED_DOWN) launcherShooting = 1;
     if (input->middle_mouse_btn == BTN_PRESSED_DOWN) launcherShooting = 2;
     if (input->mouse_y == BTN_PRESSED_DOWN) launcherShooting = 3;
 
-    if (launcherShooting > 0 && launcher[launcherShooting - 1].active)
+    if (launcherShooting > 0 && launcher[launcherShooting - 1].active && interceptorsCount < MAX_INTERCEPTORS)
     {
         float module;
         float sideX;
         float sideY;
 
         // Activate the interceptor
-        interceptor[interceptorNumber].active = true;
+        Interceptor* shot = &interceptor[interceptorsCount++];
 
         // Assign start position
-        interceptor[interceptorNumber].origin = launcher[launcherShooting - 1].position;
-        interceptor[interceptorNumber].position = interceptor[interceptorNumber].origin;
-        interceptor[interceptorNumber].objective = (rf_vec2){ input->mouse_x, input->mouse_y };
+        shot->origin = launcher[launcherShooting - 1].position;
+        shot->position = shot->origin;
+        shot->objective = (rf_vec2){ input->mouse_x, input->mouse_y };
 
         // Calculate speed
-        module = sqrt(pow(interceptor[interceptorNumber].objective.x - interceptor[interceptorNumber].origin.x, 2) +
-            pow(interceptor[interceptorNumber].objective.y - interceptor[interceptorNumber].origin.y, 2));
-
-        sideX = (interceptor[interceptorNumber].objective.x - interceptor[interceptorNumber].origin.x) * INTERCEPTOR_SPEED / module;
-        sideY = (interceptor[interceptorNumber].objective.y - interceptor[interceptorNumber].origin.y) * INTERCEPTOR_SPEED / module;
+        module = sqrt(pow(shot->objective.x - shot->origin.x, 2) + pow(shot->objective.y - shot->origin.y, 2));
 
-        interceptor[interceptorNumber].speed = (rf_vec2){ sideX, sideY };
+        sideX = (shot->objective.x - shot->origin.x) * INTERCEPTOR_SPEED / module;
+        sideY = (shot->objective.y - shot->origin.y) * INTERCEPTOR_SPEED / module;
 
-        // Update
-        interceptorNumber++;
-        if (interceptorNumber == MAX_INTERCEPTORS) interceptorNumber = 0;
+        shot->speed = (rf_vec2){ sideX, sideY };
     }
 }
 
 static void UpdateIncomingFire(const platform_input_state* input)
 {
-    static int missileIndex = 0;
-
     // Launch missile
-    if (framesCounter % MISSILE_LAUNCH_FRAMES == 0)
+    if ((framesCounter % (barrage? BARRAGE_LAUNCH_FRAMES : MISSILE_LAUNCH_FRAMES) == 0) && missilesCount < MAX_MISSILES)
     {
         float module;
         float sideX;
         float sideY;
 
         // Activate the missile
-        missile[missileIndex].active = true;
+        Missile* shot = &missile[missilesCount++];
 
         // Assign start position
-        missile[missileIndex].origin = (rf_vec2){ GetRandomValue(20, window.width - 20), -10 };
-        missile[missileIndex].position = missile[missileIndex].origin;
-        missile[missileIndex].objective = (rf_vec2){ GetRandomValue(20, window.width - 20), window.height + 10 };
+        shot->origin = (rf_vec2){ GetRandomValue(20, window.width - 20), -10 };
+        shot->position = shot->origin;
+        shot->objective = (rf_vec2){ GetRandomValue(20, window.width - 20), window.height + 10 };
 
         // Calculate speed
-        module = sqrt(pow(missile[missileIndex].objective.x - missile[missileIndex].origin.x, 2) +
-            pow(missile[missileIndex].objective.y - missile[missileIndex].origin.y, 2));
+        module = sqrt(pow(shot->objective.x - shot->origin.x, 2) + pow(shot->objective.y - shot->origin.y, 2));
+
+        sideX = (shot->objective.x - shot->origin.x) * MISSILE_SPEED / module;
+        sideY = (shot->objective.y - shot->origin.y) * MISSILE_SPEED / module;
+
+        shot->speed = (rf_vec2){ sideX, sideY };
+    }
+}
+
+// Rebuild the explosions broadphase from the active explosions
+static void UpdateExplosionGrid(void)
+{
+    for (int i = 0; i < explosionsCount; i++)
+    {
+        float radius = EXPLOSION_RADIUS * explosion[i].radiusMultiplier;
 
-        sideX = (missile[missileIndex].objective.x - missile[missileIndex].origin.x) * MISSILE_SPEED / module;
-        sideY = (missile[missileIndex].objective.y - missile[missileIndex].origin.y) * MISSILE_SPEED / module;
+        explosionRecs[i] = (rf_rec){ explosion[i].position.x - radius, explosion[i].position.y - radius, radius * 2, radius * 2 };
+    }
 
-        missile[missileIndex].speed = (rf_vec2){ sideX, sideY };
+    rf_spatial_grid_build(&explosionGrid, explosionRecs, explosionsCount);
+}
 
-        // Update
-        missileIndex++;
-        if (missileIndex == MAX_MISSILES) missileIndex = 0;
+// Start an explosion, it's dropped if there are too many already
+static void AddExplosion(rf_vec2 position)
+{
+    if (explosionsCount == MAX_EXPLOSIONS) return;
+
+    explosion[explosionsCount].position = position;
+    explosion[explosionsCount].radiusMultiplier = 0;
+    explosion[explosionsCount].frame = 0;
+    explosionsCount++;
+}
+
+// Check if a missile hits an active launcher or building and destroy it
+// NOTE: They all stand on the ground, so missiles above the tallest of them are skipped
+static bool CheckMissileHitGround(rf_vec2 position)
+{
+    if (position.y < window.height - ((LAUNCHER_SIZE > BUILDING_SIZE)? LAUNCHER_SIZE : BUILDING_SIZE)) return false;
+
+    for (int j = 0; j < LAUNCHERS_AMOUNT; j++)
+    {
+        if (launcher[j].active && rf_check_collision_point_rec(position, (rf_rec) {
+            launcher[j].position.x - LAUNCHER_SIZE / 2, launcher[j].position.y - LAUNCHER_SIZE / 2,
+                LAUNCHER_SIZE, LAUNCHER_SIZE
+        }))
+        {
+            launcher[j].active = false;
+            return true;
+        }
+    }
+
+    for (int j = 0; j < BUILDINGS_AMOUNT; j++)
+    {
+        if (building[j].active && rf_check_collision_point_rec(position, (rf_rec) {
+            building[j].position.x - BUILDING_SIZE / 2, building[j].position.y - BUILDING_SIZE / 2,
+                BUILDING_SIZE, BUILDING_SIZE
+        }))
+        {
+            building[j].active = false;
+            return true;
+        }
     }
+
+    return false;
 }
\ No newline at end of file
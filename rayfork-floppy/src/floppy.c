@@ -16,9 +16,10 @@
 //----------------------------------------------------------------------------------
 // Some Defines
 //----------------------------------------------------------------------------------
-#define MAX_TUBES 100
+#define MAX_TUBES 8              // Tubes alive at once, enough to cover the screen and the next ones
 #define FLOPPY_RADIUS 24
 #define TUBES_WIDTH 80
+#define TUBES_SPACING 280
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -44,8 +45,9 @@ static int score = 0;
 static int hiScore = 0;
 
 static Floppy floppy = { 0 };
-static Tubes tubes[MAX_TUBES * 2] = { 0 };
+static Tubes tubes[MAX_TUBES * 2] = { 0 };     // Ring buffer, top and bottom tubes of every position
 static rf_vec2 tubesPos[MAX_TUBES] = { 0 };
+static int firstTube = 0;                       // Leftmost tubes in the ring, recycled once behind the screen
 static int tubesSpeedX = 0;
 static bool superfx = false;
 
@@ -58,6 +60,9 @@ static void DrawGame(void);                                      // Draw game (o
 static void UnloadGame(void);                                    // Unload game
 static void UpdateDrawFrame(const platform_input_state* input);  // Update and Draw (one frame)
 
+// Additional module functions
+static void SpawnTubes(int i, float x);
+
 // Formatting of text with variables to 'embed'
 // WARNING: String returned will expire after this function is called MAX_TEXTFORMAT_BUFFERS times
 #define MAX_TEXT_BUFFER_LENGTH              1024        // Size of internal static buffers used on some functions:
@@ -139,26 +144,9 @@ void InitGame(void)
     floppy.position = (rf_vec2){ 80, window.height / 2 - floppy.radius };
     tubesSpeedX = 2;
 
-    for (int i = 0; i < MAX_TUBES; i++)
-    {
-        tubesPos[i].x = 400 + 280 * i;
-        tubesPos[i].y = -GetRandomValue(0, 120);
-    }
+    for (int i = 0; i < MAX_TUBES; i++) SpawnTubes(i, 400 + TUBES_SPACING * i);
 
-    for (int i = 0; i < MAX_TUBES * 2; i += 2)
-    {
-        tubes[i].rec.x = tubesPos[i / 2].x;
-        tubes[i].rec.y = tubesPos[i / 2].y;
-        tubes[i].rec.width = TUBES_WIDTH;
-        tubes[i].rec.height = 255;
-
-        tubes[i + 1].rec.x = tubesPos[i / 2].x;
-        tubes[i + 1].rec.y = 600 + tubesPos[i / 2].y - 255;
-        tubes[i + 1].rec.width = TUBES_WIDTH;
-        tubes[i + 1].rec.height = 255;
-
-        tubes[i / 2].active = true;
-    }
+    firstTube = 0;
 
     score = 0;
 
@@ -176,29 +164,44 @@ void UpdateGame(const platform_input_state* input)
 
         if (!pause)
         {
-            for (int i = 0; i < MAX_TUBES; i++) tubesPos[i].x -= tubesSpeedX;
+            for (int i = 0; i < MAX_TUBES; i++)
+            {
+                tubesPos[i].x -= tubesSpeedX;
+
+                tubes[i * 2].rec.x = tubesPos[i].x;
+                tubes[i * 2 + 1].rec.x = tubesPos[i].x;
+            }
 
-            for (int i = 0; i < MAX_TUBES * 2; i += 2)
+            // Recycle the tubes left behind the screen as the next ones after the last, the level never ends
+            while (tubesPos[firstTube].x + TUBES_WIDTH < 0)
             {
-                tubes[i].rec.x = tubesPos[i / 2].x;
-                tubes[i + 1].rec.x = tubesPos[i / 2].x;
+                int lastTube = (firstTube + MAX_TUBES - 1) % MAX_TUBES;
+
+                SpawnTubes(firstTube, tubesPos[lastTube].x + TUBES_SPACING);
+                firstTube = (firstTube + 1) % MAX_TUBES;
             }
 
             if (input->keys[KEYCODE_SPACE] == KEY_HOLD_DOWN && !gameOver) floppy.position.y -= 3;
             else floppy.position.y += 1;
 
-            // Check Collisions
-            for (int i = 0; i < MAX_TUBES * 2; i++)
+            // Check Collisions, only against the tubes overlapping the floppy horizontally
+            for (int n = 0; n < MAX_TUBES; n++)
             {
-                if (rf_check_collision_circle_rec(floppy.position, floppy.radius, tubes[i].rec))
+                int i = (firstTube + n) % MAX_TUBES;
+
+                if (tubesPos[i].x > floppy.position.x + floppy.radius) break;
+                if (tubesPos[i].x + TUBES_WIDTH < floppy.position.x - floppy.radius) continue;
+
+                if (rf_check_collision_circle_rec(floppy.position, floppy.radius, tubes[i * 2].rec) ||
+                    rf_check_collision_circle_rec(floppy.position, floppy.radius, tubes[i * 2 + 1].rec))
                 {
                     gameOver = true;
                     pause = false;
                 }
-                else if ((tubesPos[i / 2].x < floppy.position.x) && tubes[i / 2].active && !gameOver)
+                else if ((tubesPos[i].x < floppy.position.x) && tubes[i * 2].active && !gameOver)
                 {
                     score += 100;
-                    tubes[i / 2].active = false;
+                    tubes[i * 2].active = false;
 
                     superfx = true;
 
@@ -228,9 +231,13 @@ void DrawGame(void)
         {
             rf_draw_circle(floppy.position.x, floppy.position.y, floppy.radius, RF_DARKGRAY);
 
-            // Draw tubes
-            for (int i = 0; i < MAX_TUBES; i++)
+            // Draw tubes, from left to right until they are out of the screen
+            for (int n = 0; n < MAX_TUBES; n++)
             {
+                int i = (firstTube + n) % MAX_TUBES;
+
+                if (tubesPos[i].x >= window.width) break;
+
                 rf_draw_rectangle(tubes[i * 2].rec.x, tubes[i * 2].rec.y, tubes[i * 2].rec.width, tubes[i * 2].rec.height, RF_GRAY);
                 rf_draw_rectangle(tubes[i * 2 + 1].rec.x, tubes[i * 2 + 1].rec.y, tubes[i * 2 + 1].rec.width, tubes[i * 2 + 1].rec.height, RF_GRAY);
             }
@@ -262,4 +269,27 @@ void UpdateDrawFrame(const platform_input_state* input)
 {
     UpdateGame(input);
     DrawGame();
+}
+
+//------------------------------------------------------------------------------------
+// Additional module functions
+//------------------------------------------------------------------------------------
+
+// Place the top and bottom tubes of ring position i at x with a random gap height
+static void SpawnTubes(int i, float x)
+{
+    tubesPos[i].x = x;
+    tubesPos[i].y = -GetRandomValue(0, 120);
+
+    tubes[i * 2].rec.x = tubesPos[i].x;
+    tubes[i * 2].rec.y = tubesPos[i].y;
+    tubes[i * 2].rec.width = TUBES_WIDTH;
+    tubes[i * 2].rec.height = 255;
+
+    tubes[i * 2 + 1].rec.x = tubesPos[i].x;
+    tubes[i * 2 + 1].rec.y = 600 + tubesPos[i].y - 255;
+    tubes[i * 2 + 1].rec.width = TUBES_WIDTH;
+    tubes[i * 2 + 1].rec.height = 255;
+
+    tubes[i * 2].active = true;
 }
\ No newline at end of file
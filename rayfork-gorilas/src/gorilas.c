@@ -17,9 +17,10 @@
 // Some Defines
 //----------------------------------------------------------------------------------
 #define MAX_BUILDINGS                    15
-#define MAX_EXPLOSIONS                  200
 #define MAX_PLAYERS                       2
 
+#define EXPLOSION_RADIUS                 30
+
 #define BUILDING_RELATIVE_ERROR          30        // Building size random range %
 #define BUILDING_MIN_RELATIVE_HEIGHT     20        // Minimum height in % of the window.height
 #define BUILDING_MAX_RELATIVE_HEIGHT     60        // Maximum height in % of the window.height
@@ -32,6 +33,19 @@
 #define GRAVITY                       9.81f
 #define DELTA_FPS                        60
 
+// Computer player tries every angle and power of the firing quadrant, flying the shots in job system batches
+#define AI_MAX_ANGLE                     89
+#define AI_MIN_POWER                     10
+#define AI_MAX_POWER                    400
+#define AI_SHOTS                        ((AI_MAX_ANGLE + 1)*(AI_MAX_POWER - AI_MIN_POWER + 1))
+#define AI_SHOT_BATCH                    64
+#define AI_MAX_FRAMES                  1200        // Frames a simulated ball can fly before the shot is given up
+#define AI_REACH_MARGIN                2.0f        // Pixels of slack on the closed form reach test
+#define AI_FRAME_TIME                 0.008        // Seconds of search every frame
+#define AI_TURN_TIME                    1.0        // Seconds of search a turn can take before firing the best shot
+
+#define SOAK_FRAME_TIME               0.014        // Seconds of game simulated every frame on soak mode
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -59,12 +73,6 @@ typedef struct Building {
     rf_color color;
 } Building;
 
-typedef struct Explosion {
-    rf_vec2 position;
-    int radius;
-    bool active;
-} Explosion;
-
 typedef struct Ball {
     rf_vec2 position;
     rf_vec2 speed;
@@ -72,6 +80,22 @@ typedef struct Ball {
     bool active;
 } Ball;
 
+typedef enum BallHit { BALL_FLYING, BALL_OUT, BALL_PLAYER, BALL_TERRAIN } BallHit;
+
+typedef struct Shot {
+    int angle;
+    int power;
+    bool hit;                       // The ball hits a player of the other team
+    float distance;                 // Distance from where the ball stops to the closest player of the other team
+    int frames;
+} Shot;
+
+// Every job flies one shot of the batch with the same physics as the ball
+typedef struct ShotSearch {
+    int shooter;
+    Shot* shots;
+} ShotSearch;
+
 //------------------------------------------------------------------------------------
 // Global Variables Declaration
 //------------------------------------------------------------------------------------
@@ -80,12 +104,40 @@ static bool pause = false;
 
 static Player player[MAX_PLAYERS] = { 0 };
 static Building building[MAX_BUILDINGS] = { 0 };
-static Explosion explosion[MAX_EXPLOSIONS] = { 0 };
 static Ball ball = { 0 };
 
+// Skyline bitmask with one bit per pixel, set where a building is still standing
+static uint32_t* terrain = NULL;
+static int terrainWidth = 0;                    // Size the terrain was allocated with, the window may be resized since
+static int terrainHeight = 0;
+static int terrainWords = 0;                    // Words on every row of the bitmask
+
+// Skyline drawing, only the region changed since the last frame is uploaded
+static rf_image terrainImage = { 0 };
+static rf_texture2d terrainTexture = { 0 };
+static rf_color* terrainUpload = NULL;
+static rf_rec terrainDirty = { 0 };
+
 static int playerTurn = 0;
 static bool ballOnAir = false;
 
+// Computer player, the search of a turn is spread over several frames
+static bool versusCPU = true;
+static bool aiSearching = false;
+static Shot aiShots[AI_SHOTS];
+static int aiShotsCount = 0;
+static int aiNextShot = 0;
+static Shot aiBestShot = { 0 };
+static double aiTurnTime = 0;
+
+// Soak mode plays computer players against each other as fast as possible
+static bool soak = false;
+static long soakGames = 0;
+static long soakShots = 0;
+static long soakTrajectories = 0;
+static long soakBallFrames = 0;
+static double soakSearchTime = 0;
+
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
 //------------------------------------------------------------------------------------
@@ -100,6 +152,49 @@ static void InitBuildings(void);
 static void InitPlayers(void);
 static bool UpdatePlayer(int playerTurn, const platform_input_state* input);
 static bool UpdateBall(int playerTurn);
+static void LoadTerrain(void);
+static void InitTerrain(void);
+static uint32_t GetTerrainSpanMask(int w, int x0, int x1);
+static bool CheckTerrainCollision(rf_vec2 center, int radius);
+static void CarveTerrain(rf_vec2 center, int radius);
+static void UpdateTerrainTexture(void);
+static BallHit MoveBall(rf_vec2* position, rf_vec2* speed, int radius, int shooter, int* hitPlayer);
+static rf_vec2 GetBallSpeed(int shooter, int angle, int power);
+static void InitPlayerControls(void);
+static void EndTurn(void);
+static bool CheckShotReach(int shooter, rf_vec2 speed);
+static void SimulateShotJob(void* data, rf_int index);
+static void InitShotSearch(int shooter);
+static bool UpdateAI(int playerTurn);
+static void InitSoak(void);
+static void UpdateSoak(void);
+
+// Formatting of text with variables to 'embed'
+// WARNING: String returned will expire after this function is called MAX_TEXTFORMAT_BUFFERS times
+#define MAX_TEXT_BUFFER_LENGTH              1024        // Size of internal static buffers used on some functions:
+const char* TextFormat(const char* text, ...)
+{
+#ifndef MAX_TEXTFORMAT_BUFFERS
+#define MAX_TEXTFORMAT_BUFFERS 4        // Maximum number of static buffers for text formatting
+#endif
+
+    // We create an array of buffers so strings don't expire until MAX_TEXTFORMAT_BUFFERS invocations
+    static char buffers[MAX_TEXTFORMAT_BUFFERS][MAX_TEXT_BUFFER_LENGTH] = { 0 };
+    static int  index = 0;
+
+    char* currentBuffer = buffers[index];
+    memset(currentBuffer, 0, MAX_TEXT_BUFFER_LENGTH);   // Clear buffer before using
+
+    va_list args;
+    va_start(args, text);
+    vsprintf(currentBuffer, text, args);
+    va_end(args);
+
+    index += 1;     // Move to next buffer for next function call
+    if (index >= MAX_TEXTFORMAT_BUFFERS) index = 0;
+
+    return currentBuffer;
+}
 
 // Returns a random value between min and max (both included)
 int GetRandomValue(int min, int max)
@@ -114,6 +209,9 @@ int GetRandomValue(int min, int max)
     return (rand() % (abs(max - min) + 1) + min);
 }
 
+static int MinInt(int a, int b) { return (a < b)? a : b; }
+static int MaxInt(int a, int b) { return (a > b)? a : b; }
+
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
@@ -140,6 +238,9 @@ extern void game_init(rf_gfx_backend_data* gfx_data)
     batch = rf_create_default_render_batch(RF_DEFAULT_ALLOCATOR);
     rf_set_active_render_batch(&batch);
 
+    // The computer player search and soak mode are timed
+    stm_setup();
+
     InitGame();
 }
 
@@ -159,64 +260,45 @@ void InitGame(void)
     ball.radius = 10;
     ballOnAir = false;
     ball.active = false;
+    aiSearching = false;
 
     InitBuildings();
     InitPlayers();
-
-    // Init explosions
-    for (int i = 0; i < MAX_EXPLOSIONS; i++)
-    {
-        explosion[i].position = (rf_vec2){ 0.0f, 0.0f };
-        explosion[i].radius = 30;
-        explosion[i].active = false;
-    }
+    InitTerrain();
 }
 
 // Update game (one frame)
 void UpdateGame(const platform_input_state* input)
 {
-    if (!gameOver)
+    if (input->keys[KEYCODE_S] == KEY_PRESSED_DOWN)
+    {
+        soak = !soak;
+        if (soak) InitSoak();
+
+        // Both modes start on a new game
+        InitGame();
+        gameOver = false;
+    }
+
+    if (soak) UpdateSoak();
+    else if (!gameOver)
     {
         if (input->keys[KEYCODE_P] == KEY_PRESSED_DOWN) pause = !pause;
 
+        if (input->keys[KEYCODE_A] == KEY_PRESSED_DOWN)
+        {
+            versusCPU = !versusCPU;
+            InitPlayerControls();
+        }
+
         if (!pause)
         {
-            if (!ballOnAir) ballOnAir = UpdatePlayer(playerTurn, input); // If we are aiming
-            else
+            if (!ballOnAir)                                       // If we are aiming
             {
-                if (UpdateBall(playerTurn))                       // If collision
-                {
-                    // Game over logic
-                    bool leftTeamAlive = false;
-                    bool rightTeamAlive = false;
-
-                    for (int i = 0; i < MAX_PLAYERS; i++)
-                    {
-                        if (player[i].isAlive)
-                        {
-                            if (player[i].isLeftTeam) leftTeamAlive = true;
-                            if (!player[i].isLeftTeam) rightTeamAlive = true;
-                        }
-                    }
-
-                    if (leftTeamAlive && rightTeamAlive)
-                    {
-                        ballOnAir = false;
-                        ball.active = false;
-
-                        playerTurn++;
-
-                        if (playerTurn == MAX_PLAYERS) playerTurn = 0;
-                    }
-                    else
-                    {
-                        gameOver = true;
-
-                        // if (leftTeamAlive) left team wins
-                        // if (rightTeamAlive) right team wins
-                    }
-                }
+                if (player[playerTurn].isPlayer) ballOnAir = UpdatePlayer(playerTurn, input);
+                else ballOnAir = UpdateAI(playerTurn);
             }
+            else if (UpdateBall(playerTurn)) EndTurn();           // If collision
         }
     }
     else
@@ -232,20 +314,29 @@ void UpdateGame(const platform_input_state* input)
 // Draw game (one frame)
 void DrawGame(void)
 {
+    UpdateTerrainTexture();
+
     rf_begin();
     {
         rf_clear(RF_RAYWHITE);
 
-        if (!gameOver)
+        if (soak)
         {
-            // Draw buildings
-            for (int i = 0; i < MAX_BUILDINGS; i++) rf_draw_rectangle_rec(building[i].rectangle, building[i].color);
-
-            // Draw explosions
-            for (int i = 0; i < MAX_EXPLOSIONS; i++)
-            {
-                if (explosion[i].active) rf_draw_circle(explosion[i].position.x, explosion[i].position.y, explosion[i].radius, RF_RAYWHITE);
-            }
+            int trajectoriesPerSecond = (soakSearchTime > 0)? (int)(soakTrajectories/soakSearchTime) : 0;
+            int ballFramesPerSecond = (soakSearchTime > 0)? (int)(soakBallFrames/soakSearchTime) : 0;
+
+            rf_draw_text("CPU SOAK", 20, 20, 40, RF_GRAY);
+            rf_draw_text(TextFormat("GAMES:          %li", soakGames), 20, 80, 20, RF_GRAY);
+            rf_draw_text(TextFormat("SHOTS:          %li", soakShots), 20, 110, 20, RF_GRAY);
+            rf_draw_text(TextFormat("TRAJECTORIES:   %li", soakTrajectories), 20, 140, 20, RF_GRAY);
+            rf_draw_text(TextFormat("TRAJECTORIES/S: %i", trajectoriesPerSecond), 20, 170, 20, RF_GRAY);
+            rf_draw_text(TextFormat("BALL FRAMES/S:  %i", ballFramesPerSecond), 20, 200, 20, RF_GRAY);
+            rf_draw_text("PRESS [S] TO STOP", 20, window.height - 40, 20, RF_GRAY);
+        }
+        else if (!gameOver)
+        {
+            // Draw buildings, explosions are already carved out of them
+            rf_draw_texture(terrainTexture, 0, 0, RF_WHITE);
 
             // Draw players
             for (int i = 0; i < MAX_PLAYERS; i++)
@@ -322,6 +413,9 @@ void DrawGame(void)
                 }
             }
 
+            const char* versusText = versusCPU? "[A] VS CPU: ON" : "[A] VS CPU: OFF";
+            rf_draw_text(versusText, window.width / 2 - rf_measure_text(rf_get_default_font(), versusText, 10, 0).width / 2, 10, 10, RF_GRAY);
+
             if (pause) rf_draw_text("GAME PAUSED", window.width / 2 - rf_measure_text(rf_get_default_font(), "GAME PAUSED", 40, 0).width / 2, window.height / 2 - 40, 40, RF_GRAY);
         }
         else rf_draw_text("PRESS [ENTER] TO PLAY AGAIN", window.width / 2 - rf_measure_text(rf_get_default_font(), "PRESS [ENTER] TO PLAY AGAIN", 20, 0).width / 2, window.height / 2 - 50, 20, RF_GRAY);
@@ -333,6 +427,13 @@ void DrawGame(void)
 void UnloadGame(void)
 {
     // TODO: Unload all dynamic loaded data (textures, sounds, models...)
+    rf_unload_texture(terrainTexture);
+    rf_unload_image(terrainImage, RF_DEFAULT_ALLOCATOR);
+    RF_FREE(RF_DEFAULT_ALLOCATOR, terrainUpload);
+    RF_FREE(RF_DEFAULT_ALLOCATOR, terrain);
+#if defined(RAYFORK_ENABLE_THREADS)
+    rf_threads_shutdown();
+#endif
 }
 
 // Update and Draw (one frame)
@@ -390,9 +491,6 @@ static void InitPlayers(void)
         if (i % 2 == 0) player[i].isLeftTeam = true;
         else player[i].isLeftTeam = false;
 
-        // Now there is no AI
-        player[i].isPlayer = true;
-
         // Set size, by default by now
         player[i].size = (rf_vec2){ 40, 40 };
 
@@ -422,6 +520,8 @@ static void InitPlayers(void)
 
         player[i].impactPoint = (rf_vec2){ -100, -100 };
     }
+
+    InitPlayerControls();
 }
 
 static bool UpdatePlayer(int playerTurn, const platform_input_state* input)
@@ -490,84 +590,453 @@ static bool UpdatePlayer(int playerTurn, const platform_input_state* input)
 
 static bool UpdateBall(int playerTurn)
 {
-    static int explosionNumber = 0;
-
     // Activate ball
     if (!ball.active)
     {
-        if (player[playerTurn].isLeftTeam)
-        {
-            ball.speed.x = cos(player[playerTurn].previousAngle * RF_DEG2RAD) * player[playerTurn].previousPower * 3 / DELTA_FPS;
-            ball.speed.y = -sin(player[playerTurn].previousAngle * RF_DEG2RAD) * player[playerTurn].previousPower * 3 / DELTA_FPS;
-            ball.active = true;
-        }
-        else
-        {
-            ball.speed.x = -cos(player[playerTurn].previousAngle * RF_DEG2RAD) * player[playerTurn].previousPower * 3 / DELTA_FPS;
-            ball.speed.y = -sin(player[playerTurn].previousAngle * RF_DEG2RAD) * player[playerTurn].previousPower * 3 / DELTA_FPS;
-            ball.active = true;
-        }
+        ball.speed = GetBallSpeed(playerTurn, player[playerTurn].previousAngle, player[playerTurn].previousPower);
+        ball.active = true;
     }
 
-    ball.position.x += ball.speed.x;
-    ball.position.y += ball.speed.y;
-    ball.speed.y += GRAVITY / DELTA_FPS;
+    int hitPlayer = 0;
+    BallHit hit = MoveBall(&ball.position, &ball.speed, ball.radius, playerTurn, &hitPlayer);
 
-    // Collision
-    if (ball.position.x + ball.radius < 0) return true;
-    else if (ball.position.x - ball.radius > window.width) return true;
-    else
+    if ((hit == BALL_PLAYER) || (hit == BALL_TERRAIN))
     {
+        // We set the impact point
+        player[playerTurn].impactPoint.x = ball.position.x;
+        player[playerTurn].impactPoint.y = ball.position.y + ball.radius;
+
+        // We destroy the player or blow up the buildings
+        if (hit == BALL_PLAYER) player[hitPlayer].isAlive = false;
+        else CarveTerrain(player[playerTurn].impactPoint, EXPLOSION_RADIUS);
+    }
+
+    return hit != BALL_FLYING;
+}
+
+// Move a ball one frame along its path in steps no longer than its radius, so it can't skip through thin walls
+// NOTE: Only reads the game state, the ball stops at the position of the first collision
+static BallHit MoveBall(rf_vec2* position, rf_vec2* speed, int radius, int shooter, int* hitPlayer)
+{
+    rf_vec2 start = *position;
+    rf_vec2 move = *speed;
+
+    speed->y += GRAVITY / DELTA_FPS;
+
+    int steps = (int)ceilf(sqrtf(move.x*move.x + move.y*move.y) / radius);
+    if (steps < 1) steps = 1;
+
+    for (int step = 1; step <= steps; step++)
+    {
+        float t = (float)step / steps;
+        *position = (rf_vec2){ start.x + move.x * t, start.y + move.y * t };
+
+        // Out of the screen sides or fallen below it
+        if ((position->x + radius < 0) || (position->x - radius > window.width) || (position->y - radius > window.height)) return BALL_OUT;
+
         // Player collision
+        bool insideShooter = false;
+
         for (int i = 0; i < MAX_PLAYERS; i++)
         {
-            if (rf_check_collision_circle_rec(ball.position, ball.radius, (rf_rec) {
+            if (player[i].isAlive && rf_check_collision_circle_rec(*position, radius, (rf_rec) {
                 player[i].position.x - player[i].size.x / 2, player[i].position.y - player[i].size.y / 2,
                     player[i].size.x, player[i].size.y
             }))
             {
-                // We can't hit ourselves
-                if (i == playerTurn) return false;
+                // We can't hit ourselves, and the buildings don't stop the ball while it leaves the shooter
+                if (i == shooter) insideShooter = true;
                 else
                 {
-                    // We set the impact point
-                    player[playerTurn].impactPoint.x = ball.position.x;
-                    player[playerTurn].impactPoint.y = ball.position.y + ball.radius;
-
-                    // We destroy the player
-                    player[i].isAlive = false;
-                    return true;
+                    *hitPlayer = i;
+                    return BALL_PLAYER;
                 }
             }
         }
 
         // Building collision
-        // NOTE: We only check building collision if we are not inside an explosion
-        for (int i = 0; i < MAX_BUILDINGS; i++)
+        if (!insideShooter && CheckTerrainCollision(*position, radius)) return BALL_TERRAIN;
+    }
+
+    return BALL_FLYING;
+}
+
+// Allocate the skyline bitmask, image and texture for the current window size, freeing the previous ones
+static void LoadTerrain(void)
+{
+    if (terrain)
+    {
+        rf_unload_texture(terrainTexture);
+        rf_unload_image(terrainImage, RF_DEFAULT_ALLOCATOR);
+        RF_FREE(RF_DEFAULT_ALLOCATOR, terrainUpload);
+        RF_FREE(RF_DEFAULT_ALLOCATOR, terrain);
+    }
+
+    terrainWidth = window.width;
+    terrainHeight = window.height;
+    terrainWords = (terrainWidth + 31) / 32;
+
+    terrain = RF_ALLOC(RF_DEFAULT_ALLOCATOR, terrainWords * terrainHeight * sizeof(uint32_t));
+    terrainImage = rf_gen_image_color(terrainWidth, terrainHeight, RF_BLANK, RF_DEFAULT_ALLOCATOR);
+    terrainTexture = rf_load_texture_from_image(terrainImage);
+    terrainUpload = RF_ALLOC(RF_DEFAULT_ALLOCATOR, terrainWidth * terrainHeight * sizeof(rf_color));
+}
+
+// Fill the skyline bitmask and image with the buildings, the whole image has to be uploaded
+static void InitTerrain(void)
+{
+    // The buildings are laid out for the current window, so the terrain follows it when a game starts
+    if (!terrain || (terrainWidth != window.width) || (terrainHeight != window.height)) LoadTerrain();
+
+    memset(terrain, 0, terrainWords * terrainHeight * sizeof(uint32_t));
+    memset(terrainImage.data, 0, terrainWidth * terrainHeight * sizeof(rf_color));
+
+    rf_color* pixels = (rf_color*) terrainImage.data;
+
+    for (int i = 0; i < MAX_BUILDINGS; i++)
+    {
+        int x0 = MaxInt((int)building[i].rectangle.x, 0);
+        int x1 = MinInt((int)(building[i].rectangle.x + building[i].rectangle.width), terrainWidth);
+        int y0 = MaxInt((int)building[i].rectangle.y, 0);
+
+        for (int y = y0; y < terrainHeight; y++)
         {
-            if (rf_check_collision_circles(ball.position, ball.radius, explosion[i].position, explosion[i].radius - ball.radius))
+            for (int x = x0; x < x1; x++)
             {
-                return false;
+                terrain[y * terrainWords + x / 32] |= 1u << (x % 32);
+                pixels[y * terrainWidth + x] = building[i].color;
             }
         }
+    }
+
+    terrainDirty = (rf_rec){ 0, 0, terrainWidth, terrainHeight };
+}
 
-        for (int i = 0; i < MAX_BUILDINGS; i++)
+// Mask of the bits of word w covered by the pixel span [x0, x1]
+static uint32_t GetTerrainSpanMask(int w, int x0, int x1)
+{
+    int first = MaxInt(x0 - w * 32, 0);
+    int last = MinInt(x1 - w * 32, 31);
+
+    return (0xFFFFFFFFu >> (31 - last + first)) << first;
+}
+
+// Check if any standing building pixel has its center inside the circle
+static bool CheckTerrainCollision(rf_vec2 center, int radius)
+{
+    int y0 = MaxInt((int)floorf(center.y - radius), 0);
+    int y1 = MinInt((int)ceilf(center.y + radius), terrainHeight - 1);
+
+    for (int y = y0; y <= y1; y++)
+    {
+        float dy = y + 0.5f - center.y;
+        if (dy*dy > radius*radius) continue;
+
+        float half = sqrtf(radius*radius - dy*dy);
+        int x0 = MaxInt((int)ceilf(center.x - half - 0.5f), 0);
+        int x1 = MinInt((int)floorf(center.x + half - 0.5f), terrainWidth - 1);
+
+        for (int w = x0 / 32; (x0 <= x1) && (w <= x1 / 32); w++)
         {
-            if (rf_check_collision_circle_rec(ball.position, ball.radius, building[i].rectangle))
-            {
-                // We set the impact point
-                player[playerTurn].impactPoint.x = ball.position.x;
-                player[playerTurn].impactPoint.y = ball.position.y + ball.radius;
+            if (terrain[y * terrainWords + w] & GetTerrainSpanMask(w, x0, x1)) return true;
+        }
+    }
+
+    return false;
+}
 
-                // We create an explosion
-                explosion[explosionNumber].position = player[playerTurn].impactPoint;
-                explosion[explosionNumber].active = true;
-                explosionNumber++;
+// Clear every building pixel with its center inside the circle and mark the region to be uploaded
+static void CarveTerrain(rf_vec2 center, int radius)
+{
+    rf_color* pixels = (rf_color*) terrainImage.data;
 
-                return true;
-            }
+    int y0 = MaxInt((int)floorf(center.y - radius), 0);
+    int y1 = MinInt((int)ceilf(center.y + radius), terrainHeight - 1);
+    int minX = terrainWidth, maxX = -1;
+
+    for (int y = y0; y <= y1; y++)
+    {
+        float dy = y + 0.5f - center.y;
+        if (dy*dy > radius*radius) continue;
+
+        float half = sqrtf(radius*radius - dy*dy);
+        int x0 = MaxInt((int)ceilf(center.x - half - 0.5f), 0);
+        int x1 = MinInt((int)floorf(center.x + half - 0.5f), terrainWidth - 1);
+
+        if (x0 > x1) continue;
+
+        for (int w = x0 / 32; w <= x1 / 32; w++) terrain[y * terrainWords + w] &= ~GetTerrainSpanMask(w, x0, x1);
+        for (int x = x0; x <= x1; x++) pixels[y * terrainWidth + x] = RF_BLANK;
+
+        minX = MinInt(minX, x0);
+        maxX = MaxInt(maxX, x1);
+    }
+
+    if (maxX < minX) return;
+
+    // Grow the dirty region to cover the carved circle
+    rf_rec carved = { minX, y0, maxX - minX + 1, y1 - y0 + 1 };
+
+    if ((terrainDirty.width > 0) && (terrainDirty.height > 0))
+    {
+        float x = fminf(terrainDirty.x, carved.x);
+        float y = fminf(terrainDirty.y, carved.y);
+
+        carved.width = fmaxf(terrainDirty.x + terrainDirty.width, carved.x + carved.width) - x;
+        carved.height = fmaxf(terrainDirty.y + terrainDirty.height, carved.y + carved.height) - y;
+        carved.x = x;
+        carved.y = y;
+    }
+
+    terrainDirty = carved;
+}
+
+// Upload the changed region of the skyline image, packing its rows
+static void UpdateTerrainTexture(void)
+{
+    if ((terrainDirty.width <= 0) || (terrainDirty.height <= 0)) return;
+
+    int x = (int)terrainDirty.x;
+    int y = (int)terrainDirty.y;
+    int width = (int)terrainDirty.width;
+    int height = (int)terrainDirty.height;
+
+    for (int row = 0; row < height; row++)
+    {
+        memcpy(terrainUpload + row * width, (rf_color*) terrainImage.data + (y + row) * terrainWidth + x, width * sizeof(rf_color));
+    }
+
+    rf_update_texture_rec(terrainTexture, terrainDirty, terrainUpload, width * height * sizeof(rf_color));
+
+    terrainDirty = (rf_rec){ 0 };
+}
+
+// Speed of the ball fired by a player with an aim
+static rf_vec2 GetBallSpeed(int shooter, int angle, int power)
+{
+    rf_vec2 speed;
+    speed.x = cos(angle * RF_DEG2RAD) * power * 3 / DELTA_FPS;
+    speed.y = -sin(angle * RF_DEG2RAD) * power * 3 / DELTA_FPS;
+
+    // The right team fires to the left
+    if (!player[shooter].isLeftTeam) speed.x = -speed.x;
+
+    return speed;
+}
+
+// The left team is always human, the right team is the computer when playing against it, soak mode has no humans
+static void InitPlayerControls(void)
+{
+    for (int i = 0; i < MAX_PLAYERS; i++) player[i].isPlayer = !soak && (player[i].isLeftTeam || !versusCPU);
+
+    aiSearching = false;
+}
+
+// Pass the turn after a collision or finish the game if a team is dead
+static void EndTurn(void)
+{
+    // Game over logic
+    bool leftTeamAlive = false;
+    bool rightTeamAlive = false;
+
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        if (player[i].isAlive)
+        {
+            if (player[i].isLeftTeam) leftTeamAlive = true;
+            if (!player[i].isLeftTeam) rightTeamAlive = true;
+        }
+    }
+
+    if (leftTeamAlive && rightTeamAlive)
+    {
+        ballOnAir = false;
+        ball.active = false;
+
+        playerTurn++;
+
+        if (playerTurn == MAX_PLAYERS) playerTurn = 0;
+    }
+    else
+    {
+        gameOver = true;
+
+        // if (leftTeamAlive) left team wins
+        // if (rightTeamAlive) right team wins
+    }
+}
+
+// Check if the parabola of a shot goes through a player of the other team, ignoring the buildings
+// NOTE: After n frames the ball is at start + speed*n + (0, gravity*n*(n - 1)/2), between frames it flies
+// straight and it never strays more than gravity/8 from the parabola, so a shot that can hit is never discarded
+static bool CheckShotReach(int shooter, rf_vec2 speed)
+{
+    float gravity = GRAVITY / DELTA_FPS;
+    rf_vec2 start = player[shooter].position;
+
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        if (!player[i].isAlive || (player[i].isLeftTeam == player[shooter].isLeftTeam)) continue;
+
+        float reachX = player[i].size.x / 2 + ball.radius + AI_REACH_MARGIN;
+        float reachY = player[i].size.y / 2 + ball.radius + AI_REACH_MARGIN;
+
+        // Frames the ball is within reach horizontally
+        float n0 = (player[i].position.x - reachX - start.x) / speed.x;
+        float n1 = (player[i].position.x + reachX - start.x) / speed.x;
+
+        if (n0 > n1)
+        {
+            float n = n0;
+            n0 = n1;
+            n1 = n;
         }
+
+        if (n1 < 0) continue;
+        if (n0 < 0) n0 = 0;
+
+        // Heights of the ball over those frames, the top is at the vertex if it's in between
+        float y0 = start.y + speed.y * n0 + gravity * n0 * (n0 - 1) / 2;
+        float y1 = start.y + speed.y * n1 + gravity * n1 * (n1 - 1) / 2;
+        float top = fminf(y0, y1);
+        float bottom = fmaxf(y0, y1);
+
+        float vertex = 0.5f - speed.y / gravity;
+        if ((vertex > n0) && (vertex < n1)) top = start.y + speed.y * vertex + gravity * vertex * (vertex - 1) / 2;
+
+        if ((bottom >= player[i].position.y - reachY) && (top <= player[i].position.y + reachY)) return true;
     }
 
     return false;
+}
+
+// NOTE: Runs on the job system threads, MoveBall only reads the game state and every job writes its own shot
+static void SimulateShotJob(void* data, rf_int index)
+{
+    ShotSearch* search = (ShotSearch*)data;
+    Shot* shot = &search->shots[index];
+
+    rf_vec2 position = player[search->shooter].position;
+    rf_vec2 speed = GetBallSpeed(search->shooter, shot->angle, shot->power);
+    BallHit hit = BALL_FLYING;
+    int hitPlayer = 0;
+
+    for (shot->frames = 0; (hit == BALL_FLYING) && (shot->frames < AI_MAX_FRAMES); shot->frames++)
+    {
+        hit = MoveBall(&position, &speed, ball.radius, search->shooter, &hitPlayer);
+    }
+
+    shot->hit = (hit == BALL_PLAYER) && (player[hitPlayer].isLeftTeam != player[search->shooter].isLeftTeam);
+    shot->distance = FLT_MAX;
+
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        if (player[i].isAlive && (player[i].isLeftTeam != player[search->shooter].isLeftTeam))
+        {
+            shot->distance = fminf(shot->distance, hypotf(position.x - player[i].position.x, position.y - player[i].position.y));
+        }
+    }
+}
+
+// Keep the shots whose parabola can reach the other team, only those are flown
+static void InitShotSearch(int shooter)
+{
+    aiShotsCount = 0;
+    aiNextShot = 0;
+    aiTurnTime = 0;
+    aiSearching = true;
+
+    // Fired if no shot can reach
+    aiBestShot = (Shot){ 45, (AI_MIN_POWER + AI_MAX_POWER) / 2, false, FLT_MAX, 0 };
+
+    for (int angle = 0; angle <= AI_MAX_ANGLE; angle++)
+    {
+        for (int power = AI_MIN_POWER; power <= AI_MAX_POWER; power++)
+        {
+            if (CheckShotReach(shooter, GetBallSpeed(shooter, angle, power))) aiShots[aiShotsCount++] = (Shot){ .angle = angle, .power = power };
+        }
+    }
+}
+
+// Fly the reaching shots until one hits, or fire the one stopping closest to the other team when they run out or the turn is over
+static bool UpdateAI(int playerTurn)
+{
+    if (!aiSearching) InitShotSearch(playerTurn);
+
+    uint64_t start = stm_now();
+
+    // Use the job system set on the context, same as rayfork does
+    rf_job_system jobs = ctx.job_system.parallel_for_proc? ctx.job_system : RF_DEFAULT_JOB_SYSTEM;
+
+    while (!aiBestShot.hit && (aiNextShot < aiShotsCount) && (stm_sec(stm_since(start)) < AI_FRAME_TIME))
+    {
+        ShotSearch search = { playerTurn, &aiShots[aiNextShot] };
+        int count = MinInt(AI_SHOT_BATCH, aiShotsCount - aiNextShot);
+
+        jobs.parallel_for_proc(jobs.user_data, SimulateShotJob, &search, count);
+
+        // Pick the first best shot so the result doesn't depend on the job order
+        for (int i = 0; i < count; i++)
+        {
+            Shot* shot = &search.shots[i];
+
+            if (!aiBestShot.hit && (shot->hit || (shot->distance < aiBestShot.distance))) aiBestShot = *shot;
+
+            soakBallFrames += shot->frames;
+        }
+
+        aiNextShot += count;
+        soakTrajectories += count;
+    }
+
+    double elapsed = stm_sec(stm_since(start));
+    aiTurnTime += elapsed;
+    soakSearchTime += elapsed;
+
+    // Aim with the best shot so far
+    Player* ai = &player[playerTurn];
+    ai->aimingAngle = aiBestShot.angle;
+    ai->aimingPower = aiBestShot.power;
+    ai->aimingPoint.x = ai->position.x + (ai->isLeftTeam? 1 : -1) * cosf(aiBestShot.angle * RF_DEG2RAD) * aiBestShot.power;
+    ai->aimingPoint.y = ai->position.y - sinf(aiBestShot.angle * RF_DEG2RAD) * aiBestShot.power;
+
+    if (!aiBestShot.hit && (aiNextShot < aiShotsCount) && (aiTurnTime < AI_TURN_TIME)) return false;
+
+    // Ball fired
+    ai->previousPoint = ai->aimingPoint;
+    ai->previousPower = ai->aimingPower;
+    ai->previousAngle = ai->aimingAngle;
+    ball.position = ai->position;
+
+    aiSearching = false;
+    soakShots++;
+
+    return true;
+}
+
+static void InitSoak(void)
+{
+    soakGames = 0;
+    soakShots = 0;
+    soakTrajectories = 0;
+    soakBallFrames = 0;
+    soakSearchTime = 0;
+}
+
+static void UpdateSoak(void)
+{
+    uint64_t start = stm_now();
+
+    do
+    {
+        if (gameOver)
+        {
+            InitGame();
+            gameOver = false;
+            soakGames++;
+        }
+        else if (!ballOnAir) ballOnAir = UpdateAI(playerTurn);
+        else if (UpdateBall(playerTurn)) EndTurn();
+    }
+    while (stm_sec(stm_since(start)) < SOAK_FRAME_TIME);
 }
\ No newline at end of file
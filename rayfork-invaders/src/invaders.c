@@ -17,10 +17,20 @@
 // Some Defines
 //----------------------------------------------------------------------------------
 #define NUM_SHOOTS 50
-#define NUM_MAX_ENEMIES 50
-#define FIRST_WAVE 10
-#define SECOND_WAVE 20
-#define THIRD_WAVE 50
+
+// Multiplies the enemies of every wave, can be defined when building to stress test with big waves
+#ifndef WAVES_SCALE
+#define WAVES_SCALE 1
+#endif
+
+#define FIRST_WAVE (10*WAVES_SCALE)
+#define SECOND_WAVE (20*WAVES_SCALE)
+#define THIRD_WAVE (50*WAVES_SCALE)
+#define NUM_MAX_ENEMIES THIRD_WAVE
+
+// Enemies spawn past the right border of the screen, up to this distance
+#define ENEMIES_SPAWN_DISTANCE 1000
+#define ENEMIES_GRID_CELL 64.0f
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -36,14 +46,12 @@ typedef struct Player {
 typedef struct Enemy {
     rf_rec rec;
     rf_vec2 speed;
-    bool active;
     rf_color color;
 } Enemy;
 
 typedef struct Shoot {
     rf_rec rec;
     rf_vec2 speed;
-    bool active;
     rf_color color;
 } Shoot;
 
@@ -56,8 +64,9 @@ static int score = 0;
 static bool victory = false;
 
 static Player player = { 0 };
-static Enemy enemy[NUM_MAX_ENEMIES] = { 0 };
-static Shoot shoot[NUM_SHOOTS] = { 0 };
+static Enemy enemy[NUM_MAX_ENEMIES] = { 0 };    // Enemies of the current wave are the first activeEnemies
+static Shoot shoot[NUM_SHOOTS] = { 0 };         // Flying shoots are the first shootsCount
+static int shootsCount = 0;
 static EnemyWave wave = { 0 };
 
 static int shootRate = 0;
@@ -67,6 +76,11 @@ static int activeEnemies = 0;
 static int enemiesKill = 0;
 static bool smooth = false;
 
+// Broadphase of the active enemies, the entities are the enemy indices
+static rf_spatial_grid enemyGrid = { 0 };
+static rf_rec enemyRecs[NUM_MAX_ENEMIES] = { 0 };
+static int enemyCandidates[NUM_MAX_ENEMIES] = { 0 };
+
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
 //------------------------------------------------------------------------------------
@@ -76,6 +90,9 @@ static void DrawGame(void);                                      // Draw game (o
 static void UnloadGame(void);                                    // Unload game
 static void UpdateDrawFrame(const platform_input_state* input);  // Update and Draw (one frame)
 
+// Additional module functions
+static void UpdateEnemyGrid(void);
+
 // Formatting of text with variables to 'embed'
 // WARNING: String returned will expire after this function is called MAX_TEXTFORMAT_BUFFERS times
 #define MAX_TEXT_BUFFER_LENGTH              1024        // Size of internal static buffers used on some functions:
@@ -142,6 +159,9 @@ extern void game_init(rf_gfx_backend_data* gfx_data)
     batch = rf_create_default_render_batch(RF_DEFAULT_ALLOCATOR);
     rf_set_active_render_batch(&batch);
 
+    // The grid also covers the spawn area, otherwise the enemies waiting there would all share the border cells
+    enemyGrid = rf_load_spatial_grid((rf_rec){ 0, 0, window.width + ENEMIES_SPAWN_DISTANCE + ENEMIES_GRID_CELL, window.height }, ENEMIES_GRID_CELL, NUM_MAX_ENEMIES, RF_DEFAULT_ALLOCATOR);
+
     InitGame();
 }
 
@@ -183,15 +203,16 @@ void InitGame(void)
     {
         enemy[i].rec.width = 10;
         enemy[i].rec.height = 10;
-        enemy[i].rec.x = GetRandomValue(window.width, window.width + 1000);
+        enemy[i].rec.x = GetRandomValue(window.width, window.width + ENEMIES_SPAWN_DISTANCE);
         enemy[i].rec.y = GetRandomValue(0, window.height - enemy[i].rec.height);
         enemy[i].speed.x = 5;
         enemy[i].speed.y = 5;
-        enemy[i].active = true;
         enemy[i].color = RF_GRAY;
     }
 
     // Initialize shoots
+    shootsCount = 0;
+
     for (int i = 0; i < NUM_SHOOTS; i++)
     {
         shoot[i].rec.x = player.rec.x;
@@ -200,7 +221,6 @@ void InitGame(void)
         shoot[i].rec.height = 5;
         shoot[i].speed.x = 7;
         shoot[i].speed.y = 0;
-        shoot[i].active = false;
         shoot[i].color = RF_MAROON;
     }
 }
@@ -230,12 +250,6 @@ void UpdateGame(const platform_input_state* input)
                 if (enemiesKill == activeEnemies)
                 {
                     enemiesKill = 0;
-
-                    for (int i = 0; i < activeEnemies; i++)
-                    {
-                        if (!enemy[i].active) enemy[i].active = true;
-                    }
-
                     activeEnemies = SECOND_WAVE;
                     wave = SECOND;
                     smooth = false;
@@ -256,12 +270,6 @@ void UpdateGame(const platform_input_state* input)
                 if (enemiesKill == activeEnemies)
                 {
                     enemiesKill = 0;
-
-                    for (int i = 0; i < activeEnemies; i++)
-                    {
-                        if (!enemy[i].active) enemy[i].active = true;
-                    }
-
                     activeEnemies = THIRD_WAVE;
                     wave = THIRD;
                     smooth = false;
@@ -292,23 +300,25 @@ void UpdateGame(const platform_input_state* input)
             if (input->keys[KEYCODE_DOWN] == KEY_HOLD_DOWN) player.rec.y += player.speed.y;
 
             // Player collision with enemy
+            // NOTE: A single rec is checked faster against all the enemies than the grid can be rebuilt for it
             for (int i = 0; i < activeEnemies; i++)
             {
-                if (rf_check_collision_recs(player.rec, enemy[i].rec)) gameOver = true;
+                if (rf_check_collision_recs(player.rec, enemy[i].rec))
+                {
+                    gameOver = true;
+                    break;
+                }
             }
 
             // Enemy behaviour
             for (int i = 0; i < activeEnemies; i++)
             {
-                if (enemy[i].active)
-                {
-                    enemy[i].rec.x -= enemy[i].speed.x;
+                enemy[i].rec.x -= enemy[i].speed.x;
 
-                    if (enemy[i].rec.x < 0)
-                    {
-                        enemy[i].rec.x = GetRandomValue(window.width, window.width + 1000);
-                        enemy[i].rec.y = GetRandomValue(0, window.height - enemy[i].rec.height);
-                    }
+                if (enemy[i].rec.x < 0)
+                {
+                    enemy[i].rec.x = GetRandomValue(window.width, window.width + ENEMIES_SPAWN_DISTANCE);
+                    enemy[i].rec.y = GetRandomValue(0, window.height - enemy[i].rec.height);
                 }
             }
 
@@ -323,49 +333,52 @@ void UpdateGame(const platform_input_state* input)
             {
                 shootRate += 5;
 
-                for (int i = 0; i < NUM_SHOOTS; i++)
+                if (shootsCount < NUM_SHOOTS && shootRate % 20 == 0)
                 {
-                    if (!shoot[i].active && shootRate % 20 == 0)
-                    {
-                        shoot[i].rec.x = player.rec.x;
-                        shoot[i].rec.y = player.rec.y + player.rec.height / 4;
-                        shoot[i].active = true;
-                        break;
-                    }
+                    shoot[shootsCount].rec.x = player.rec.x;
+                    shoot[shootsCount].rec.y = player.rec.y + player.rec.height / 4;
+                    shootsCount++;
                 }
             }
 
             // Shoot logic
-            for (int i = 0; i < NUM_SHOOTS; i++)
+            UpdateEnemyGrid();
+
+            for (int i = 0; i < shootsCount;)
             {
-                if (shoot[i].active)
+                bool active = true;
+
+                // Movement
+                shoot[i].rec.x += shoot[i].speed.x;
+
+                // Collision with enemy
+                // NOTE: Enemies hit by a previous shoot keep their old rec in the grid, so the collision is checked with the current one
+                int candidatesCount = rf_spatial_grid_query(&enemyGrid, shoot[i].rec, enemyCandidates, NUM_MAX_ENEMIES);
+
+                for (int k = 0; k < candidatesCount; k++)
                 {
-                    // Movement
-                    shoot[i].rec.x += shoot[i].speed.x;
+                    int j = enemyCandidates[k];
 
-                    // Collision with enemy
-                    for (int j = 0; j < activeEnemies; j++)
+                    if (rf_check_collision_recs(shoot[i].rec, enemy[j].rec))
                     {
-                        if (enemy[j].active)
-                        {
-                            if (rf_check_collision_recs(shoot[i].rec, enemy[j].rec))
-                            {
-                                shoot[i].active = false;
-                                enemy[j].rec.x = GetRandomValue(window.width, window.width + 1000);
-                                enemy[j].rec.y = GetRandomValue(0, window.height - enemy[j].rec.height);
-                                shootRate = 0;
-                                enemiesKill++;
-                                score += 100;
-                            }
-
-                            if (shoot[i].rec.x + shoot[i].rec.width >= window.width)
-                            {
-                                shoot[i].active = false;
-                                shootRate = 0;
-                            }
-                        }
+                        active = false;
+                        enemy[j].rec.x = GetRandomValue(window.width, window.width + ENEMIES_SPAWN_DISTANCE);
+                        enemy[j].rec.y = GetRandomValue(0, window.height - enemy[j].rec.height);
+                        shootRate = 0;
+                        enemiesKill++;
+                        score += 100;
                     }
                 }
+
+                if (shoot[i].rec.x + shoot[i].rec.width >= window.width)
+                {
+                    active = false;
+                    shootRate = 0;
+                }
+
+                // The last shoot takes the place of a finished one and is updated next
+                if (active) i++;
+                else shoot[i] = shoot[--shootsCount];
             }
         }
     }
@@ -394,15 +407,13 @@ void DrawGame(void)
             else if (wave == SECOND) rf_draw_text("SECOND WAVE", window.width / 2 - rf_measure_text(rf_get_default_font(), "SECOND WAVE", 40, 0.0f).width / 2, window.height / 2 - 40, 40, rf_fade(RF_BLACK, alpha));
             else if (wave == THIRD) rf_draw_text("THIRD WAVE", window.width / 2 - rf_measure_text(rf_get_default_font(), "THIRD WAVE", 40, 0.0f).width / 2, window.height / 2 - 40, 40, rf_fade(RF_BLACK, alpha));
 
+            // Enemies waiting in the spawn area are not visible yet
             for (int i = 0; i < activeEnemies; i++)
             {
-                if (enemy[i].active) rf_draw_rectangle_rec(enemy[i].rec, enemy[i].color);
+                if (enemy[i].rec.x < window.width) rf_draw_rectangle_rec(enemy[i].rec, enemy[i].color);
             }
 
-            for (int i = 0; i < NUM_SHOOTS; i++)
-            {
-                if (shoot[i].active) rf_draw_rectangle_rec(shoot[i].rec, shoot[i].color);
-            }
+            for (int i = 0; i < shootsCount; i++) rf_draw_rectangle_rec(shoot[i].rec, shoot[i].color);
 
             rf_draw_text(TextFormat("%04i", score), 20, 20, 40, RF_GRAY);
 
@@ -419,6 +430,15 @@ void DrawGame(void)
 void UnloadGame(void)
 {
     // TODO: Unload all dynamic loaded data (textures, sounds, models...)
+    rf_unload_spatial_grid(enemyGrid);
+}
+
+// Rebuild the enemies broadphase from the active enemies
+void UpdateEnemyGrid(void)
+{
+    for (int i = 0; i < activeEnemies; i++) enemyRecs[i] = enemy[i].rec;
+
+    rf_spatial_grid_build(&enemyGrid, enemyRecs, activeEnemies);
 }
 
 // Update and Draw (one frame)
@@ -116,6 +116,45 @@ RF_API bool rf_libc_load_file_into_buffer(void* user_data, const char* filename,
     return result;
 }
 
+RF_API void* rf_libc_open_file(void* user_data, const char* filename)
+{
+    ((void)user_data);
+
+    return fopen(filename, "rb");
+}
+
+RF_API rf_int rf_libc_read_stream(void* user_data, void* file, void* dst, rf_int dst_size)
+{
+    ((void)user_data);
+
+    return fread(dst, 1, dst_size, file);
+}
+
+RF_API void rf_libc_skip_stream(void* user_data, void* file, rf_int amount)
+{
+    ((void)user_data);
+
+    fseek(file, amount, SEEK_CUR);
+
+    // fseek doesn't set the eof indicator so peek one byte to find out if we skipped past the end
+    int c = fgetc(file);
+    if (c != EOF) ungetc(c, file);
+}
+
+RF_API bool rf_libc_stream_eof(void* user_data, void* file)
+{
+    ((void)user_data);
+
+    return feof((FILE*) file) || ferror((FILE*) file);
+}
+
+RF_API void rf_libc_close_file(void* user_data, void* file)
+{
+    ((void)user_data);
+
+    fclose(file);
+}
+
 #pragma endregion
 
 #pragma region internal utils
@@ -181,12 +220,85 @@ RF_INTERNAL const char* rf_get_directory_path_from_file_path(const char* file_pa
 
 RF_INTERNAL inline int rf_min_i(int a, int b) { return ((a) < (b) ? (a) : (b)); }
 RF_INTERNAL inline int rf_max_i(int a, int b) { return ((a) > (b) ? (a) : (b)); }
+RF_INTERNAL inline int rf_clamp_i(int v, int lo, int hi) { return v < lo ? lo : (v > hi ? hi : v); }
 
 RF_INTERNAL inline int rf_min_f(float a, float b) { return ((a) < (b) ? (a) : (b)); }
 RF_INTERNAL inline int rf_max_f(float a, float b) { return ((a) > (b) ? (a) : (b)); }
 
 #pragma endregion
 
+#pragma region simd
+
+/*
+ SSE2 and NEON are part of the baseline of the platforms that have them so they are used whenever the compiler targets them.
+ AVX2 is not, so AVX2 kernels are compiled with a per-function target attribute and only called after checking the cpu at runtime.
+ Define RF_NO_SIMD to compile only the scalar code paths.
+*/
+#if !defined(RF_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define RF_SIMD_SSE2
+        #include <emmintrin.h>
+
+        #if defined(RAYFORK_MSVC) || defined(RAYFORK_CLANG) || (defined(RAYFORK_GNUC) && __GNUC__ >= 5)
+            #define RF_SIMD_AVX2
+            #include <immintrin.h>
+        #endif
+    #endif
+
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+        #define RF_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined(RF_SIMD_AVX2) && !defined(RAYFORK_MSVC)
+    #define RF_AVX2_FUNC __attribute__((target("avx2")))
+#else
+    #define RF_AVX2_FUNC
+#endif
+
+#if defined(RF_SIMD_AVX2) && defined(RAYFORK_MSVC)
+    #include <intrin.h>
+#endif
+
+RF_INTERNAL bool rf_cpu_supports_avx2(void)
+{
+    #if defined(RF_SIMD_AVX2)
+        // Computing this more than once when racing from multiple threads is harmless since the result is always the same
+        static int supported = -1;
+
+        if (supported == -1)
+        {
+            #if defined(RAYFORK_MSVC)
+                int info[4] = {0};
+                __cpuid(info, 0);
+                int max_leaf = info[0];
+
+                __cpuid(info, 1);
+                bool os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+
+                bool has_avx2 = false;
+                if (max_leaf >= 7)
+                {
+                    __cpuidex(info, 7, 0);
+                    has_avx2 = (info[1] & (1 << 5)) != 0;
+                }
+
+                supported = os_saves_ymm && has_avx2;
+            #else
+                __builtin_cpu_init();
+                supported = __builtin_cpu_supports("avx2") != 0;
+            #endif
+        }
+
+        return supported;
+    #else
+        return false;
+    #endif
+}
+
+#pragma endregion
+
 #pragma region logger
 
 #define RF_RECORDED_ERROR(error_type) (RF_LIT(rf_recorded_error) { RF_SOURCE_LOCATION, error_type })
@@ -246,6 +358,338 @@ RF_API void rf_libc_printf_logger(struct rf_logger* logger, rf_source_location s
     printf("\n");
 }
 
+#pragma endregion
+
+#pragma region job system
+
+RF_API void rf_serial_parallel_for(void* user_data, rf_job_proc job_proc, void* job_data, rf_int job_count)
+{
+    ((void)user_data); // unused
+
+    for (rf_int i = 0; i < job_count; i++)
+    {
+        job_proc(job_data, i);
+    }
+}
+
+#if defined(RAYFORK_ENABLE_THREADS)
+
+#if defined(RAYFORK_PLATFORM_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+#ifndef RF_MAX_JOB_THREADS
+    #define RF_MAX_JOB_THREADS (64)
+#endif
+
+typedef struct rf_threads_job_batch
+{
+    rf_job_proc     job_proc;
+    void*           job_data;
+    rf_int          job_count;
+    volatile rf_int next_job;
+    rf_int          max_workers; // Pool workers past this amount skip the batch
+    volatile rf_int workers;     // Pool workers that picked up the batch so far
+} rf_threads_job_batch;
+
+RF_INTERNAL rf_int rf_atomic_fetch_add(volatile rf_int* value, rf_int amount)
+{
+    #if defined(RAYFORK_MSVC) && defined(_WIN64)
+        return InterlockedExchangeAdd64((volatile LONG64*) value, amount);
+    #elif defined(RAYFORK_MSVC)
+        return InterlockedExchangeAdd((volatile LONG*) value, amount);
+    #else
+        return __sync_fetch_and_add(value, amount);
+    #endif
+}
+
+// Every thread, including the calling one, takes the next job index until none are left
+RF_INTERNAL void rf_threads_run_jobs(rf_threads_job_batch* batch)
+{
+    for (rf_int i = rf_atomic_fetch_add(&batch->next_job, 1); i < batch->job_count; i = rf_atomic_fetch_add(&batch->next_job, 1))
+    {
+        batch->job_proc(batch->job_data, i);
+    }
+}
+
+#if defined(RAYFORK_PLATFORM_WINDOWS)
+typedef HANDLE             rf_thread;
+typedef SRWLOCK            rf_mutex;
+typedef CONDITION_VARIABLE rf_condition;
+
+#define RF_MUTEX_INIT     SRWLOCK_INIT
+#define RF_CONDITION_INIT CONDITION_VARIABLE_INIT
+
+RF_INTERNAL bool rf_mutex_try_lock(rf_mutex* mutex)                      { return TryAcquireSRWLockExclusive(mutex) != 0; }
+RF_INTERNAL void rf_mutex_lock(rf_mutex* mutex)                          { AcquireSRWLockExclusive(mutex); }
+RF_INTERNAL void rf_mutex_unlock(rf_mutex* mutex)                        { ReleaseSRWLockExclusive(mutex); }
+RF_INTERNAL void rf_condition_wait(rf_condition* cond, rf_mutex* mutex) { SleepConditionVariableSRW(cond, mutex, INFINITE, 0); }
+RF_INTERNAL void rf_condition_signal(rf_condition* cond)                { WakeConditionVariable(cond); }
+RF_INTERNAL void rf_condition_broadcast(rf_condition* cond)             { WakeAllConditionVariable(cond); }
+
+RF_INTERNAL bool rf_thread_start(rf_thread* thread, LPTHREAD_START_ROUTINE entry, void* arg)
+{
+    *thread = CreateThread(NULL, 0, entry, arg, 0, NULL);
+    return *thread != NULL;
+}
+
+RF_INTERNAL void rf_thread_join(rf_thread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+RF_INTERNAL int rf_threads_core_count()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int) info.dwNumberOfProcessors;
+}
+#else
+typedef pthread_t       rf_thread;
+typedef pthread_mutex_t rf_mutex;
+typedef pthread_cond_t  rf_condition;
+
+#define RF_MUTEX_INIT     PTHREAD_MUTEX_INITIALIZER
+#define RF_CONDITION_INIT PTHREAD_COND_INITIALIZER
+
+RF_INTERNAL bool rf_mutex_try_lock(rf_mutex* mutex)                      { return pthread_mutex_trylock(mutex) == 0; }
+RF_INTERNAL void rf_mutex_lock(rf_mutex* mutex)                          { pthread_mutex_lock(mutex); }
+RF_INTERNAL void rf_mutex_unlock(rf_mutex* mutex)                        { pthread_mutex_unlock(mutex); }
+RF_INTERNAL void rf_condition_wait(rf_condition* cond, rf_mutex* mutex) { pthread_cond_wait(cond, mutex); }
+RF_INTERNAL void rf_condition_signal(rf_condition* cond)                { pthread_cond_signal(cond); }
+RF_INTERNAL void rf_condition_broadcast(rf_condition* cond)             { pthread_cond_broadcast(cond); }
+
+RF_INTERNAL bool rf_thread_start(rf_thread* thread, void* (*entry)(void*), void* arg)
+{
+    return pthread_create(thread, NULL, entry, arg) == 0;
+}
+
+RF_INTERNAL void rf_thread_join(rf_thread thread)
+{
+    pthread_join(thread, NULL);
+}
+
+RF_INTERNAL int rf_threads_core_count()
+{
+    return (int) sysconf(_SC_NPROCESSORS_ONLN);
+}
+#endif
+
+/*
+ * Worker threads started on the first rf_threads_parallel_for and kept until rf_threads_shutdown.
+ * Between batches the workers sleep on batch_ready, a batch wakes all of them and they take jobs from its shared counter.
+ * The submitting thread works on the batch too and waits on batch_done until no worker holds the batch anymore.
+ */
+typedef struct rf_threads_pool
+{
+    rf_mutex              submit_lock;  // Held by the thread running a batch on the pool
+    rf_mutex              lock;         // Guards the fields below
+    rf_condition          batch_ready;
+    rf_condition          batch_done;
+    rf_threads_job_batch* batch;
+    rf_int                batch_id;     // Bumped for every batch so a waking worker knows whether there is a new one
+    rf_int                busy_workers; // Workers that can still read the current batch
+    bool                  stop;
+    bool                  started;
+    rf_int                worker_count;
+    rf_thread             workers[RF_MAX_JOB_THREADS];
+} rf_threads_pool;
+
+RF_INTERNAL rf_threads_pool rf_threads_global_pool =
+{
+    .submit_lock = RF_MUTEX_INIT,
+    .lock        = RF_MUTEX_INIT,
+    .batch_ready = RF_CONDITION_INIT,
+    .batch_done  = RF_CONDITION_INIT,
+};
+
+RF_INTERNAL void rf_threads_pool_work(rf_threads_pool* pool)
+{
+    rf_mutex_lock(&pool->lock);
+
+    // Workers are only started while batch_id is 0, so the first batch is never missed
+    rf_int seen_batch = 0;
+
+    while (true)
+    {
+        while (!pool->stop && pool->batch_id == seen_batch) rf_condition_wait(&pool->batch_ready, &pool->lock);
+        if (pool->stop) break;
+
+        rf_threads_job_batch* batch = pool->batch;
+        seen_batch = pool->batch_id;
+        rf_mutex_unlock(&pool->lock);
+
+        // Workers past max_workers leave the jobs to the others, so user_data can limit the threads of a call
+        if (rf_atomic_fetch_add(&batch->workers, 1) < batch->max_workers) rf_threads_run_jobs(batch);
+
+        rf_mutex_lock(&pool->lock);
+        if (--pool->busy_workers == 0) rf_condition_signal(&pool->batch_done);
+    }
+
+    rf_mutex_unlock(&pool->lock);
+}
+
+#if defined(RAYFORK_PLATFORM_WINDOWS)
+RF_INTERNAL DWORD WINAPI rf_threads_pool_entry(LPVOID pool)
+{
+    rf_threads_pool_work((rf_threads_pool*) pool);
+    return 0;
+}
+
+RF_INTERNAL DWORD WINAPI rf_threads_spawn_entry(LPVOID batch)
+{
+    rf_threads_run_jobs((rf_threads_job_batch*) batch);
+    return 0;
+}
+#else
+RF_INTERNAL void* rf_threads_pool_entry(void* pool)
+{
+    rf_threads_pool_work((rf_threads_pool*) pool);
+    return NULL;
+}
+
+RF_INTERNAL void* rf_threads_spawn_entry(void* batch)
+{
+    rf_threads_run_jobs((rf_threads_job_batch*) batch);
+    return NULL;
+}
+#endif
+
+// Must be called with the submit lock held, one worker per core besides the submitting thread
+RF_INTERNAL void rf_threads_start_pool(rf_threads_pool* pool)
+{
+    rf_int worker_count = rf_threads_core_count() - 1;
+    if (worker_count > RF_MAX_JOB_THREADS) worker_count = RF_MAX_JOB_THREADS;
+
+    pool->batch = NULL;
+    pool->batch_id = 0;
+    pool->busy_workers = 0;
+    pool->stop = false;
+    pool->worker_count = 0;
+
+    // If a thread fails to start the pool simply runs with fewer workers
+    for (rf_int i = 0; i < worker_count; i++)
+    {
+        if (rf_thread_start(&pool->workers[pool->worker_count], rf_threads_pool_entry, pool)) pool->worker_count++;
+    }
+
+    pool->started = true;
+}
+
+RF_API void rf_threads_parallel_for(void* user_data, rf_job_proc job_proc, void* job_data, rf_int job_count)
+{
+    rf_threads_pool* pool = &rf_threads_global_pool;
+    rf_threads_job_batch batch = { job_proc, job_data, job_count, 0, 0, 0 };
+
+    // Jobs that call back into the pool, or other threads using it at the same time, run their jobs on the calling thread
+    if (!rf_mutex_try_lock(&pool->submit_lock))
+    {
+        rf_threads_run_jobs(&batch);
+        return;
+    }
+
+    if (!pool->started) rf_threads_start_pool(pool);
+
+    // The calling thread works too so only thread_count - 1 workers take jobs
+    rf_int thread_count = user_data ? *((int*) user_data) : pool->worker_count + 1;
+    batch.max_workers = thread_count - 1;
+    if (batch.max_workers > job_count - 1) batch.max_workers = job_count - 1;
+
+    if (batch.max_workers > 0 && pool->worker_count > 0)
+    {
+        rf_mutex_lock(&pool->lock);
+        pool->batch = &batch;
+        pool->busy_workers = pool->worker_count;
+        pool->batch_id++;
+        rf_condition_broadcast(&pool->batch_ready);
+        rf_mutex_unlock(&pool->lock);
+
+        rf_threads_run_jobs(&batch);
+
+        // The batch lives on this stack so every worker has to be done with it before returning
+        rf_mutex_lock(&pool->lock);
+        while (pool->busy_workers > 0) rf_condition_wait(&pool->batch_done, &pool->lock);
+        rf_mutex_unlock(&pool->lock);
+    }
+    else rf_threads_run_jobs(&batch);
+
+    rf_mutex_unlock(&pool->submit_lock);
+}
+
+RF_API int rf_threads_count(void)
+{
+    rf_threads_pool* pool = &rf_threads_global_pool;
+
+    // If the lock is taken a batch is running, so the pool is already started and its worker count doesn't change
+    if (rf_mutex_try_lock(&pool->submit_lock))
+    {
+        if (!pool->started) rf_threads_start_pool(pool);
+        rf_mutex_unlock(&pool->submit_lock);
+    }
+
+    return (int) pool->worker_count + 1;
+}
+
+RF_API void rf_threads_shutdown(void)
+{
+    rf_threads_pool* pool = &rf_threads_global_pool;
+
+    rf_mutex_lock(&pool->submit_lock);
+
+    if (pool->started)
+    {
+        rf_mutex_lock(&pool->lock);
+        pool->stop = true;
+        rf_condition_broadcast(&pool->batch_ready);
+        rf_mutex_unlock(&pool->lock);
+
+        for (rf_int i = 0; i < pool->worker_count; i++) rf_thread_join(pool->workers[i]);
+
+        pool->worker_count = 0;
+        pool->started = false;
+    }
+
+    rf_mutex_unlock(&pool->submit_lock);
+}
+
+// Fallback that starts its own threads on every call and joins them before returning, nothing is kept between calls
+RF_API void rf_threads_spawn_parallel_for(void* user_data, rf_job_proc job_proc, void* job_data, rf_int job_count)
+{
+    rf_threads_job_batch batch = { job_proc, job_data, job_count, 0, 0, 0 };
+
+    rf_int thread_count = user_data ? *((int*) user_data) : rf_threads_core_count();
+
+    // The calling thread works too so it only needs to spawn thread_count - 1 workers
+    rf_int worker_count = thread_count - 1;
+    if (worker_count > job_count - 1)      worker_count = job_count - 1;
+    if (worker_count > RF_MAX_JOB_THREADS) worker_count = RF_MAX_JOB_THREADS;
+
+    rf_thread workers[RF_MAX_JOB_THREADS];
+
+    // If a thread fails to start the remaining jobs are simply picked up by the others
+    rf_int started = 0;
+    for (rf_int i = 0; i < worker_count; i++)
+    {
+        if (rf_thread_start(&workers[started], rf_threads_spawn_entry, &batch)) started++;
+    }
+
+    rf_threads_run_jobs(&batch);
+
+    for (rf_int i = 0; i < started; i++) rf_thread_join(workers[i]);
+}
+
+#endif
+
 #pragma endregion
 /*** End of inlined file: rayfork-std.c ***/
 
@@ -569,6 +1013,26 @@ RF_API void rf_set_logger_filter(rf_log_type filter)
     rf_ctx.logger_filter = filter;
 }
 
+RF_API void rf_set_job_system(rf_job_system job_system)
+{
+    rf_ctx.job_system = job_system;
+}
+
+// Runs job_proc for every index in [0, job_count) on the job system of the context
+RF_INTERNAL void rf_parallel_for(rf_job_proc job_proc, void* job_data, rf_int job_count)
+{
+    rf_job_system job_system = (rf__ctx && rf_ctx.job_system.parallel_for_proc) ? rf_ctx.job_system : RF_DEFAULT_JOB_SYSTEM;
+
+    if (job_count > 1)
+    {
+        job_system.parallel_for_proc(job_system.user_data, job_proc, job_data, job_count);
+    }
+    else if (job_count == 1)
+    {
+        job_proc(job_data, 0);
+    }
+}
+
 RF_API inline rf_int rf_libc_rand_wrapper(rf_int min, rf_int max)
 {
     return rand() % (max + 1 - min) + min;
@@ -669,286 +1133,675 @@ RF_API int rf_bytes_per_pixel(rf_uncompressed_pixel_format format)
 
 RF_API int rf_pixel_buffer_size(int width, int height, rf_pixel_format format)
 {
+    // Formats made of 4x4 blocks store whole blocks, so partial blocks on the edges round up
+    if ((format >= RF_COMPRESSED_DXT1_RGB && format <= RF_COMPRESSED_ETC2_EAC_RGBA) || format == RF_COMPRESSED_ASTC_4x4_RGBA)
+    {
+        width  = (width  + 3) / 4 * 4;
+        height = (height + 3) / 4 * 4;
+    }
+
     return width * height * rf_bits_per_pixel(format) / 8;
 }
 
-RF_API bool rf_format_pixels_to_normalized(const void* src, rf_int src_size, rf_uncompressed_pixel_format src_format, rf_vec4* dst, rf_int dst_size)
+#pragma region pixel format kernels
+
+// Expand 5 and 6 bit channels to 8 bits by replicating the high bits into the low bits, like the gpu does
+RF_INTERNAL inline unsigned char rf_expand_5bit(unsigned int v) { return (unsigned char)((v << 3) | (v >> 2)); }
+RF_INTERNAL inline unsigned char rf_expand_6bit(unsigned int v) { return (unsigned char)((v << 2) | (v >> 4)); }
+RF_INTERNAL inline unsigned char rf_expand_4bit(unsigned int v) { return (unsigned char)((v << 4) | v); }
+
+// Computes round(v * levels / 255) for v in [0, 255] without a division, matches round(v / 255.0f * levels)
+RF_INTERNAL inline unsigned int rf_quantize_u8(unsigned int v, unsigned int levels)
 {
-    bool success = false;
+    unsigned int t = v * levels + 128;
+    return (t + (t >> 8)) >> 8;
+}
 
-    rf_int src_bpp = rf_bytes_per_pixel(src_format);
-    rf_int src_pixel_count = src_size / src_bpp;
-    rf_int dst_pixel_count = dst_size / sizeof(rf_vec4);
+#if defined(RF_SIMD_SSE2)
+// Takes 8 pixels worth of 16 bit channels in [0, 255] and interleaves them as rgba32
+RF_INTERNAL inline void rf_sse2_store_rgba32(unsigned char* dst, __m128i r, __m128i g, __m128i b, __m128i a)
+{
+    __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    __m128i ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));
+    _mm_storeu_si128((__m128i*)(dst +  0), _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(rg, ba));
+}
 
-    if (dst_pixel_count >= src_pixel_count)
+// Loads 8 rgba32 pixels and splits them into 16 bit channels
+RF_INTERNAL inline void rf_sse2_load_rgba32(const unsigned char* src, __m128i* r, __m128i* g, __m128i* b, __m128i* a)
+{
+    __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i p0 = _mm_loadu_si128((const __m128i*)(src +  0));
+    __m128i p1 = _mm_loadu_si128((const __m128i*)(src + 16));
+    *r = _mm_packs_epi32(_mm_and_si128(p0, mask), _mm_and_si128(p1, mask));
+    *g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), mask), _mm_and_si128(_mm_srli_epi32(p1, 8), mask));
+    *b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), mask), _mm_and_si128(_mm_srli_epi32(p1, 16), mask));
+    *a = _mm_packs_epi32(_mm_srli_epi32(p0, 24), _mm_srli_epi32(p1, 24));
+}
+
+RF_INTERNAL inline __m128i rf_sse2_quantize_u8(__m128i v, short levels)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(levels)), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+#endif
+
+#if defined(RF_SIMD_NEON)
+RF_INTERNAL inline uint16x8_t rf_neon_quantize_u8(uint16x8_t v, uint16_t levels)
+{
+    uint16x8_t t = vmlaq_n_u16(vdupq_n_u16(128), v, levels);
+    return vshrq_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+}
+#endif
+
+RF_INTERNAL void rf_gray_to_rgba32(const unsigned char* src, unsigned char* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_SSE2)
+        __m128i alpha = _mm_set1_epi8((char)0xFF);
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i gray  = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i gg_lo = _mm_unpacklo_epi8(gray, gray);
+            __m128i gg_hi = _mm_unpackhi_epi8(gray, gray);
+            __m128i ga_lo = _mm_unpacklo_epi8(gray, alpha);
+            __m128i ga_hi = _mm_unpackhi_epi8(gray, alpha);
+            _mm_storeu_si128((__m128i*)(dst + i * 4 +  0), _mm_unpacklo_epi16(gg_lo, ga_lo));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(gg_lo, ga_lo));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 32), _mm_unpacklo_epi16(gg_hi, ga_hi));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 48), _mm_unpackhi_epi16(gg_hi, ga_hi));
+        }
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t rgba;
+            rgba.val[0] = vld1q_u8(src + i);
+            rgba.val[1] = rgba.val[0];
+            rgba.val[2] = rgba.val[0];
+            rgba.val[3] = vdupq_n_u8(255);
+            vst4q_u8(dst + i * 4, rgba);
+        }
+    #endif
+
+    for (; i < count; i++)
     {
-        if (src_format == RF_UNCOMPRESSED_R32G32B32A32)
+        dst[i * 4 + 0] = src[i];
+        dst[i * 4 + 1] = src[i];
+        dst[i * 4 + 2] = src[i];
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+RF_INTERNAL void rf_gray_alpha_to_rgba32(const unsigned char* src, unsigned char* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
         {
-            success = true;
-            memcpy(dst, src, src_size);
+            __m128i ga   = _mm_loadu_si128((const __m128i*)(src + i * 2));
+            __m128i gray = _mm_and_si128(ga, _mm_set1_epi16(0xFF));
+            __m128i gg   = _mm_or_si128(gray, _mm_slli_epi16(gray, 8));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 +  0), _mm_unpacklo_epi16(gg, ga));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(gg, ga));
         }
-        else
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 16 <= count; i += 16)
         {
-            success = true;
+            uint8x16x2_t ga = vld2q_u8(src + i * 2);
+            uint8x16x4_t rgba;
+            rgba.val[0] = ga.val[0];
+            rgba.val[1] = ga.val[0];
+            rgba.val[2] = ga.val[0];
+            rgba.val[3] = ga.val[1];
+            vst4q_u8(dst + i * 4, rgba);
+        }
+    #endif
 
-            #define RF_FOR_EACH_PIXEL for (rf_int dst_iter = 0, src_iter = 0; src_iter < src_size && dst_iter < dst_size; dst_iter++, src_iter += src_bpp)
-            switch (src_format)
-            {
-                case RF_UNCOMPRESSED_GRAYSCALE:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        float value = ((unsigned char*)src)[src_iter] / 255.0f;
+    for (; i < count; i++)
+    {
+        dst[i * 4 + 0] = src[i * 2 + 0];
+        dst[i * 4 + 1] = src[i * 2 + 0];
+        dst[i * 4 + 2] = src[i * 2 + 0];
+        dst[i * 4 + 3] = src[i * 2 + 1];
+    }
+}
 
-                        dst[dst_iter].x = value;
-                        dst[dst_iter].y = value;
-                        dst[dst_iter].z = value;
-                        dst[dst_iter].w = 1.0f;
-                    }
-                    break;
+#if defined(RF_SIMD_AVX2)
+RF_INTERNAL RF_AVX2_FUNC rf_int rf_rgb888_to_rgba32_avx2(const unsigned char* src, unsigned char* dst, rf_int count)
+{
+    const __m256i spread  = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                             0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m256i alpha   = _mm256_set1_epi32((int)0xFF000000);
 
-                case RF_UNCOMPRESSED_GRAY_ALPHA:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        float value0 = (float)((unsigned char*)src)[src_iter + 0] / 255.0f;
-                        float value1 = (float)((unsigned char*)src)[src_iter + 1] / 255.0f;
+    rf_int i = 0;
 
-                        dst[dst_iter].x = value0;
-                        dst[dst_iter].y = value0;
-                        dst[dst_iter].z = value0;
-                        dst[dst_iter].w = value1;
-                    }
-                    break;
+    // Every iteration consumes 24 bytes but loads 32, so stop early enough to not read past the end of src
+    for (; i + 11 <= count; i += 8)
+    {
+        __m256i rgb = _mm256_loadu_si256((const __m256i*)(src + i * 3));
+        rgb = _mm256_permutevar8x32_epi32(rgb, spread);
+        rgb = _mm256_shuffle_epi8(rgb, shuffle);
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(rgb, alpha));
+    }
 
-                case RF_UNCOMPRESSED_R5G5B5A1:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned short pixel = ((unsigned short*) src)[src_iter];
+    return i;
+}
 
-                        dst[dst_iter].x = (float)((pixel & 0b1111100000000000) >> 11) * (1.0f/31);
-                        dst[dst_iter].y = (float)((pixel & 0b0000011111000000) >>  6) * (1.0f/31);
-                        dst[dst_iter].z = (float)((pixel & 0b0000000000111110) >>  1) * (1.0f/31);
-                        dst[dst_iter].w = ((pixel & 0b0000000000000001) == 0) ? 0.0f : 1.0f;
-                    }
-                    break;
+RF_INTERNAL RF_AVX2_FUNC rf_int rf_rgba32_to_rgb888_avx2(const unsigned char* src, unsigned char* dst, rf_int count)
+{
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                             0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i pack    = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
 
-                case RF_UNCOMPRESSED_R5G6B5:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned short pixel = ((unsigned short*)src)[src_iter];
+    rf_int i = 0;
 
-                        dst[dst_iter].x = (float)((pixel & 0b1111100000000000) >> 11) * (1.0f / 31);
-                        dst[dst_iter].y = (float)((pixel & 0b0000011111100000) >>  5) * (1.0f / 63);
-                        dst[dst_iter].z = (float) (pixel & 0b0000000000011111)        * (1.0f / 31);
-                        dst[dst_iter].w = 1.0f;
-                    }
-                    break;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i rgba = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+        rgba = _mm256_shuffle_epi8(rgba, shuffle);
+        rgba = _mm256_permutevar8x32_epi32(rgba, pack);
+        _mm_storeu_si128((__m128i*)(dst + i * 3), _mm256_castsi256_si128(rgba));
+        _mm_storel_epi64((__m128i*)(dst + i * 3 + 16), _mm256_extracti128_si256(rgba, 1));
+    }
 
-                case RF_UNCOMPRESSED_R4G4B4A4:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned short pixel = ((unsigned short*)src)[src_iter];
+    return i;
+}
+#endif
 
-                        dst[dst_iter].x = (float)((pixel & 0b1111000000000000) >> 12) * (1.0f / 15);
-                        dst[dst_iter].y = (float)((pixel & 0b0000111100000000) >> 8)  * (1.0f / 15);
-                        dst[dst_iter].z = (float)((pixel & 0b0000000011110000) >> 4)  * (1.0f / 15);
-                        dst[dst_iter].w = (float) (pixel & 0b0000000000001111)        * (1.0f / 15);
-                    }
-                    break;
+RF_INTERNAL void rf_rgb888_to_rgba32(const unsigned char* src, unsigned char* dst, rf_int count)
+{
+    rf_int i = 0;
 
-                case RF_UNCOMPRESSED_R8G8B8A8:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].x = (float)((unsigned char*)src)[src_iter + 0] / 255.0f;
-                        dst[dst_iter].y = (float)((unsigned char*)src)[src_iter + 1] / 255.0f;
-                        dst[dst_iter].z = (float)((unsigned char*)src)[src_iter + 2] / 255.0f;
-                        dst[dst_iter].w = (float)((unsigned char*)src)[src_iter + 3] / 255.0f;
-                    }
-                    break;
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_rgb888_to_rgba32_avx2(src, dst, count);
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(255);
+            vst4q_u8(dst + i * 4, rgba);
+        }
+    #endif
 
-                case RF_UNCOMPRESSED_R8G8B8:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].x = (float)((unsigned char*)src)[src_iter + 0] / 255.0f;
-                        dst[dst_iter].y = (float)((unsigned char*)src)[src_iter + 1] / 255.0f;
-                        dst[dst_iter].z = (float)((unsigned char*)src)[src_iter + 2] / 255.0f;
-                        dst[dst_iter].w = 1.0f;
-                    }
-                    break;
+    for (; i < count; i++)
+    {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+}
 
-                case RF_UNCOMPRESSED_R32:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].x = ((float*)src)[src_iter];
-                        dst[dst_iter].y = 0.0f;
-                        dst[dst_iter].z = 0.0f;
-                        dst[dst_iter].w = 1.0f;
-                    }
-                    break;
+RF_INTERNAL void rf_rgba32_to_rgb888(const unsigned char* src, unsigned char* dst, rf_int count)
+{
+    rf_int i = 0;
 
-                case RF_UNCOMPRESSED_R32G32B32:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].x = ((float*)src)[src_iter + 0];
-                        dst[dst_iter].y = ((float*)src)[src_iter + 1];
-                        dst[dst_iter].z = ((float*)src)[src_iter + 2];
-                        dst[dst_iter].w = 1.0f;
-                    }
-                    break;
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_rgba32_to_rgb888_avx2(src, dst, count);
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t rgba = vld4q_u8(src + i * 4);
+            uint8x16x3_t rgb;
+            rgb.val[0] = rgba.val[0];
+            rgb.val[1] = rgba.val[1];
+            rgb.val[2] = rgba.val[2];
+            vst3q_u8(dst + i * 3, rgb);
+        }
+    #endif
 
-                case RF_UNCOMPRESSED_R32G32B32A32:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].x = ((float*)src)[src_iter + 0];
-                        dst[dst_iter].y = ((float*)src)[src_iter + 1];
-                        dst[dst_iter].z = ((float*)src)[src_iter + 2];
-                        dst[dst_iter].w = ((float*)src)[src_iter + 3];
-                    }
-                    break;
+    for (; i < count; i++)
+    {
+        dst[i * 3 + 0] = src[i * 4 + 0];
+        dst[i * 3 + 1] = src[i * 4 + 1];
+        dst[i * 3 + 2] = src[i * 4 + 2];
+    }
+}
 
-                default: break;
-            }
-            #undef RF_FOR_EACH_PIXEL
+RF_INTERNAL void rf_r5g6b5_to_rgba32(const unsigned short* src, unsigned char* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i p  = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i r5 = _mm_srli_epi16(p, 11);
+            __m128i g6 = _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F));
+            __m128i b5 = _mm_and_si128(p, _mm_set1_epi16(0x1F));
+            __m128i r  = _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+            __m128i g  = _mm_or_si128(_mm_slli_epi16(g6, 2), _mm_srli_epi16(g6, 4));
+            __m128i b  = _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+            rf_sse2_store_rgba32(dst + i * 4, r, g, b, _mm_set1_epi16(0xFF));
+        }
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8_t p  = vld1q_u16(src + i);
+            uint16x8_t r5 = vshrq_n_u16(p, 11);
+            uint16x8_t g6 = vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F));
+            uint16x8_t b5 = vandq_u16(p, vdupq_n_u16(0x1F));
+            uint8x8x4_t rgba;
+            rgba.val[0] = vmovn_u16(vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2)));
+            rgba.val[1] = vmovn_u16(vorrq_u16(vshlq_n_u16(g6, 2), vshrq_n_u16(g6, 4)));
+            rgba.val[2] = vmovn_u16(vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2)));
+            rgba.val[3] = vdup_n_u8(255);
+            vst4_u8(dst + i * 4, rgba);
         }
+    #endif
+
+    for (; i < count; i++)
+    {
+        unsigned short pixel = src[i];
+        dst[i * 4 + 0] = rf_expand_5bit((pixel >> 11) & 0x1F);
+        dst[i * 4 + 1] = rf_expand_6bit((pixel >>  5) & 0x3F);
+        dst[i * 4 + 2] = rf_expand_5bit( pixel        & 0x1F);
+        dst[i * 4 + 3] = 255;
     }
-    else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expected a size of at least %d.", dst_size, src_pixel_count * sizeof(rf_vec4));
+}
 
-    return success;
+RF_INTERNAL void rf_r5g5b5a1_to_rgba32(const unsigned short* src, unsigned char* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i p  = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i r5 = _mm_srli_epi16(p, 11);
+            __m128i g5 = _mm_and_si128(_mm_srli_epi16(p, 6), _mm_set1_epi16(0x1F));
+            __m128i b5 = _mm_and_si128(_mm_srli_epi16(p, 1), _mm_set1_epi16(0x1F));
+            __m128i r  = _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+            __m128i g  = _mm_or_si128(_mm_slli_epi16(g5, 3), _mm_srli_epi16(g5, 2));
+            __m128i b  = _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+            __m128i a  = _mm_mullo_epi16(_mm_and_si128(p, _mm_set1_epi16(1)), _mm_set1_epi16(0xFF));
+            rf_sse2_store_rgba32(dst + i * 4, r, g, b, a);
+        }
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8_t p  = vld1q_u16(src + i);
+            uint16x8_t r5 = vshrq_n_u16(p, 11);
+            uint16x8_t g5 = vandq_u16(vshrq_n_u16(p, 6), vdupq_n_u16(0x1F));
+            uint16x8_t b5 = vandq_u16(vshrq_n_u16(p, 1), vdupq_n_u16(0x1F));
+            uint8x8x4_t rgba;
+            rgba.val[0] = vmovn_u16(vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2)));
+            rgba.val[1] = vmovn_u16(vorrq_u16(vshlq_n_u16(g5, 3), vshrq_n_u16(g5, 2)));
+            rgba.val[2] = vmovn_u16(vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2)));
+            rgba.val[3] = vmovn_u16(vmulq_n_u16(vandq_u16(p, vdupq_n_u16(1)), 0xFF));
+            vst4_u8(dst + i * 4, rgba);
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        unsigned short pixel = src[i];
+        dst[i * 4 + 0] = rf_expand_5bit((pixel >> 11) & 0x1F);
+        dst[i * 4 + 1] = rf_expand_5bit((pixel >>  6) & 0x1F);
+        dst[i * 4 + 2] = rf_expand_5bit((pixel >>  1) & 0x1F);
+        dst[i * 4 + 3] = (pixel & 1) * 255;
+    }
 }
 
-RF_API bool rf_format_pixels_to_rgba32(const void* src, rf_int src_size, rf_uncompressed_pixel_format src_format, rf_color* dst, rf_int dst_size)
+RF_INTERNAL void rf_r4g4b4a4_to_rgba32(const unsigned short* src, unsigned char* dst, rf_int count)
 {
-    bool success = false;
+    rf_int i = 0;
 
-    rf_int src_bpp = rf_bytes_per_pixel(src_format);
-    rf_int src_pixel_count = src_size / src_bpp;
-    rf_int dst_pixel_count = dst_size / sizeof(rf_color);
+    #if defined(RF_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i p    = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i mask = _mm_set1_epi16(0xF);
+            __m128i r4   = _mm_srli_epi16(p, 12);
+            __m128i g4   = _mm_and_si128(_mm_srli_epi16(p, 8), mask);
+            __m128i b4   = _mm_and_si128(_mm_srli_epi16(p, 4), mask);
+            __m128i a4   = _mm_and_si128(p, mask);
+            rf_sse2_store_rgba32(dst + i * 4,
+                                 _mm_or_si128(_mm_slli_epi16(r4, 4), r4),
+                                 _mm_or_si128(_mm_slli_epi16(g4, 4), g4),
+                                 _mm_or_si128(_mm_slli_epi16(b4, 4), b4),
+                                 _mm_or_si128(_mm_slli_epi16(a4, 4), a4));
+        }
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8_t p    = vld1q_u16(src + i);
+            uint16x8_t mask = vdupq_n_u16(0xF);
+            uint8x8x4_t rgba;
+            rgba.val[0] = vmovn_u16(vmulq_n_u16(vshrq_n_u16(p, 12), 17));
+            rgba.val[1] = vmovn_u16(vmulq_n_u16(vandq_u16(vshrq_n_u16(p, 8), mask), 17));
+            rgba.val[2] = vmovn_u16(vmulq_n_u16(vandq_u16(vshrq_n_u16(p, 4), mask), 17));
+            rgba.val[3] = vmovn_u16(vmulq_n_u16(vandq_u16(p, mask), 17));
+            vst4_u8(dst + i * 4, rgba);
+        }
+    #endif
 
-    if (dst_pixel_count >= src_pixel_count)
+    for (; i < count; i++)
     {
-        if (src_format == RF_UNCOMPRESSED_R8G8B8A8)
+        unsigned short pixel = src[i];
+        dst[i * 4 + 0] = rf_expand_4bit((pixel >> 12) & 0xF);
+        dst[i * 4 + 1] = rf_expand_4bit((pixel >>  8) & 0xF);
+        dst[i * 4 + 2] = rf_expand_4bit((pixel >>  4) & 0xF);
+        dst[i * 4 + 3] = rf_expand_4bit( pixel        & 0xF);
+    }
+}
+
+RF_INTERNAL void rf_rgba32_to_r5g6b5(const unsigned char* src, unsigned short* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
         {
-            success = true;
-            memcpy(dst, src, src_size);
+            __m128i r, g, b, a;
+            rf_sse2_load_rgba32(src + i * 4, &r, &g, &b, &a);
+            __m128i p = _mm_or_si128(_mm_slli_epi16(rf_sse2_quantize_u8(r, 31), 11),
+                        _mm_or_si128(_mm_slli_epi16(rf_sse2_quantize_u8(g, 63), 5), rf_sse2_quantize_u8(b, 31)));
+            _mm_storeu_si128((__m128i*)(dst + i), p);
         }
-        else
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 8 <= count; i += 8)
         {
-            success = true;
-            #define RF_FOR_EACH_PIXEL for (rf_int dst_iter = 0, src_iter = 0; src_iter < src_size && dst_iter < dst_size; dst_iter++, src_iter += src_bpp)
-            switch (src_format)
-            {
-                case RF_UNCOMPRESSED_GRAYSCALE:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned char value = ((unsigned char*) src)[src_iter];
-                        dst[dst_iter].r = value;
-                        dst[dst_iter].g = value;
-                        dst[dst_iter].b = value;
-                        dst[dst_iter].a = 255;
-                    }
-                    break;
+            uint8x8x4_t rgba = vld4_u8(src + i * 4);
+            uint16x8_t p = vorrq_u16(vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[0]), 31), 11),
+                           vorrq_u16(vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[1]), 63), 5), rf_neon_quantize_u8(vmovl_u8(rgba.val[2]), 31)));
+            vst1q_u16(dst + i, p);
+        }
+    #endif
 
-                case RF_UNCOMPRESSED_GRAY_ALPHA:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned char value0 = ((unsigned char*) src)[src_iter + 0];
-                        unsigned char value1 = ((unsigned char*) src)[src_iter + 1];
+    for (; i < count; i++)
+    {
+        dst[i] = (unsigned short)(rf_quantize_u8(src[i * 4 + 0], 31) << 11 | rf_quantize_u8(src[i * 4 + 1], 63) << 5 | rf_quantize_u8(src[i * 4 + 2], 31));
+    }
+}
 
-                        dst[dst_iter].r = value0;
-                        dst[dst_iter].g = value0;
-                        dst[dst_iter].b = value0;
-                        dst[dst_iter].a = value1;
-                    }
-                    break;
+// Alpha is set if it is above this threshold, matches rf_format_one_pixel
+#define RF_R5G5B5A1_ALPHA_THRESHOLD (50)
 
-                case RF_UNCOMPRESSED_R5G5B5A1:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned short pixel = ((unsigned short*) src)[src_iter];
+RF_INTERNAL void rf_rgba32_to_r5g5b5a1(const unsigned char* src, unsigned short* dst, rf_int count)
+{
+    rf_int i = 0;
 
-                        dst[dst_iter].r = (unsigned char)((float)((pixel & 0b1111100000000000) >> 11) * (255 / 31));
-                        dst[dst_iter].g = (unsigned char)((float)((pixel & 0b0000011111000000) >>  6) * (255 / 31));
-                        dst[dst_iter].b = (unsigned char)((float)((pixel & 0b0000000000111110) >>  1) * (255 / 31));
-                        dst[dst_iter].a = (unsigned char)        ((pixel & 0b0000000000000001)        *  255);
-                    }
-                    break;
+    #if defined(RF_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i r, g, b, a;
+            rf_sse2_load_rgba32(src + i * 4, &r, &g, &b, &a);
+            __m128i a1 = _mm_and_si128(_mm_cmpgt_epi16(a, _mm_set1_epi16(RF_R5G5B5A1_ALPHA_THRESHOLD)), _mm_set1_epi16(1));
+            __m128i p  = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(rf_sse2_quantize_u8(r, 31), 11), _mm_slli_epi16(rf_sse2_quantize_u8(g, 31), 6)),
+                                      _mm_or_si128(_mm_slli_epi16(rf_sse2_quantize_u8(b, 31), 1), a1));
+            _mm_storeu_si128((__m128i*)(dst + i), p);
+        }
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t rgba = vld4_u8(src + i * 4);
+            uint16x8_t a1 = vmovl_u8(vshr_n_u8(vcgt_u8(rgba.val[3], vdup_n_u8(RF_R5G5B5A1_ALPHA_THRESHOLD)), 7));
+            uint16x8_t p  = vorrq_u16(vorrq_u16(vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[0]), 31), 11), vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[1]), 31), 6)),
+                                      vorrq_u16(vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[2]), 31), 1), a1));
+            vst1q_u16(dst + i, p);
+        }
+    #endif
 
-                case RF_UNCOMPRESSED_R5G6B5:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned short pixel = ((unsigned short*) src)[src_iter];
+    for (; i < count; i++)
+    {
+        unsigned int a = src[i * 4 + 3] > RF_R5G5B5A1_ALPHA_THRESHOLD ? 1 : 0;
+        dst[i] = (unsigned short)(rf_quantize_u8(src[i * 4 + 0], 31) << 11 | rf_quantize_u8(src[i * 4 + 1], 31) << 6 | rf_quantize_u8(src[i * 4 + 2], 31) << 1 | a);
+    }
+}
 
-                        dst[dst_iter].r = (unsigned char)((float)((pixel & 0b1111100000000000) >> 11)* (255 / 31));
-                        dst[dst_iter].g = (unsigned char)((float)((pixel & 0b0000011111100000) >>  5)* (255 / 63));
-                        dst[dst_iter].b = (unsigned char)((float) (pixel & 0b0000000000011111)       * (255 / 31));
-                        dst[dst_iter].a = 255;
-                    }
-                    break;
+RF_INTERNAL void rf_rgba32_to_r4g4b4a4(const unsigned char* src, unsigned short* dst, rf_int count)
+{
+    rf_int i = 0;
 
-                case RF_UNCOMPRESSED_R4G4B4A4:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        unsigned short pixel = ((unsigned short*) src)[src_iter];
+    #if defined(RF_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i r, g, b, a;
+            rf_sse2_load_rgba32(src + i * 4, &r, &g, &b, &a);
+            __m128i p = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(rf_sse2_quantize_u8(r, 15), 12), _mm_slli_epi16(rf_sse2_quantize_u8(g, 15), 8)),
+                                     _mm_or_si128(_mm_slli_epi16(rf_sse2_quantize_u8(b, 15), 4), rf_sse2_quantize_u8(a, 15)));
+            _mm_storeu_si128((__m128i*)(dst + i), p);
+        }
+    #elif defined(RF_SIMD_NEON)
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t rgba = vld4_u8(src + i * 4);
+            uint16x8_t p = vorrq_u16(vorrq_u16(vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[0]), 15), 12), vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[1]), 15), 8)),
+                                     vorrq_u16(vshlq_n_u16(rf_neon_quantize_u8(vmovl_u8(rgba.val[2]), 15), 4), rf_neon_quantize_u8(vmovl_u8(rgba.val[3]), 15)));
+            vst1q_u16(dst + i, p);
+        }
+    #endif
 
-                        dst[dst_iter].r = (unsigned char)((float)((pixel & 0b1111000000000000) >> 12) * (255 / 15));
-                        dst[dst_iter].g = (unsigned char)((float)((pixel & 0b0000111100000000) >> 8)  * (255 / 15));
-                        dst[dst_iter].b = (unsigned char)((float)((pixel & 0b0000000011110000) >> 4)  * (255 / 15));
-                        dst[dst_iter].a = (unsigned char)((float) (pixel & 0b0000000000001111)        * (255 / 15));
-                    }
-                    break;
+    for (; i < count; i++)
+    {
+        dst[i] = (unsigned short)(rf_quantize_u8(src[i * 4 + 0], 15) << 12 | rf_quantize_u8(src[i * 4 + 1], 15) << 8 | rf_quantize_u8(src[i * 4 + 2], 15) << 4 | rf_quantize_u8(src[i * 4 + 3], 15));
+    }
+}
 
-                case RF_UNCOMPRESSED_R8G8B8A8:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].r = ((unsigned char*) src)[src_iter + 0];
-                        dst[dst_iter].g = ((unsigned char*) src)[src_iter + 1];
-                        dst[dst_iter].b = ((unsigned char*) src)[src_iter + 2];
-                        dst[dst_iter].a = ((unsigned char*) src)[src_iter + 3];
-                    }
-                    break;
+#if defined(RF_SIMD_AVX2)
+RF_INTERNAL RF_AVX2_FUNC rf_int rf_rgba32_to_normalized_avx2(const unsigned char* src, float* dst, rf_int count)
+{
+    const __m256 max = _mm256_set1_ps(255.0f);
 
-                case RF_UNCOMPRESSED_R8G8B8:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].r = (unsigned char)((unsigned char*) src)[src_iter + 0];
-                        dst[dst_iter].g = (unsigned char)((unsigned char*) src)[src_iter + 1];
-                        dst[dst_iter].b = (unsigned char)((unsigned char*) src)[src_iter + 2];
-                        dst[dst_iter].a = 255;
-                    }
-                    break;
+    rf_int i = 0;
 
-                case RF_UNCOMPRESSED_R32:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].r = (unsigned char)(((float*) src)[src_iter + 0] * 255.0f);
-                        dst[dst_iter].g = 0;
-                        dst[dst_iter].b = 0;
-                        dst[dst_iter].a = 255;
-                    }
-                    break;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m256i channels = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i * 4)));
+        _mm256_storeu_ps(dst + i * 4, _mm256_div_ps(_mm256_cvtepi32_ps(channels), max));
+    }
 
-                case RF_UNCOMPRESSED_R32G32B32:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].r = (unsigned char)(((float*) src)[src_iter + 0] * 255.0f);
-                        dst[dst_iter].g = (unsigned char)(((float*) src)[src_iter + 1] * 255.0f);
-                        dst[dst_iter].b = (unsigned char)(((float*) src)[src_iter + 2] * 255.0f);
-                        dst[dst_iter].a = 255;
-                    }
-                    break;
+    return i;
+}
 
-                case RF_UNCOMPRESSED_R32G32B32A32:
-                    RF_FOR_EACH_PIXEL
-                    {
-                        dst[dst_iter].r = (unsigned char)(((float*) src)[src_iter + 0] * 255.0f);
-                        dst[dst_iter].g = (unsigned char)(((float*) src)[src_iter + 1] * 255.0f);
-                        dst[dst_iter].b = (unsigned char)(((float*) src)[src_iter + 2] * 255.0f);
-                        dst[dst_iter].a = (unsigned char)(((float*) src)[src_iter + 3] * 255.0f);
-                    }
-                    break;
+RF_INTERNAL RF_AVX2_FUNC rf_int rf_normalized_to_rgba32_avx2(const float* src, unsigned char* dst, rf_int count)
+{
+    const __m256  max   = _mm256_set1_ps(255.0f);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
 
-                default: break;
+    rf_int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i p01 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i * 4 +  0), max));
+        __m256i p23 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i * 4 +  8), max));
+        __m256i p45 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i * 4 + 16), max));
+        __m256i p67 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i * 4 + 24), max));
+
+        // Packing works per 128 bit lane so the pixels come out as 0 2 4 6 1 3 5 7 and need to be reordered
+        __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(p01, p23), _mm256_packs_epi32(p45, p67));
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_permutevar8x32_epi32(packed, order));
+    }
+
+    return i;
+}
+#endif
+
+RF_INTERNAL void rf_rgba32_to_normalized(const unsigned char* src, float* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_rgba32_to_normalized_avx2(src, dst, count);
+    #endif
+
+    #if defined(RF_SIMD_SSE2)
+        __m128 max  = _mm_set1_ps(255.0f);
+        __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i p  = _mm_loadu_si128((const __m128i*)(src + i * 4));
+            __m128i lo = _mm_unpacklo_epi8(p, zero);
+            __m128i hi = _mm_unpackhi_epi8(p, zero);
+
+            // Divide instead of multiplying by the reciprocal so that the results are identical to the scalar path
+            _mm_storeu_ps(dst + i * 4 +  0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), max));
+            _mm_storeu_ps(dst + i * 4 +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), max));
+            _mm_storeu_ps(dst + i * 4 +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), max));
+            _mm_storeu_ps(dst + i * 4 + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), max));
+        }
+    #elif defined(RF_SIMD_NEON) && defined(__aarch64__)
+        float32x4_t max = vdupq_n_f32(255.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            uint8x16_t p  = vld1q_u8(src + i * 4);
+            uint16x8_t lo = vmovl_u8(vget_low_u8(p));
+            uint16x8_t hi = vmovl_u8(vget_high_u8(p));
+            vst1q_f32(dst + i * 4 +  0, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))),  max));
+            vst1q_f32(dst + i * 4 +  4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), max));
+            vst1q_f32(dst + i * 4 +  8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))),  max));
+            vst1q_f32(dst + i * 4 + 12, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), max));
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        dst[i * 4 + 0] = (float)src[i * 4 + 0] / 255.0f;
+        dst[i * 4 + 1] = (float)src[i * 4 + 1] / 255.0f;
+        dst[i * 4 + 2] = (float)src[i * 4 + 2] / 255.0f;
+        dst[i * 4 + 3] = (float)src[i * 4 + 3] / 255.0f;
+    }
+}
+
+RF_INTERNAL void rf_normalized_to_rgba32(const float* src, unsigned char* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_normalized_to_rgba32_avx2(src, dst, count);
+    #endif
+
+    #if defined(RF_SIMD_SSE2)
+        __m128 max = _mm_set1_ps(255.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i p0 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i * 4 +  0), max));
+            __m128i p1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i * 4 +  4), max));
+            __m128i p2 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i * 4 +  8), max));
+            __m128i p3 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i * 4 + 12), max));
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+        }
+    #elif defined(RF_SIMD_NEON) && defined(__aarch64__)
+        float32x4_t max = vdupq_n_f32(255.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            uint16x4_t p0 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i * 4 +  0), max)));
+            uint16x4_t p1 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i * 4 +  4), max)));
+            uint16x4_t p2 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i * 4 +  8), max)));
+            uint16x4_t p3 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i * 4 + 12), max)));
+            vst1q_u8(dst + i * 4, vcombine_u8(vqmovn_u16(vcombine_u16(p0, p1)), vqmovn_u16(vcombine_u16(p2, p3))));
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        dst[i * 4 + 0] = (unsigned char)(src[i * 4 + 0] * 255.0f);
+        dst[i * 4 + 1] = (unsigned char)(src[i * 4 + 1] * 255.0f);
+        dst[i * 4 + 2] = (unsigned char)(src[i * 4 + 2] * 255.0f);
+        dst[i * 4 + 3] = (unsigned char)(src[i * 4 + 3] * 255.0f);
+    }
+}
+
+/*
+ Converts `count` pixels using a specialized kernel if there is one for the pair of formats.
+ Returns false if the pair is not handled in which case the caller should fallback to the generic per pixel conversion.
+*/
+RF_INTERNAL bool rf_format_pixels_fast(const void* src, rf_uncompressed_pixel_format src_format, void* dst, rf_uncompressed_pixel_format dst_format, rf_int count)
+{
+    bool handled = true;
+
+    if (dst_format == RF_UNCOMPRESSED_R8G8B8A8)
+    {
+        switch (src_format)
+        {
+            case RF_UNCOMPRESSED_GRAYSCALE:    rf_gray_to_rgba32(src, dst, count); break;
+            case RF_UNCOMPRESSED_GRAY_ALPHA:   rf_gray_alpha_to_rgba32(src, dst, count); break;
+            case RF_UNCOMPRESSED_R8G8B8:       rf_rgb888_to_rgba32(src, dst, count); break;
+            case RF_UNCOMPRESSED_R5G6B5:       rf_r5g6b5_to_rgba32(src, dst, count); break;
+            case RF_UNCOMPRESSED_R5G5B5A1:     rf_r5g5b5a1_to_rgba32(src, dst, count); break;
+            case RF_UNCOMPRESSED_R4G4B4A4:     rf_r4g4b4a4_to_rgba32(src, dst, count); break;
+            case RF_UNCOMPRESSED_R32G32B32A32: rf_normalized_to_rgba32(src, dst, count); break;
+            default: handled = false; break;
+        }
+    }
+    else if (src_format == RF_UNCOMPRESSED_R8G8B8A8)
+    {
+        switch (dst_format)
+        {
+            case RF_UNCOMPRESSED_R8G8B8:       rf_rgba32_to_rgb888(src, dst, count); break;
+            case RF_UNCOMPRESSED_R5G6B5:       rf_rgba32_to_r5g6b5(src, dst, count); break;
+            case RF_UNCOMPRESSED_R5G5B5A1:     rf_rgba32_to_r5g5b5a1(src, dst, count); break;
+            case RF_UNCOMPRESSED_R4G4B4A4:     rf_rgba32_to_r4g4b4a4(src, dst, count); break;
+            case RF_UNCOMPRESSED_R32G32B32A32: rf_rgba32_to_normalized(src, dst, count); break;
+            default: handled = false; break;
+        }
+    }
+    else handled = false;
+
+    return handled;
+}
+
+#pragma endregion
+
+RF_API bool rf_format_pixels_to_normalized(const void* src, rf_int src_size, rf_uncompressed_pixel_format src_format, rf_vec4* dst, rf_int dst_size)
+{
+    bool success = false;
+
+    rf_int src_bpp = rf_bytes_per_pixel(src_format);
+    rf_int src_pixel_count = src_size / src_bpp;
+    rf_int dst_pixel_count = dst_size / sizeof(rf_vec4);
+
+    if (dst_pixel_count >= src_pixel_count)
+    {
+        success = true;
+
+        if (src_format == RF_UNCOMPRESSED_R32G32B32A32)
+        {
+            memcpy(dst, src, src_size);
+        }
+        else if (!rf_format_pixels_fast(src, src_format, dst, RF_UNCOMPRESSED_R32G32B32A32, src_pixel_count))
+        {
+            for (rf_int i = 0; i < src_pixel_count; i++)
+            {
+                dst[i] = rf_format_one_pixel_to_normalized(((unsigned char*) src) + i * src_bpp, src_format);
+            }
+        }
+    }
+    else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expected a size of at least %d.", dst_size, src_pixel_count * sizeof(rf_vec4));
+
+    return success;
+}
+
+RF_API bool rf_format_pixels_to_rgba32(const void* src, rf_int src_size, rf_uncompressed_pixel_format src_format, rf_color* dst, rf_int dst_size)
+{
+    bool success = false;
+
+    rf_int src_bpp = rf_bytes_per_pixel(src_format);
+    rf_int src_pixel_count = src_size / src_bpp;
+    rf_int dst_pixel_count = dst_size / sizeof(rf_color);
+
+    if (dst_pixel_count >= src_pixel_count)
+    {
+        success = true;
+
+        if (src_format == RF_UNCOMPRESSED_R8G8B8A8)
+        {
+            memcpy(dst, src, src_size);
+        }
+        else if (!rf_format_pixels_fast(src, src_format, dst, RF_UNCOMPRESSED_R8G8B8A8, src_pixel_count))
+        {
+            for (rf_int i = 0; i < src_pixel_count; i++)
+            {
+                dst[i] = rf_format_one_pixel_to_rgba32(((unsigned char*) src) + i * src_bpp, src_format);
             }
-            #undef RF_FOR_EACH_PIXEL
         }
     }
     else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expected a size of at least %d", dst_size, src_pixel_count * sizeof(rf_color));
@@ -980,113 +1833,17 @@ RF_API bool rf_format_pixels(const void* src, rf_int src_size, rf_uncompressed_p
         {
             success = true;
 
-            //Loop over both src and dst
-            #define RF_FOR_EACH_PIXEL for (rf_int src_iter = 0, dst_iter = 0; src_iter < src_size && dst_iter < dst_size; src_iter += src_bpp, dst_iter += dst_bpp)
-            #define RF_COMPUTE_NORMALIZED_PIXEL() rf_format_one_pixel_to_normalized(((unsigned char*) src) + src_iter, src_format);
             if (src_format == dst_format)
             {
                 memcpy(dst, src, src_size);
             }
-            else
+            else if (!rf_format_pixels_fast(src, src_format, dst, dst_format, src_pixel_count))
             {
-                switch (dst_format)
+                for (rf_int i = 0; i < src_pixel_count; i++)
                 {
-                    case RF_UNCOMPRESSED_GRAYSCALE:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-                            ((unsigned char*)dst)[dst_iter] = (unsigned char)((normalized.x * 0.299f + normalized.y * 0.587f + normalized.z * 0.114f) * 255.0f);
-                        }
-                        break;
-
-                    case RF_UNCOMPRESSED_GRAY_ALPHA:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-
-                            ((unsigned char*)dst)[dst_iter    ] = (unsigned char)((normalized.x * 0.299f + (float)normalized.y * 0.587f + (float)normalized.z * 0.114f) * 255.0f);
-                            ((unsigned char*)dst)[dst_iter + 1] = (unsigned char) (normalized.w * 255.0f);
-                        }
-                        break;
-
-                    case RF_UNCOMPRESSED_R5G6B5:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-
-                            unsigned char r = (unsigned char)(round(normalized.x * 31.0f));
-                            unsigned char g = (unsigned char)(round(normalized.y * 63.0f));
-                            unsigned char b = (unsigned char)(round(normalized.z * 31.0f));
-
-                            ((unsigned short*)dst)[dst_iter] = (unsigned short)r << 11 | (unsigned short)g << 5 | (unsigned short)b;
-                        }
-                        break;
-
-                    case RF_UNCOMPRESSED_R8G8B8:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-
-                            ((unsigned char*)dst)[dst_iter    ] = (unsigned char)(normalized.x * 255.0f);
-                            ((unsigned char*)dst)[dst_iter + 1] = (unsigned char)(normalized.y * 255.0f);
-                            ((unsigned char*)dst)[dst_iter + 2] = (unsigned char)(normalized.z * 255.0f);
-                        }
-                        break;
-
-                    case RF_UNCOMPRESSED_R5G5B5A1:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-
-                            int ALPHA_THRESHOLD = 50;
-                            unsigned char r = (unsigned char)(round(normalized.x * 31.0f));
-                            unsigned char g = (unsigned char)(round(normalized.y * 31.0f));
-                            unsigned char b = (unsigned char)(round(normalized.z * 31.0f));
-                            unsigned char a = (normalized.w > ((float)ALPHA_THRESHOLD / 255.0f)) ? 1 : 0;
-
-                            ((unsigned short*)dst)[dst_iter] = (unsigned short)r << 11 | (unsigned short)g << 6 | (unsigned short)b << 1 | (unsigned short)a;
-                        }
-                        break;
-
-                    case RF_UNCOMPRESSED_R4G4B4A4:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-
-                            unsigned char r = (unsigned char)(round(normalized.x * 15.0f));
-                            unsigned char g = (unsigned char)(round(normalized.y * 15.0f));
-                            unsigned char b = (unsigned char)(round(normalized.z * 15.0f));
-                            unsigned char a = (unsigned char)(round(normalized.w * 15.0f));
-
-                            ((unsigned short*)dst)[dst_iter] = (unsigned short)r << 12 | (unsigned short)g << 8 | (unsigned short)b << 4 | (unsigned short)a;
-                        }
-                        break;
-
-                    case RF_UNCOMPRESSED_R32:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-
-                            ((float*)dst)[dst_iter] = (float)(normalized.x * 0.299f + normalized.y * 0.587f + normalized.z * 0.114f);
-                        }
-                        break;
-
-                    case RF_UNCOMPRESSED_R32G32B32:
-                        RF_FOR_EACH_PIXEL
-                        {
-                            rf_vec4 normalized = RF_COMPUTE_NORMALIZED_PIXEL();
-
-                            ((float*)dst)[dst_iter    ] = normalized.x;
-                            ((float*)dst)[dst_iter + 1] = normalized.y;
-                            ((float*)dst)[dst_iter + 2] = normalized.z;
-                        }
-                        break;
-
-                    default: break;
+                    rf_format_one_pixel(((unsigned char*) src) + i * src_bpp, src_format, ((unsigned char*) dst) + i * dst_bpp, dst_format);
                 }
             }
-            #undef RF_FOR_EACH_PIXEL
-            #undef RF_COMPUTE_NORMALIZED_PIXEL
         }
         else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expected a size of at least %d.", dst_size, src_pixel_count * dst_bpp);
     }
@@ -1240,10 +1997,10 @@ RF_API rf_color rf_format_one_pixel_to_rgba32(const void* src, rf_uncompressed_p
         {
             unsigned short pixel = ((unsigned short*) src)[0];
 
-            result.r = (unsigned char)((float)((pixel & 0b1111100000000000) >> 11) * (255 / 31));
-            result.g = (unsigned char)((float)((pixel & 0b0000011111000000) >>  6) * (255 / 31));
-            result.b = (unsigned char)((float)((pixel & 0b0000000000111110) >>  1) * (255 / 31));
-            result.a = (unsigned char)        ((pixel & 0b0000000000000001)        *  255);
+            result.r = rf_expand_5bit((pixel & 0b1111100000000000) >> 11);
+            result.g = rf_expand_5bit((pixel & 0b0000011111000000) >>  6);
+            result.b = rf_expand_5bit((pixel & 0b0000000000111110) >>  1);
+            result.a = (unsigned char)((pixel & 0b0000000000000001) * 255);
         }
         break;
 
@@ -1251,9 +2008,9 @@ RF_API rf_color rf_format_one_pixel_to_rgba32(const void* src, rf_uncompressed_p
         {
             unsigned short pixel = ((unsigned short*) src)[0];
 
-            result.r = (unsigned char)((float)((pixel & 0b1111100000000000) >> 11)* (255 / 31));
-            result.g = (unsigned char)((float)((pixel & 0b0000011111100000) >>  5)* (255 / 63));
-            result.b = (unsigned char)((float) (pixel & 0b0000000000011111)       * (255 / 31));
+            result.r = rf_expand_5bit((pixel & 0b1111100000000000) >> 11);
+            result.g = rf_expand_6bit((pixel & 0b0000011111100000) >>  5);
+            result.b = rf_expand_5bit( pixel & 0b0000000000011111);
             result.a = 255;
         }
         break;
@@ -1376,11 +2133,10 @@ RF_API void rf_format_one_pixel(const void* src, rf_uncompressed_pixel_format sr
             case RF_UNCOMPRESSED_R5G5B5A1:
             {
                 rf_vec4 normalized = rf_format_one_pixel_to_normalized(src, src_format);
-                int ALPHA_THRESHOLD = 50;
                 unsigned char r = (unsigned char)(round(normalized.x * 31.0f));
                 unsigned char g = (unsigned char)(round(normalized.y * 31.0f));
                 unsigned char b = (unsigned char)(round(normalized.z * 31.0f));
-                unsigned char a = (normalized.w > ((float)ALPHA_THRESHOLD / 255.0f)) ? 1 : 0;
+                unsigned char a = (normalized.w > ((float)RF_R5G5B5A1_ALPHA_THRESHOLD / 255.0f)) ? 1 : 0;
 
                 ((unsigned short*)dst)[0] = (unsigned short)r << 11 | (unsigned short)g << 6 | (unsigned short)b << 1 | (unsigned short)a;
             }
@@ -3221,6 +3977,386 @@ bool rf_check_collision_circle_rec(rf_vec2 center, float radius, rf_rec rec)
     return (cornerDistanceSq <= (radius * radius));
 }
 
+/*
+ Batch collision checks test one shape against arrays of shapes, with the coordinates of the shapes in separate arrays
+ so that 4 (SSE2, NEON) or 8 (AVX2) of them are tested at once. The indices of the colliding shapes are written to hits
+ in increasing order and the number of hits is returned. The results are the same as calling the single shape checks.
+*/
+
+// Writes the indices of the set bits of a comparison mask to hits
+RF_INTERNAL inline int rf_append_collision_hits(int* hits, int hits_count, int base, unsigned mask)
+{
+    for (int lane = 0; mask; lane++, mask >>= 1)
+    {
+        if (mask & 1) hits[hits_count++] = base + lane;
+    }
+
+    return hits_count;
+}
+
+#if defined(RF_SIMD_NEON)
+RF_INTERNAL inline unsigned rf_neon_movemask_u32(uint32x4_t mask)
+{
+    return (vgetq_lane_u32(mask, 0) & 1) | (vgetq_lane_u32(mask, 1) & 2) | (vgetq_lane_u32(mask, 2) & 4) | (vgetq_lane_u32(mask, 3) & 8);
+}
+#endif
+
+#if defined(RF_SIMD_AVX2)
+RF_INTERNAL RF_AVX2_FUNC int rf_check_collision_circles_batch_avx2(rf_vec2 center, float radius, const float* x, const float* y, const float* radii, int count, int* hits, int* hits_count)
+{
+    const __m256 cx = _mm256_set1_ps(center.x);
+    const __m256 cy = _mm256_set1_ps(center.y);
+    const __m256 r  = _mm256_set1_ps(radius);
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), cx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), cy);
+        __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        __m256 hit = _mm256_cmp_ps(distance, _mm256_add_ps(r, _mm256_loadu_ps(radii + i)), _CMP_LE_OQ);
+
+        *hits_count = rf_append_collision_hits(hits, *hits_count, i, (unsigned) _mm256_movemask_ps(hit));
+    }
+
+    return i;
+}
+
+RF_INTERNAL RF_AVX2_FUNC int rf_check_collision_circle_rec_batch_avx2(rf_vec2 center, float radius, const float* x, const float* y, const float* width, const float* height, int count, int* hits, int* hits_count)
+{
+    const __m256 cx   = _mm256_set1_ps(center.x);
+    const __m256 cy   = _mm256_set1_ps(center.y);
+    const __m256 r    = _mm256_set1_ps(radius);
+    const __m256 r2   = _mm256_set1_ps(radius * radius);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 hw = _mm256_mul_ps(_mm256_loadu_ps(width + i), half);
+        __m256 hh = _mm256_mul_ps(_mm256_loadu_ps(height + i), half);
+
+        // The center of the rec is truncated to an integer like in rf_check_collision_circle_rec
+        __m256 rec_cx = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_add_ps(_mm256_loadu_ps(x + i), hw)));
+        __m256 rec_cy = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_add_ps(_mm256_loadu_ps(y + i), hh)));
+        __m256 dx = _mm256_andnot_ps(sign, _mm256_sub_ps(cx, rec_cx));
+        __m256 dy = _mm256_andnot_ps(sign, _mm256_sub_ps(cy, rec_cy));
+
+        __m256 near   = _mm256_and_ps(_mm256_cmp_ps(dx, _mm256_add_ps(hw, r), _CMP_LE_OQ), _mm256_cmp_ps(dy, _mm256_add_ps(hh, r), _CMP_LE_OQ));
+        __m256 inside = _mm256_or_ps(_mm256_cmp_ps(dx, hw, _CMP_LE_OQ), _mm256_cmp_ps(dy, hh, _CMP_LE_OQ));
+        __m256 ex = _mm256_sub_ps(dx, hw);
+        __m256 ey = _mm256_sub_ps(dy, hh);
+        __m256 corner = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey)), r2, _CMP_LE_OQ);
+
+        *hits_count = rf_append_collision_hits(hits, *hits_count, i, (unsigned) _mm256_movemask_ps(_mm256_and_ps(near, _mm256_or_ps(inside, corner))));
+    }
+
+    return i;
+}
+
+RF_INTERNAL RF_AVX2_FUNC int rf_check_collision_recs_batch_avx2(rf_rec rec, const float* x, const float* y, const float* width, const float* height, int count, int* hits, int* hits_count)
+{
+    const __m256 x0 = _mm256_set1_ps(rec.x);
+    const __m256 y0 = _mm256_set1_ps(rec.y);
+    const __m256 x1 = _mm256_set1_ps(rec.x + rec.width);
+    const __m256 y1 = _mm256_set1_ps(rec.y + rec.height);
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 bx = _mm256_loadu_ps(x + i);
+        __m256 by = _mm256_loadu_ps(y + i);
+        __m256 hit_x = _mm256_and_ps(_mm256_cmp_ps(x0, _mm256_add_ps(bx, _mm256_loadu_ps(width + i)), _CMP_LT_OQ), _mm256_cmp_ps(x1, bx, _CMP_GT_OQ));
+        __m256 hit_y = _mm256_and_ps(_mm256_cmp_ps(y0, _mm256_add_ps(by, _mm256_loadu_ps(height + i)), _CMP_LT_OQ), _mm256_cmp_ps(y1, by, _CMP_GT_OQ));
+
+        *hits_count = rf_append_collision_hits(hits, *hits_count, i, (unsigned) _mm256_movemask_ps(_mm256_and_ps(hit_x, hit_y)));
+    }
+
+    return i;
+}
+#endif
+
+// Check collision between a circle and count circles, writes the indices of the colliding circles to hits and returns how many collide
+RF_API int rf_check_collision_circles_batch(rf_vec2 center, float radius, const float* x, const float* y, const float* radii, int count, int* hits)
+{
+    int hits_count = 0;
+    int i = 0;
+
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_check_collision_circles_batch_avx2(center, radius, x, y, radii, count, hits, &hits_count);
+    #endif
+
+    #if defined(RF_SIMD_SSE2)
+        __m128 cx = _mm_set1_ps(center.x);
+        __m128 cy = _mm_set1_ps(center.y);
+        __m128 r  = _mm_set1_ps(radius);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), cy);
+            __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+            __m128 hit = _mm_cmple_ps(distance, _mm_add_ps(r, _mm_loadu_ps(radii + i)));
+
+            hits_count = rf_append_collision_hits(hits, hits_count, i, (unsigned) _mm_movemask_ps(hit));
+        }
+    #elif defined(RF_SIMD_NEON) && defined(__aarch64__)
+        float32x4_t cx = vdupq_n_f32(center.x);
+        float32x4_t cy = vdupq_n_f32(center.y);
+        float32x4_t r  = vdupq_n_f32(radius);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t dx = vsubq_f32(vld1q_f32(x + i), cx);
+            float32x4_t dy = vsubq_f32(vld1q_f32(y + i), cy);
+            float32x4_t distance = vsqrtq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)));
+            uint32x4_t hit = vcleq_f32(distance, vaddq_f32(r, vld1q_f32(radii + i)));
+
+            hits_count = rf_append_collision_hits(hits, hits_count, i, rf_neon_movemask_u32(hit));
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        if (rf_check_collision_circles(center, radius, (rf_vec2) { x[i], y[i] }, radii[i])) hits[hits_count++] = i;
+    }
+
+    return hits_count;
+}
+
+// Check collision between a circle and count recs, writes the indices of the colliding recs to hits and returns how many collide
+RF_API int rf_check_collision_circle_rec_batch(rf_vec2 center, float radius, const float* x, const float* y, const float* width, const float* height, int count, int* hits)
+{
+    int hits_count = 0;
+    int i = 0;
+
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_check_collision_circle_rec_batch_avx2(center, radius, x, y, width, height, count, hits, &hits_count);
+    #endif
+
+    #if defined(RF_SIMD_SSE2)
+        __m128 cx   = _mm_set1_ps(center.x);
+        __m128 cy   = _mm_set1_ps(center.y);
+        __m128 r    = _mm_set1_ps(radius);
+        __m128 r2   = _mm_set1_ps(radius * radius);
+        __m128 half = _mm_set1_ps(0.5f);
+        __m128 sign = _mm_set1_ps(-0.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 hw = _mm_mul_ps(_mm_loadu_ps(width + i), half);
+            __m128 hh = _mm_mul_ps(_mm_loadu_ps(height + i), half);
+            __m128 rec_cx = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(x + i), hw)));
+            __m128 rec_cy = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(y + i), hh)));
+            __m128 dx = _mm_andnot_ps(sign, _mm_sub_ps(cx, rec_cx));
+            __m128 dy = _mm_andnot_ps(sign, _mm_sub_ps(cy, rec_cy));
+
+            __m128 near   = _mm_and_ps(_mm_cmple_ps(dx, _mm_add_ps(hw, r)), _mm_cmple_ps(dy, _mm_add_ps(hh, r)));
+            __m128 inside = _mm_or_ps(_mm_cmple_ps(dx, hw), _mm_cmple_ps(dy, hh));
+            __m128 ex = _mm_sub_ps(dx, hw);
+            __m128 ey = _mm_sub_ps(dy, hh);
+            __m128 corner = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), r2);
+
+            hits_count = rf_append_collision_hits(hits, hits_count, i, (unsigned) _mm_movemask_ps(_mm_and_ps(near, _mm_or_ps(inside, corner))));
+        }
+    #elif defined(RF_SIMD_NEON)
+        float32x4_t cx   = vdupq_n_f32(center.x);
+        float32x4_t cy   = vdupq_n_f32(center.y);
+        float32x4_t r    = vdupq_n_f32(radius);
+        float32x4_t r2   = vdupq_n_f32(radius * radius);
+        float32x4_t half = vdupq_n_f32(0.5f);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t hw = vmulq_f32(vld1q_f32(width + i), half);
+            float32x4_t hh = vmulq_f32(vld1q_f32(height + i), half);
+            float32x4_t rec_cx = vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(vld1q_f32(x + i), hw)));
+            float32x4_t rec_cy = vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(vld1q_f32(y + i), hh)));
+            float32x4_t dx = vabsq_f32(vsubq_f32(cx, rec_cx));
+            float32x4_t dy = vabsq_f32(vsubq_f32(cy, rec_cy));
+
+            uint32x4_t near   = vandq_u32(vcleq_f32(dx, vaddq_f32(hw, r)), vcleq_f32(dy, vaddq_f32(hh, r)));
+            uint32x4_t inside = vorrq_u32(vcleq_f32(dx, hw), vcleq_f32(dy, hh));
+            float32x4_t ex = vsubq_f32(dx, hw);
+            float32x4_t ey = vsubq_f32(dy, hh);
+            uint32x4_t corner = vcleq_f32(vaddq_f32(vmulq_f32(ex, ex), vmulq_f32(ey, ey)), r2);
+
+            hits_count = rf_append_collision_hits(hits, hits_count, i, rf_neon_movemask_u32(vandq_u32(near, vorrq_u32(inside, corner))));
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        if (rf_check_collision_circle_rec(center, radius, (rf_rec) { x[i], y[i], width[i], height[i] })) hits[hits_count++] = i;
+    }
+
+    return hits_count;
+}
+
+// Check collision between a rectangle and count rectangles, writes the indices of the colliding rectangles to hits and returns how many collide
+RF_API int rf_check_collision_recs_batch(rf_rec rec, const float* x, const float* y, const float* width, const float* height, int count, int* hits)
+{
+    int hits_count = 0;
+    int i = 0;
+
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_check_collision_recs_batch_avx2(rec, x, y, width, height, count, hits, &hits_count);
+    #endif
+
+    #if defined(RF_SIMD_SSE2)
+        __m128 x0 = _mm_set1_ps(rec.x);
+        __m128 y0 = _mm_set1_ps(rec.y);
+        __m128 x1 = _mm_set1_ps(rec.x + rec.width);
+        __m128 y1 = _mm_set1_ps(rec.y + rec.height);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 bx = _mm_loadu_ps(x + i);
+            __m128 by = _mm_loadu_ps(y + i);
+            __m128 hit_x = _mm_and_ps(_mm_cmplt_ps(x0, _mm_add_ps(bx, _mm_loadu_ps(width + i))), _mm_cmpgt_ps(x1, bx));
+            __m128 hit_y = _mm_and_ps(_mm_cmplt_ps(y0, _mm_add_ps(by, _mm_loadu_ps(height + i))), _mm_cmpgt_ps(y1, by));
+
+            hits_count = rf_append_collision_hits(hits, hits_count, i, (unsigned) _mm_movemask_ps(_mm_and_ps(hit_x, hit_y)));
+        }
+    #elif defined(RF_SIMD_NEON)
+        float32x4_t x0 = vdupq_n_f32(rec.x);
+        float32x4_t y0 = vdupq_n_f32(rec.y);
+        float32x4_t x1 = vdupq_n_f32(rec.x + rec.width);
+        float32x4_t y1 = vdupq_n_f32(rec.y + rec.height);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t bx = vld1q_f32(x + i);
+            float32x4_t by = vld1q_f32(y + i);
+            uint32x4_t hit_x = vandq_u32(vcltq_f32(x0, vaddq_f32(bx, vld1q_f32(width + i))), vcgtq_f32(x1, bx));
+            uint32x4_t hit_y = vandq_u32(vcltq_f32(y0, vaddq_f32(by, vld1q_f32(height + i))), vcgtq_f32(y1, by));
+
+            hits_count = rf_append_collision_hits(hits, hits_count, i, rf_neon_movemask_u32(vandq_u32(hit_x, hit_y)));
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        if (rf_check_collision_recs(rec, (rf_rec) { x[i], y[i], width[i], height[i] })) hits[hits_count++] = i;
+    }
+
+    return hits_count;
+}
+
+/*
+ Batch movement moves points with their coordinates and speeds in separate arrays, 4 (SSE2, NEON) or 8 (AVX2) at once.
+ A point that leaves the bounds by more than its margin is wrapped to the opposite side, just outside by its margin.
+ The results are the same as doing it one point at a time with rf_wrap_coordinate.
+*/
+
+RF_INTERNAL inline float rf_wrap_coordinate(float v, float min, float max, float margin)
+{
+    if (v > max + margin) return min - margin;
+    if (v < min - margin) return max + margin;
+    return v;
+}
+
+#if defined(RF_SIMD_AVX2)
+RF_INTERNAL RF_AVX2_FUNC inline __m256 rf_avx2_wrap_coordinate(__m256 v, __m256 min, __m256 max, __m256 margin)
+{
+    __m256 low  = _mm256_sub_ps(min, margin);
+    __m256 high = _mm256_add_ps(max, margin);
+    __m256 above = _mm256_cmp_ps(v, high, _CMP_GT_OQ);
+    __m256 below = _mm256_andnot_ps(above, _mm256_cmp_ps(v, low, _CMP_LT_OQ));
+
+    return _mm256_blendv_ps(_mm256_blendv_ps(v, high, below), low, above);
+}
+
+RF_INTERNAL RF_AVX2_FUNC int rf_move_wrap_batch_avx2(float* x, float* y, const float* speed_x, const float* speed_y, const float* margins, int count, rf_rec bounds)
+{
+    const __m256 min_x = _mm256_set1_ps(bounds.x);
+    const __m256 min_y = _mm256_set1_ps(bounds.y);
+    const __m256 max_x = _mm256_set1_ps(bounds.x + bounds.width);
+    const __m256 max_y = _mm256_set1_ps(bounds.y + bounds.height);
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 margin = _mm256_loadu_ps(margins + i);
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(speed_x + i));
+        __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(speed_y + i));
+
+        _mm256_storeu_ps(x + i, rf_avx2_wrap_coordinate(px, min_x, max_x, margin));
+        _mm256_storeu_ps(y + i, rf_avx2_wrap_coordinate(py, min_y, max_y, margin));
+    }
+
+    return i;
+}
+#endif
+
+#if defined(RF_SIMD_SSE2)
+RF_INTERNAL inline __m128 rf_sse2_wrap_coordinate(__m128 v, __m128 min, __m128 max, __m128 margin)
+{
+    __m128 low  = _mm_sub_ps(min, margin);
+    __m128 high = _mm_add_ps(max, margin);
+    __m128 above = _mm_cmpgt_ps(v, high);
+    __m128 below = _mm_andnot_ps(above, _mm_cmplt_ps(v, low));
+    __m128 keep  = _mm_andnot_ps(_mm_or_ps(above, below), v);
+
+    return _mm_or_ps(keep, _mm_or_ps(_mm_and_ps(above, low), _mm_and_ps(below, high)));
+}
+#endif
+
+#if defined(RF_SIMD_NEON)
+RF_INTERNAL inline float32x4_t rf_neon_wrap_coordinate(float32x4_t v, float32x4_t min, float32x4_t max, float32x4_t margin)
+{
+    float32x4_t low  = vsubq_f32(min, margin);
+    float32x4_t high = vaddq_f32(max, margin);
+
+    return vbslq_f32(vcgtq_f32(v, high), low, vbslq_f32(vcltq_f32(v, low), high, v));
+}
+#endif
+
+// Move count points by their speed, the points that leave bounds by more than their margin are wrapped to the opposite side
+RF_API void rf_move_wrap_batch(float* x, float* y, const float* speed_x, const float* speed_y, const float* margins, int count, rf_rec bounds)
+{
+    int i = 0;
+
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_move_wrap_batch_avx2(x, y, speed_x, speed_y, margins, count, bounds);
+    #endif
+
+    #if defined(RF_SIMD_SSE2)
+        __m128 min_x = _mm_set1_ps(bounds.x);
+        __m128 min_y = _mm_set1_ps(bounds.y);
+        __m128 max_x = _mm_set1_ps(bounds.x + bounds.width);
+        __m128 max_y = _mm_set1_ps(bounds.y + bounds.height);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 margin = _mm_loadu_ps(margins + i);
+            __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(speed_x + i));
+            __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(speed_y + i));
+
+            _mm_storeu_ps(x + i, rf_sse2_wrap_coordinate(px, min_x, max_x, margin));
+            _mm_storeu_ps(y + i, rf_sse2_wrap_coordinate(py, min_y, max_y, margin));
+        }
+    #elif defined(RF_SIMD_NEON)
+        float32x4_t min_x = vdupq_n_f32(bounds.x);
+        float32x4_t min_y = vdupq_n_f32(bounds.y);
+        float32x4_t max_x = vdupq_n_f32(bounds.x + bounds.width);
+        float32x4_t max_y = vdupq_n_f32(bounds.y + bounds.height);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t margin = vld1q_f32(margins + i);
+            float32x4_t px = vaddq_f32(vld1q_f32(x + i), vld1q_f32(speed_x + i));
+            float32x4_t py = vaddq_f32(vld1q_f32(y + i), vld1q_f32(speed_y + i));
+
+            vst1q_f32(x + i, rf_neon_wrap_coordinate(px, min_x, max_x, margin));
+            vst1q_f32(y + i, rf_neon_wrap_coordinate(py, min_y, max_y, margin));
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        x[i] = rf_wrap_coordinate(x[i] + speed_x[i], bounds.x, bounds.x + bounds.width, margins[i]);
+        y[i] = rf_wrap_coordinate(y[i] + speed_y[i], bounds.y, bounds.y + bounds.height, margins[i]);
+    }
+}
+
 // Get collision rectangle for two rectangles collision
 rf_rec rf_get_collision_rec(rf_rec rec1, rf_rec rec2)
 {
@@ -3535,6 +4671,274 @@ RF_API rf_ray_hit_info rf_collision_ray_ground(rf_ray ray, float ground_height)
     return result;
 }
 
+#pragma endregion
+
+#pragma region spatial grid
+
+// Cell of a coordinate along one axis, coordinates outside of the grid go to the border cells
+RF_INTERNAL inline int rf_spatial_grid_cell(float v, float origin, float cell_size, int cells)
+{
+    float cell = floorf((v - origin) / cell_size);
+
+    if (!(cell >= 0)) return 0;
+    if (cell >= cells) return cells - 1;
+
+    return (int) cell;
+}
+
+// Unlike rf_check_collision_recs touching recs overlap, so the grid never rejects a pair that a narrow test would accept
+RF_INTERNAL inline bool rf_spatial_grid_overlap(rf_rec a, rf_rec b)
+{
+    return a.x <= b.x + b.width && b.x <= a.x + a.width && a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
+
+RF_API rf_spatial_grid rf_load_spatial_grid(rf_rec bounds, float cell_size, int capacity, rf_allocator allocator)
+{
+    rf_spatial_grid result = {0};
+
+    if (!(cell_size > 0) || !(bounds.width > 0) || !(bounds.height > 0) || capacity < 0)
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Invalid spatial grid. Bounds: %f x %f, cell size: %f, capacity: %d.", bounds.width, bounds.height, cell_size, capacity);
+        return result;
+    }
+
+    int cells_x = rf_max_i(1, (int) ceilf(bounds.width / cell_size));
+    int cells_y = rf_max_i(1, (int) ceilf(bounds.height / cell_size));
+
+    result = (rf_spatial_grid)
+    {
+        .bounds           = bounds,
+        .cell_size        = cell_size,
+        .cells_x          = cells_x,
+        .cells_y          = cells_y,
+        .recs             = RF_ALLOC(allocator, capacity * sizeof(rf_rec)),
+        .capacity         = capacity,
+        .cell_start       = RF_ALLOC(allocator, (cells_x * cells_y + 1) * sizeof(int)),
+        .cell_entries     = RF_ALLOC(allocator, capacity * sizeof(int)),
+        .entries_capacity = capacity,
+        .allocator        = allocator,
+        .valid            = true,
+    };
+
+    if (!result.cell_start || (capacity && (!result.recs || !result.cell_entries)))
+    {
+        RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of a spatial grid with %d cells and a capacity of %d failed.", cells_x * cells_y, capacity);
+        rf_unload_spatial_grid(result);
+        return (rf_spatial_grid) {0};
+    }
+
+    memset(result.cell_start, 0, (cells_x * cells_y + 1) * sizeof(int));
+
+    return result;
+}
+
+/*
+ * Replaces the entities of the grid, the index of an entity is its index in recs.
+ * Entities are listed in every cell their rec touches and sorted by cell with a counting sort, so a rebuild every frame is O(count + cells).
+ * The buffers of the grid grow with its allocator when needed.
+ */
+RF_API bool rf_spatial_grid_build(rf_spatial_grid* grid, const rf_rec* recs, int count)
+{
+    if (!grid || !grid->valid || count < 0 || (count && !recs))
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Invalid arguments to rf_spatial_grid_build. Count: %d.", count);
+        return false;
+    }
+
+    if (count > grid->capacity)
+    {
+        int new_capacity = rf_max_i(count, grid->capacity * 2);
+        rf_rec* new_recs = RF_REALLOC(grid->allocator, grid->recs, new_capacity * sizeof(rf_rec), grid->capacity * sizeof(rf_rec));
+
+        if (!new_recs)
+        {
+            RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", new_capacity * sizeof(rf_rec));
+            return false;
+        }
+
+        grid->recs = new_recs;
+        grid->capacity = new_capacity;
+    }
+
+    if (count) memcpy(grid->recs, recs, count * sizeof(rf_rec));
+    grid->count = count;
+
+    const float origin_x  = grid->bounds.x;
+    const float origin_y  = grid->bounds.y;
+    const float cell_size = grid->cell_size;
+    const int   cells_x   = grid->cells_x;
+    const int   cells_y   = grid->cells_y;
+    const int   cells     = cells_x * cells_y;
+    int* cell_start = grid->cell_start;
+
+    // Count the entities of every cell one slot to the right so the prefix sum gives the start of each cell
+    memset(cell_start, 0, (cells + 1) * sizeof(int));
+    int entries = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        rf_rec rec = grid->recs[i];
+        int x0 = rf_spatial_grid_cell(rec.x, origin_x, cell_size, cells_x);
+        int x1 = rf_spatial_grid_cell(rec.x + rec.width, origin_x, cell_size, cells_x);
+        int y0 = rf_spatial_grid_cell(rec.y, origin_y, cell_size, cells_y);
+        int y1 = rf_spatial_grid_cell(rec.y + rec.height, origin_y, cell_size, cells_y);
+
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++) cell_start[y * cells_x + x + 1]++;
+        }
+
+        entries += (x1 - x0 + 1) * (y1 - y0 + 1);
+    }
+
+    if (entries > grid->entries_capacity)
+    {
+        int new_capacity = rf_max_i(entries, grid->entries_capacity * 2);
+        int* new_entries = RF_REALLOC(grid->allocator, grid->cell_entries, new_capacity * sizeof(int), grid->entries_capacity * sizeof(int));
+
+        if (!new_entries)
+        {
+            RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", new_capacity * sizeof(int));
+            memset(cell_start, 0, (cells + 1) * sizeof(int));
+            grid->count = 0;
+            return false;
+        }
+
+        grid->cell_entries = new_entries;
+        grid->entries_capacity = new_capacity;
+    }
+
+    for (int c = 1; c <= cells; c++) cell_start[c] += cell_start[c - 1];
+
+    // Scatter, every cell start moves to the start of the next cell and is shifted back after
+    for (int i = 0; i < count; i++)
+    {
+        rf_rec rec = grid->recs[i];
+        int x0 = rf_spatial_grid_cell(rec.x, origin_x, cell_size, cells_x);
+        int x1 = rf_spatial_grid_cell(rec.x + rec.width, origin_x, cell_size, cells_x);
+        int y0 = rf_spatial_grid_cell(rec.y, origin_y, cell_size, cells_y);
+        int y1 = rf_spatial_grid_cell(rec.y + rec.height, origin_y, cell_size, cells_y);
+
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++) grid->cell_entries[cell_start[y * cells_x + x]++] = i;
+        }
+    }
+
+    memmove(cell_start + 1, cell_start, cells * sizeof(int));
+    cell_start[0] = 0;
+
+    return true;
+}
+
+/*
+ * Writes the indices of the entities whose rec overlaps area to dst and returns how many were written, at most dst_size.
+ * An entity that spans several cells is only reported from the first cell it shares with area, so every entity is reported once.
+ * The indices are sorted by cell and not by index.
+ */
+RF_API int rf_spatial_grid_query(const rf_spatial_grid* grid, rf_rec area, int* dst, int dst_size)
+{
+    if (!grid || !grid->valid || !dst) return 0;
+
+    const float origin_x  = grid->bounds.x;
+    const float origin_y  = grid->bounds.y;
+    const float cell_size = grid->cell_size;
+    const int   cells_x   = grid->cells_x;
+    const int   cells_y   = grid->cells_y;
+
+    int x0 = rf_spatial_grid_cell(area.x, origin_x, cell_size, cells_x);
+    int x1 = rf_spatial_grid_cell(area.x + area.width, origin_x, cell_size, cells_x);
+    int y0 = rf_spatial_grid_cell(area.y, origin_y, cell_size, cells_y);
+    int y1 = rf_spatial_grid_cell(area.y + area.height, origin_y, cell_size, cells_y);
+
+    int found = 0;
+
+    for (int y = y0; y <= y1; y++)
+    {
+        for (int x = x0; x <= x1; x++)
+        {
+            int cell = y * cells_x + x;
+
+            for (int e = grid->cell_start[cell]; e < grid->cell_start[cell + 1]; e++)
+            {
+                int i = grid->cell_entries[e];
+                rf_rec rec = grid->recs[i];
+
+                if (!rf_spatial_grid_overlap(rec, area)) continue;
+
+                int first_x = rf_max_i(x0, rf_spatial_grid_cell(rec.x, origin_x, cell_size, cells_x));
+                int first_y = rf_max_i(y0, rf_spatial_grid_cell(rec.y, origin_y, cell_size, cells_y));
+                if (first_x != x || first_y != y) continue;
+
+                if (found == dst_size) return found;
+                dst[found++] = i;
+            }
+        }
+    }
+
+    return found;
+}
+
+/*
+ * Writes every pair of entities whose recs overlap to dst and returns how many were written, at most dst_size.
+ * A pair is only reported from the first cell both entities are in, a is always smaller than b.
+ */
+RF_API int rf_spatial_grid_pairs(const rf_spatial_grid* grid, rf_spatial_grid_pair* dst, int dst_size)
+{
+    if (!grid || !grid->valid || !dst) return 0;
+
+    const float origin_x  = grid->bounds.x;
+    const float origin_y  = grid->bounds.y;
+    const float cell_size = grid->cell_size;
+    const int   cells_x   = grid->cells_x;
+    const int   cells_y   = grid->cells_y;
+
+    int found = 0;
+
+    for (int y = 0; y < cells_y; y++)
+    {
+        for (int x = 0; x < cells_x; x++)
+        {
+            int cell  = y * cells_x + x;
+            int start = grid->cell_start[cell];
+            int end   = grid->cell_start[cell + 1];
+
+            for (int e = start; e < end; e++)
+            {
+                int a = grid->cell_entries[e];
+                rf_rec rec_a = grid->recs[a];
+                int a_x = rf_spatial_grid_cell(rec_a.x, origin_x, cell_size, cells_x);
+                int a_y = rf_spatial_grid_cell(rec_a.y, origin_y, cell_size, cells_y);
+
+                // Entries of a cell are sorted by index so b is always bigger than a
+                for (int f = e + 1; f < end; f++)
+                {
+                    int b = grid->cell_entries[f];
+                    rf_rec rec_b = grid->recs[b];
+
+                    if (!rf_spatial_grid_overlap(rec_a, rec_b)) continue;
+
+                    int first_x = rf_max_i(a_x, rf_spatial_grid_cell(rec_b.x, origin_x, cell_size, cells_x));
+                    int first_y = rf_max_i(a_y, rf_spatial_grid_cell(rec_b.y, origin_y, cell_size, cells_y));
+                    if (first_x != x || first_y != y) continue;
+
+                    if (found == dst_size) return found;
+                    dst[found++] = (rf_spatial_grid_pair) { a, b };
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+RF_API void rf_unload_spatial_grid(rf_spatial_grid grid)
+{
+    RF_FREE(grid.allocator, grid.recs);
+    RF_FREE(grid.allocator, grid.cell_start);
+    RF_FREE(grid.allocator, grid.cell_entries);
+}
+
 #pragma endregion
 /*** End of inlined file: rayfork-math.c ***/
 
@@ -4077,6 +5481,14 @@ RF_API void rf_update_camera3d(rf_camera3d* camera, rf_camera3d_state* state, rf
 #define STBI_ASSERT(it)                     RF_ASSERT(it)
 #define STBIDEF                             RF_INTERNAL
 
+#if defined(RF_NO_SIMD) && !defined(STBI_NO_SIMD)
+    #define STBI_NO_SIMD
+#endif
+
+#if defined(RF_SIMD_NEON) && !defined(STBI_NEON)
+    #define STBI_NEON
+#endif
+
 /*** Start of inlined file: stb_image.h ***/
 #ifndef STBI_INCLUDE_STB_IMAGE_H
 #define STBI_INCLUDE_STB_IMAGE_H
@@ -4562,12 +5974,14 @@ typedef unsigned short stbi__uint16;
 typedef   signed short stbi__int16;
 typedef unsigned int   stbi__uint32;
 typedef   signed int   stbi__int32;
+typedef unsigned __int64 stbi__uint64;
 #else
 #include <stdint.h>
 typedef uint16_t stbi__uint16;
 typedef int16_t  stbi__int16;
 typedef uint32_t stbi__uint32;
 typedef int32_t  stbi__int32;
+typedef uint64_t stbi__uint64;
 #endif
 
 // should produce compiler error if size is wrong
@@ -7925,7 +9339,7 @@ static int stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp)
 #ifndef STBI_NO_ZLIB
 
 // fast-way is faster to check than jpeg huffman, but slow way is slower
-#define STBI__ZFAST_BITS  9 // accelerate all cases in default tables
+#define STBI__ZFAST_BITS  10 // accelerate all cases in default tables, and most codes of dynamic tables
 #define STBI__ZFAST_MASK  ((1 << STBI__ZFAST_BITS) - 1)
 
 // zlib-style huffman encoding
@@ -8034,8 +9448,28 @@ stbi_inline static stbi_uc stbi__zget8(stbi__zbuf *z)
    return stbi__zeof(z) ? 0 : *z->zbuffer++;
 }
 
+stbi_inline static stbi__uint32 stbi__zload32le(const stbi_uc *p)
+{
+   return (stbi__uint32) p[0] | ((stbi__uint32) p[1] << 8) | ((stbi__uint32) p[2] << 16) | ((stbi__uint32) p[3] << 24);
+}
+
+stbi_inline static stbi__uint64 stbi__zload64le(const stbi_uc *p)
+{
+   return (stbi__uint64) stbi__zload32le(p) | ((stbi__uint64) stbi__zload32le(p + 4) << 32);
+}
+
 static void stbi__fill_bits(stbi__zbuf *z)
 {
+   if (z->num_bits <= 24 && z->zbuffer_end - z->zbuffer >= 4 && z->code_buffer < (1U << z->num_bits)) {
+      // same as the byte loop below, but with one load: add whole bytes until there are more than 24 bits
+      int n = (32 - z->num_bits) >> 3;
+      int num_bits = z->num_bits + 8 * n;
+      stbi__uint64 mask = ((stbi__uint64) 1 << num_bits) - 1;
+      z->code_buffer |= (stbi__uint32) (((stbi__uint64) stbi__zload32le(z->zbuffer) << z->num_bits) & mask);
+      z->zbuffer += n;
+      z->num_bits = num_bits;
+      return;
+   }
    do {
       if (z->code_buffer >= (1U << z->num_bits)) {
         z->zbuffer = z->zbuffer_end;  /* treat this as EOF so we fail. */
@@ -8130,11 +9564,135 @@ static const int stbi__zdist_base[32] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129
 static const int stbi__zdist_extra[32] =
 { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
 
+// decodes a symbol from the low bits of a 64 bit buffer that has at least 16 valid bits, returns -1 for invalid codes
+stbi_inline static int stbi__zhuffman_decode64(stbi__zhuffman *z, stbi__uint64 bits, int *size)
+{
+   int b,s,k;
+   b = z->fast[bits & STBI__ZFAST_MASK];
+   if (b) {
+      *size = b >> 9;
+      return b & 511;
+   }
+   k = stbi__bit_reverse((int) (bits & 0xffff), 16);
+   for (s=STBI__ZFAST_BITS+1; ; ++s)
+      if (k < z->maxcode[s])
+         break;
+   if (s >= 16) return -1;
+   b = (k >> (16-s)) - z->firstcode[s] + z->firstsymbol[s];
+   if ((unsigned int) b >= sizeof (z->size)) return -1;
+   if (z->size[b] != s) return -1;
+   *size = s;
+   return z->value[b];
+}
+
+// a longest symbol is 15+5 bits of length and 15+13 bits of distance, so a refill to 56 bits covers it
+#define STBI__ZFAST_REFILL_BITS  48
+// a match copies at most 258 bytes, and the copy loop may write up to 7 bytes past the end of it
+#define STBI__ZFAST_OUT_SLACK    (258 + 8)
+
+// Inflates with a local 64 bit bit buffer as long as there are 8 bytes of input left and room for the largest match.
+// Returns 1 at the end of the block, 0 on error and 2 when the caller has to continue byte by byte.
+static int stbi__parse_huffman_block_fast(stbi__zbuf *a, char **zout_ptr)
+{
+   char *zout = *zout_ptr;
+   stbi_uc *in = a->zbuffer;
+   stbi__uint64 bits = a->code_buffer;
+   int num_bits = a->num_bits;
+   int result = 2;
+
+   while (a->zbuffer_end - in >= 8 && a->zout_end - zout >= STBI__ZFAST_OUT_SLACK) {
+      int z, size, len, dist;
+      if (num_bits < STBI__ZFAST_REFILL_BITS) {
+         // the bits above num_bits are the low bits of the next byte, so or-ing them in again on the next refill is harmless
+         bits |= stbi__zload64le(in) << num_bits;
+         in += (63 - num_bits) >> 3;
+         num_bits |= 56;
+      }
+
+      z = stbi__zhuffman_decode64(&a->z_length, bits, &size);
+      if (z < 0) { result = stbi__err("bad huffman code","Corrupt PNG"); break; }
+      bits >>= size;
+      num_bits -= size;
+
+      if (z < 256) {
+         *zout++ = (char) z;
+         // literals are common and short, take more of them while there are enough bits for one
+         while (num_bits >= 16 && a->zout_end - zout >= STBI__ZFAST_OUT_SLACK) {
+            z = stbi__zhuffman_decode64(&a->z_length, bits, &size);
+            if (z < 0 || z >= 256) break;
+            bits >>= size;
+            num_bits -= size;
+            *zout++ = (char) z;
+         }
+         continue;
+      }
+
+      if (z == 256) { result = 1; break; }
+
+      z -= 257;
+      len = stbi__zlength_base[z];
+      if (stbi__zlength_extra[z]) {
+         len += (int) (bits & ((1u << stbi__zlength_extra[z]) - 1));
+         bits >>= stbi__zlength_extra[z];
+         num_bits -= stbi__zlength_extra[z];
+      }
+
+      z = stbi__zhuffman_decode64(&a->z_distance, bits, &size);
+      if (z < 0) { result = stbi__err("bad huffman code","Corrupt PNG"); break; }
+      bits >>= size;
+      num_bits -= size;
+
+      dist = stbi__zdist_base[z];
+      if (stbi__zdist_extra[z]) {
+         dist += (int) (bits & ((1u << stbi__zdist_extra[z]) - 1));
+         bits >>= stbi__zdist_extra[z];
+         num_bits -= stbi__zdist_extra[z];
+      }
+
+      if (zout - a->zout_start < dist) { result = stbi__err("bad dist","Corrupt PNG"); break; }
+
+      {
+         stbi_uc *p = (stbi_uc *) (zout - dist);
+         if (dist == 1) {
+            stbi_uc v = *p;
+            memset(zout, v, len);
+            zout += len;
+         } else if (dist >= 8) {
+            // 8 byte chunks never read bytes of the same chunk that they write
+            char *end = zout + len;
+            do {
+               memcpy(zout, p, 8);
+               zout += 8;
+               p += 8;
+            } while (zout < end);
+            zout = end;
+         } else {
+            if (len) { do *zout++ = *p++; while (--len); }
+         }
+      }
+   }
+
+   // hand the whole bytes that were read ahead back to the input
+   in -= num_bits >> 3;
+   num_bits &= 7;
+   a->zbuffer = in;
+   a->code_buffer = (stbi__uint32) (bits & ((1u << num_bits) - 1));
+   a->num_bits = num_bits;
+   a->zout = zout;
+   *zout_ptr = zout;
+   return result;
+}
+
 static int stbi__parse_huffman_block(stbi__zbuf *a)
 {
    char *zout = a->zout;
    for(;;) {
-      int z = stbi__zhuffman_decode(a, &a->z_length);
+      int z;
+      if (a->zbuffer_end - a->zbuffer >= 8 && a->zout_end - zout >= STBI__ZFAST_OUT_SLACK) {
+         int r = stbi__parse_huffman_block_fast(a, &zout);
+         if (r != 2) return r;
+      }
+      z = stbi__zhuffman_decode(a, &a->z_length);
       if (z < 256) {
          if (z < 0) return stbi__err("bad huffman code","Corrupt PNG"); // error in huffman codes
          if (zout >= a->zout_end) {
@@ -8482,6 +10040,169 @@ static int stbi__paeth(int a, int b, int c)
 
 static const stbi_uc stbi__depth_scale_table[9] = { 0, 0xff, 0x55, 0, 0x11, 0,0,0, 0x01 };
 
+#if defined(STBI_SSE2) || defined(STBI_NEON)
+// The filters only depend on the byte filter_bytes before, so rows of 3 and 4 byte pixels are unfiltered a whole pixel at a time.
+// The results are the same as the scalar loops, the avg filter uses floor((a + b) / 2) and paeth the same tie breaking.
+
+#ifdef STBI_SSE2
+stbi_inline static __m128i stbi__png_load_pixel(const stbi_uc *p, int n)
+{
+   stbi__uint32 v;
+   if (n == 4) memcpy(&v, p, 4);
+   else v = p[0] | (p[1] << 8) | ((stbi__uint32) p[2] << 16);
+   return _mm_cvtsi32_si128((int) v);
+}
+
+stbi_inline static void stbi__png_store_pixel(stbi_uc *p, __m128i v, int n)
+{
+   stbi__uint32 x = (stbi__uint32) _mm_cvtsi128_si32(v);
+   if (n == 4) memcpy(p, &x, 4);
+   else { p[0] = STBI__BYTECAST(x); p[1] = STBI__BYTECAST(x >> 8); p[2] = STBI__BYTECAST(x >> 16); }
+}
+
+stbi_inline static __m128i stbi__png_abs16(__m128i x)
+{
+   return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+stbi_inline static void stbi__png_unfilter_pixels(int filter, stbi_uc *cur, const stbi_uc *raw, const stbi_uc *prior, int nk, int n)
+{
+   __m128i zero = _mm_setzero_si128();
+   __m128i a = stbi__png_load_pixel(cur - n, n);
+   int k;
+   switch (filter) {
+      case STBI__F_sub:
+      case STBI__F_paeth_first:
+         for (k=0; k < nk; k += n) {
+            a = _mm_add_epi8(a, stbi__png_load_pixel(raw + k, n));
+            stbi__png_store_pixel(cur + k, a, n);
+         }
+         break;
+      case STBI__F_avg:
+         for (k=0; k < nk; k += n) {
+            __m128i b = stbi__png_load_pixel(prior + k, n);
+            __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+            a = _mm_add_epi8(avg, stbi__png_load_pixel(raw + k, n));
+            stbi__png_store_pixel(cur + k, a, n);
+         }
+         break;
+      case STBI__F_paeth: {
+         __m128i c = _mm_unpacklo_epi8(stbi__png_load_pixel(prior - n, n), zero);
+         a = _mm_unpacklo_epi8(a, zero);
+         for (k=0; k < nk; k += n) {
+            __m128i b  = _mm_unpacklo_epi8(stbi__png_load_pixel(prior + k, n), zero);
+            __m128i bc = _mm_sub_epi16(b, c);
+            __m128i ac = _mm_sub_epi16(a, c);
+            __m128i pa = stbi__png_abs16(bc);
+            __m128i pb = stbi__png_abs16(ac);
+            __m128i pc = stbi__png_abs16(_mm_add_epi16(bc, ac));
+            __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            __m128i use_a = _mm_cmpeq_epi16(pa, smallest);
+            __m128i use_b = _mm_cmpeq_epi16(pb, smallest);
+            __m128i nearest = _mm_or_si128(_mm_and_si128(use_b, b), _mm_andnot_si128(use_b, c));
+            __m128i x;
+            nearest = _mm_or_si128(_mm_and_si128(use_a, a), _mm_andnot_si128(use_a, nearest));
+            x = _mm_add_epi8(_mm_packus_epi16(nearest, nearest), stbi__png_load_pixel(raw + k, n));
+            stbi__png_store_pixel(cur + k, x, n);
+            a = _mm_unpacklo_epi8(x, zero);
+            c = b;
+         }
+      } break;
+   }
+}
+
+stbi_inline static void stbi__png_unfilter_up(stbi_uc *cur, const stbi_uc *raw, const stbi_uc *prior, int nk)
+{
+   int k = 0;
+   for (; k + 16 <= nk; k += 16)
+      _mm_storeu_si128((__m128i *) (cur + k), _mm_add_epi8(_mm_loadu_si128((const __m128i *) (raw + k)), _mm_loadu_si128((const __m128i *) (prior + k))));
+   for (; k < nk; ++k)
+      cur[k] = STBI__BYTECAST(raw[k] + prior[k]);
+}
+#else // STBI_NEON
+stbi_inline static uint8x8_t stbi__png_load_pixel(const stbi_uc *p, int n)
+{
+   stbi__uint32 v;
+   if (n == 4) memcpy(&v, p, 4);
+   else v = p[0] | (p[1] << 8) | ((stbi__uint32) p[2] << 16);
+   return vreinterpret_u8_u32(vdup_n_u32(v));
+}
+
+stbi_inline static void stbi__png_store_pixel(stbi_uc *p, uint8x8_t v, int n)
+{
+   stbi__uint32 x = vget_lane_u32(vreinterpret_u32_u8(v), 0);
+   if (n == 4) memcpy(p, &x, 4);
+   else { p[0] = STBI__BYTECAST(x); p[1] = STBI__BYTECAST(x >> 8); p[2] = STBI__BYTECAST(x >> 16); }
+}
+
+stbi_inline static void stbi__png_unfilter_pixels(int filter, stbi_uc *cur, const stbi_uc *raw, const stbi_uc *prior, int nk, int n)
+{
+   uint8x8_t a = stbi__png_load_pixel(cur - n, n);
+   int k;
+   switch (filter) {
+      case STBI__F_sub:
+      case STBI__F_paeth_first:
+         for (k=0; k < nk; k += n) {
+            a = vadd_u8(a, stbi__png_load_pixel(raw + k, n));
+            stbi__png_store_pixel(cur + k, a, n);
+         }
+         break;
+      case STBI__F_avg:
+         for (k=0; k < nk; k += n) {
+            a = vadd_u8(vhadd_u8(a, stbi__png_load_pixel(prior + k, n)), stbi__png_load_pixel(raw + k, n));
+            stbi__png_store_pixel(cur + k, a, n);
+         }
+         break;
+      case STBI__F_paeth: {
+         int16x8_t c = vreinterpretq_s16_u16(vmovl_u8(stbi__png_load_pixel(prior - n, n)));
+         int16x8_t a16 = vreinterpretq_s16_u16(vmovl_u8(a));
+         for (k=0; k < nk; k += n) {
+            int16x8_t b  = vreinterpretq_s16_u16(vmovl_u8(stbi__png_load_pixel(prior + k, n)));
+            int16x8_t bc = vsubq_s16(b, c);
+            int16x8_t ac = vsubq_s16(a16, c);
+            int16x8_t pa = vabsq_s16(bc);
+            int16x8_t pb = vabsq_s16(ac);
+            int16x8_t pc = vabsq_s16(vaddq_s16(bc, ac));
+            int16x8_t smallest = vminq_s16(pc, vminq_s16(pa, pb));
+            int16x8_t nearest = vbslq_s16(vceqq_s16(pb, smallest), b, c);
+            uint8x8_t x;
+            nearest = vbslq_s16(vceqq_s16(pa, smallest), a16, nearest);
+            x = vadd_u8(vmovn_u16(vreinterpretq_u16_s16(nearest)), stbi__png_load_pixel(raw + k, n));
+            stbi__png_store_pixel(cur + k, x, n);
+            a16 = vreinterpretq_s16_u16(vmovl_u8(x));
+            c = b;
+         }
+      } break;
+   }
+}
+
+stbi_inline static void stbi__png_unfilter_up(stbi_uc *cur, const stbi_uc *raw, const stbi_uc *prior, int nk)
+{
+   int k = 0;
+   for (; k + 16 <= nk; k += 16)
+      vst1q_u8(cur + k, vaddq_u8(vld1q_u8(raw + k), vld1q_u8(prior + k)));
+   for (; k < nk; ++k)
+      cur[k] = STBI__BYTECAST(raw[k] + prior[k]);
+}
+#endif
+
+// Unfilters the nk bytes after the first pixel of a row, returns 0 for the filters and pixel sizes that are left to the scalar loops
+static int stbi__png_unfilter_row_simd(int filter, stbi_uc *cur, const stbi_uc *raw, const stbi_uc *prior, int nk, int filter_bytes)
+{
+   if (filter == STBI__F_up) {
+      stbi__png_unfilter_up(cur, raw, prior, nk);
+      return 1;
+   }
+   if (filter != STBI__F_sub && filter != STBI__F_avg && filter != STBI__F_paeth && filter != STBI__F_paeth_first)
+      return 0;
+
+   // constant pixel sizes so the loads and stores become single moves
+   if (filter_bytes == 4) { stbi__png_unfilter_pixels(filter, cur, raw, prior, nk, 4); return 1; }
+   if (filter_bytes == 3) { stbi__png_unfilter_pixels(filter, cur, raw, prior, nk, 3); return 1; }
+   return 0;
+}
+#endif
+
 // create the png data from post-deflated data
 static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 raw_len, int out_n, stbi__uint32 x, stbi__uint32 y, int depth, int color)
 {
@@ -8567,6 +10288,9 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          #define STBI__CASE(f) \
              case f:     \
                 for (k=0; k < nk; ++k)
+         #if defined(STBI_SSE2) || defined(STBI_NEON)
+         if (!stbi__png_unfilter_row_simd(filter, cur, raw, prior, nk, filter_bytes))
+         #endif
          switch (filter) {
             // "none" filter turns into a memcpy here; make that explicit.
             case STBI__F_none:         memcpy(cur, raw, nk); break;
@@ -10764,7 +12488,7 @@ static void *stbi__load_gif_main(stbi__context *s, int **delays, int *x, int *y,
             }
             memcpy( out + ((layers - 1) * stride), u, stride );
             if (layers >= 2) {
-               two_back = out - 2 * stride;
+               two_back = out + (layers - 2) * stride;
             }
 
             if (delays) {
@@ -11761,10 +13485,6 @@ typedef uint32_t stbir_uint32;
 //       you can change the compile-time defaults by #defining STBIR_DEFAULT_FILTER_UPSAMPLE
 //       and STBIR_DEFAULT_FILTER_DOWNSAMPLE, or you can use the medium-complexity API.
 
-STBIRDEF int stbir_resize_uint8(     const unsigned char *input_pixels , int input_w , int input_h , int input_stride_in_bytes,
-                                     unsigned char *output_pixels, int output_w, int output_h, int output_stride_in_bytes,
-                                     int num_channels);
-
 STBIRDEF int stbir_resize_float(     const float *input_pixels , int input_w , int input_h , int input_stride_in_bytes,
                                      float *output_pixels, int output_w, int output_h, int output_stride_in_bytes,
                                      int num_channels);
@@ -13976,16 +15696,6 @@ static int stbir__resize_arbitrary(
     return result;
 }
 
-STBIRDEF int stbir_resize_uint8(     const unsigned char *input_pixels , int input_w , int input_h , int input_stride_in_bytes,
-                                           unsigned char *output_pixels, int output_w, int output_h, int output_stride_in_bytes,
-                                     int num_channels)
-{
-    return stbir__resize_arbitrary(NULL, input_pixels, input_w, input_h, input_stride_in_bytes,
-        output_pixels, output_w, output_h, output_stride_in_bytes,
-        0,0,1,1,NULL,num_channels,-1,0, STBIR_TYPE_UINT8, STBIR_FILTER_DEFAULT, STBIR_FILTER_DEFAULT,
-        STBIR_EDGE_CLAMP, STBIR_EDGE_CLAMP, STBIR_COLORSPACE_LINEAR);
-}
-
 STBIRDEF int stbir_resize_float(     const float *input_pixels , int input_w , int input_h , int input_stride_in_bytes,
                                            float *output_pixels, int output_w, int output_h, int output_stride_in_bytes,
                                      int num_channels)
@@ -15321,60 +17031,577 @@ RF_API rf_vec4* rf_image_compute_pixels_to_normalized(rf_image image, rf_allocat
     return result;
 }
 
-// Extract color palette from image to maximum size
-RF_API void rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size)
+#pragma region color map
+
+// Integer hash (https://nullprogram.com/blog/2018/07/31/), used by the color map and so that image generators can run out of order without sharing a rng
+RF_INTERNAL inline unsigned int rf_hash_u32(unsigned int x)
 {
-    if (rf_is_uncompressed_format(image.format))
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+/*
+ Open addressed hash map from rgba32 colors (packed in a 32 bit key) to a 32 bit value, with linear probing.
+ Key 0 marks empty slots, the color with key 0 (transparent black) is stored on the side.
+*/
+typedef struct rf_color_map_entry
+{
+    uint32_t key;
+    uint32_t value;
+} rf_color_map_entry;
+
+typedef struct rf_color_map
+{
+    rf_color_map_entry* entries;
+    rf_int              capacity; // Always a power of 2
+    rf_int              count;
+    bool                has_zero_key;
+    uint32_t            zero_key_value;
+    rf_allocator        allocator;
+} rf_color_map;
+
+RF_INTERNAL inline uint32_t rf_color_key(rf_color color)
+{
+    return (uint32_t) color.r | ((uint32_t) color.g << 8) | ((uint32_t) color.b << 16) | ((uint32_t) color.a << 24);
+}
+
+RF_INTERNAL inline rf_color rf_color_from_key(uint32_t key)
+{
+    return (rf_color) { key & 0xFF, (key >> 8) & 0xFF, (key >> 16) & 0xFF, key >> 24 };
+}
+
+RF_INTERNAL bool rf_color_map_init(rf_color_map* map, rf_int min_capacity, rf_allocator allocator)
+{
+    *map = (rf_color_map) {0};
+    map->allocator = allocator;
+    map->capacity  = 64;
+    while (map->capacity < min_capacity) map->capacity *= 2;
+
+    map->entries = RF_CALLOC(allocator, map->capacity * sizeof(rf_color_map_entry));
+    if (!map->entries) RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", map->capacity * sizeof(rf_color_map_entry));
+
+    return map->entries != NULL;
+}
+
+RF_INTERNAL void rf_color_map_free(rf_color_map* map)
+{
+    RF_FREE(map->allocator, map->entries);
+    *map = (rf_color_map) {0};
+}
+
+RF_INTERNAL inline rf_int rf_color_map_slot(const rf_color_map* map, uint32_t key)
+{
+    rf_int mask = map->capacity - 1;
+    rf_int slot = (rf_int)(rf_hash_u32(key) & (uint32_t) mask);
+
+    while (map->entries[slot].key != 0 && map->entries[slot].key != key)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+RF_INTERNAL bool rf_color_map_grow(rf_color_map* map)
+{
+    rf_color_map grown;
+    if (!rf_color_map_init(&grown, map->capacity * 2, map->allocator)) return false;
+
+    for (rf_int i = 0; i < map->capacity; i++)
+    {
+        if (map->entries[i].key != 0)
+        {
+            grown.entries[rf_color_map_slot(&grown, map->entries[i].key)] = map->entries[i];
+        }
+    }
+
+    grown.count          = map->count;
+    grown.has_zero_key   = map->has_zero_key;
+    grown.zero_key_value = map->zero_key_value;
+
+    rf_color_map_free(map);
+    *map = grown;
+
+    return true;
+}
+
+// Returns the value of the key, inserting it with `value` if it is not in the map yet. Returns NULL if the map failed to grow.
+RF_INTERNAL uint32_t* rf_color_map_get_or_insert(rf_color_map* map, uint32_t key, uint32_t value, bool* inserted)
+{
+    *inserted = false;
+
+    if (key == 0)
+    {
+        if (!map->has_zero_key)
+        {
+            map->has_zero_key   = true;
+            map->zero_key_value = value;
+            map->count++;
+            *inserted = true;
+        }
+
+        return &map->zero_key_value;
+    }
+
+    rf_int slot = rf_color_map_slot(map, key);
+
+    if (map->entries[slot].key == 0)
+    {
+        // Keep the load factor under 1/2
+        if ((map->count + 1) * 2 > map->capacity)
+        {
+            if (!rf_color_map_grow(map)) return NULL;
+            slot = rf_color_map_slot(map, key);
+        }
+
+        map->entries[slot].key   = key;
+        map->entries[slot].value = value;
+        map->count++;
+        *inserted = true;
+    }
+
+    return &map->entries[slot].value;
+}
+
+#pragma endregion
+
+// Extract color palette from image to maximum size. Colors are added in the order in which they first appear in the image.
+// Returns the amount of colors written to palette_dst.
+RF_API rf_int rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size, rf_allocator temp_allocator)
+{
+    rf_int result = 0;
+
+    if (image.valid && rf_is_uncompressed_format(image.format))
     {
         if (palette_size > 0)
         {
-            int img_size = rf_image_size(image);
-            int img_bpp  = rf_bytes_per_pixel(image.format);
-            const unsigned char* img_data = (unsigned char*) image.data;
+            rf_color_map colors;
 
-            for (rf_int img_iter = 0, palette_iter = 0; img_iter < img_size && palette_iter < palette_size; img_iter += img_bpp)
+            if (rf_color_map_init(&colors, palette_size * 2, temp_allocator))
             {
-                rf_color color = rf_format_one_pixel_to_rgba32(img_data, image.format);
-
-                bool color_found = false;
+                int img_bpp = rf_bytes_per_pixel(image.format);
+                const unsigned char* img_data = (unsigned char*) image.data;
 
-                for (rf_int i = 0; i < palette_iter; i++)
+                for (rf_int i = 0; i < image.width * image.height && result < palette_size; i++)
                 {
-                    if (rf_color_match(palette_dst[i], color))
+                    rf_color color = rf_format_one_pixel_to_rgba32(img_data + i * img_bpp, image.format);
+
+                    bool inserted;
+                    if (!rf_color_map_get_or_insert(&colors, rf_color_key(color), (uint32_t) result, &inserted)) break;
+
+                    if (inserted)
                     {
-                        color_found = true;
-                        break;
+                        palette_dst[result] = color;
+                        result++;
                     }
                 }
 
-                if (!color_found)
-                {
-                    palette_dst[palette_iter] = color;
-                    palette_iter++;
-                }
+                rf_color_map_free(&colors);
             }
         }
         else RF_LOG(RF_LOG_TYPE_WARNING, "Palette size was 0.");
     }
     else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Function only works for uncompressed formats but was called with format %d.", image.format);
+
+    return result;
 }
 
-RF_API rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator)
+RF_API rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator, rf_allocator temp_allocator)
 {
     rf_palette result = {0};
 
-    if (rf_is_uncompressed_format(image.format))
+    if (rf_is_uncompressed_format(image.format) && palette_size > 0)
     {
         rf_color* dst = RF_ALLOC(allocator, sizeof(rf_color) * palette_size);
-        rf_image_extract_palette_to_buffer(image, dst, palette_size);
 
-        result.colors = dst;
-        result.count = palette_size;
+        if (dst)
+        {
+            result.colors = dst;
+            result.count  = (int) rf_image_extract_palette_to_buffer(image, dst, palette_size, temp_allocator);
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", sizeof(rf_color) * palette_size);
+    }
+
+    return result;
+}
+
+#pragma region median cut
+
+// Colors are reduced to 5 bits per channel for the histogram, the exact colors are kept through the channel sums
+#define RF_MEDIAN_CUT_KEY(color) (((color).r >> 3) | (((color).g >> 3) << 5) | (((color).b >> 3) << 10) | (((color).a >> 3) << 15))
+
+typedef struct rf_median_cut_bucket
+{
+    uint32_t count;
+    uint64_t sum[4];
+    unsigned char mean[4]; // Average color of the bucket, used to sort
+} rf_median_cut_bucket;
+
+typedef struct rf_median_cut_box
+{
+    rf_int begin;
+    rf_int end;
+    int    widest_channel;
+    int    range; // Range of the widest channel
+} rf_median_cut_box;
+
+RF_INTERNAL int rf_median_cut_compare_r(const void* a, const void* b) { return ((const rf_median_cut_bucket*) a)->mean[0] - ((const rf_median_cut_bucket*) b)->mean[0]; }
+RF_INTERNAL int rf_median_cut_compare_g(const void* a, const void* b) { return ((const rf_median_cut_bucket*) a)->mean[1] - ((const rf_median_cut_bucket*) b)->mean[1]; }
+RF_INTERNAL int rf_median_cut_compare_b(const void* a, const void* b) { return ((const rf_median_cut_bucket*) a)->mean[2] - ((const rf_median_cut_bucket*) b)->mean[2]; }
+RF_INTERNAL int rf_median_cut_compare_a(const void* a, const void* b) { return ((const rf_median_cut_bucket*) a)->mean[3] - ((const rf_median_cut_bucket*) b)->mean[3]; }
+
+RF_INTERNAL void rf_median_cut_measure_box(const rf_median_cut_bucket* buckets, rf_median_cut_box* box)
+{
+    int min[4] = { 255, 255, 255, 255 };
+    int max[4] = { 0, 0, 0, 0 };
+
+    for (rf_int i = box->begin; i < box->end; i++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            if (buckets[i].mean[c] < min[c]) min[c] = buckets[i].mean[c];
+            if (buckets[i].mean[c] > max[c]) max[c] = buckets[i].mean[c];
+        }
+    }
+
+    box->widest_channel = 0;
+    box->range = -1;
+    for (int c = 0; c < 4; c++)
+    {
+        if (max[c] - min[c] > box->range)
+        {
+            box->range = max[c] - min[c];
+            box->widest_channel = c;
+        }
+    }
+}
+
+/*
+ Generate a palette of at most palette_size colors that represents the image well, using median cut on a histogram of the image.
+ If the image has palette_size or fewer distinct colors, those exact colors are returned.
+ Returns the amount of colors written to palette_dst.
+*/
+RF_API rf_int rf_image_gen_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size, rf_allocator temp_allocator)
+{
+    if (!image.valid || !rf_is_uncompressed_format(image.format) || palette_size <= 0)
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Invalid arguments, image must be valid and uncompressed and palette_size must be positive.");
+        return 0;
+    }
+
+    // An image with few colors doesn't need to be quantized, collect one color more than fits to know if it has more than palette_size
+    rf_color* distinct_colors = RF_ALLOC(temp_allocator, (palette_size + 1) * sizeof(rf_color));
+    if (!distinct_colors)
+    {
+        RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed", (int) ((palette_size + 1) * sizeof(rf_color)));
+        return 0;
+    }
+
+    rf_int distinct_colors_count = rf_image_extract_palette_to_buffer(image, distinct_colors, palette_size + 1, temp_allocator);
+    if (distinct_colors_count <= palette_size) memcpy(palette_dst, distinct_colors, distinct_colors_count * sizeof(rf_color));
+    RF_FREE(temp_allocator, distinct_colors);
+
+    if (distinct_colors_count <= palette_size) return distinct_colors_count;
+
+    rf_int result = 0;
+    rf_int pixels_count = image.width * image.height;
+    int img_bpp = rf_bytes_per_pixel(image.format);
+    const unsigned char* img_data = (unsigned char*) image.data;
+
+    rf_color_map histogram_map;
+    rf_int buckets_capacity = 1024;
+    rf_median_cut_bucket* buckets = RF_CALLOC(temp_allocator, buckets_capacity * sizeof(rf_median_cut_bucket));
+    rf_median_cut_box* boxes = RF_ALLOC(temp_allocator, palette_size * sizeof(rf_median_cut_box));
+
+    if (buckets && boxes && rf_color_map_init(&histogram_map, buckets_capacity, temp_allocator))
+    {
+        rf_int buckets_count = 0;
+        bool success = true;
+
+        // Build the histogram, the map goes from the reduced color to the index of its bucket
+        for (rf_int i = 0; i < pixels_count && success; i++)
+        {
+            rf_color color = rf_format_one_pixel_to_rgba32(img_data + i * img_bpp, image.format);
+
+            // The key is offset by one so that it is never 0
+            bool inserted;
+            uint32_t* bucket_index = rf_color_map_get_or_insert(&histogram_map, RF_MEDIAN_CUT_KEY(color) + 1, (uint32_t) buckets_count, &inserted);
+            if (!bucket_index) { success = false; break; }
+
+            if (inserted)
+            {
+                if (buckets_count == buckets_capacity)
+                {
+                    rf_median_cut_bucket* grown = RF_REALLOC(temp_allocator, buckets, buckets_capacity * 2 * sizeof(rf_median_cut_bucket), buckets_capacity * sizeof(rf_median_cut_bucket));
+                    if (!grown) { success = false; break; }
+
+                    buckets = grown;
+                    memset(buckets + buckets_capacity, 0, buckets_capacity * sizeof(rf_median_cut_bucket));
+                    buckets_capacity *= 2;
+                }
+
+                buckets_count++;
+            }
+
+            rf_median_cut_bucket* bucket = &buckets[*bucket_index];
+            bucket->count++;
+            bucket->sum[0] += color.r;
+            bucket->sum[1] += color.g;
+            bucket->sum[2] += color.b;
+            bucket->sum[3] += color.a;
+        }
+
+        if (success)
+        {
+            for (rf_int i = 0; i < buckets_count; i++)
+            {
+                for (int c = 0; c < 4; c++)
+                {
+                    buckets[i].mean[c] = (unsigned char)((buckets[i].sum[c] + buckets[i].count / 2) / buckets[i].count);
+                }
+            }
+
+            // Split the box with the widest channel range at the median pixel of that channel until there are enough boxes
+            rf_int boxes_count = 1;
+            boxes[0] = (rf_median_cut_box) { .begin = 0, .end = buckets_count };
+            rf_median_cut_measure_box(buckets, &boxes[0]);
+
+            while (boxes_count < palette_size)
+            {
+                rf_median_cut_box* box = NULL;
+                for (rf_int i = 0; i < boxes_count; i++)
+                {
+                    if (boxes[i].end - boxes[i].begin > 1 && (!box || boxes[i].range > box->range)) box = &boxes[i];
+                }
+
+                if (!box || box->range <= 0) break;
+
+                int (*compare[4])(const void*, const void*) = { rf_median_cut_compare_r, rf_median_cut_compare_g, rf_median_cut_compare_b, rf_median_cut_compare_a };
+                qsort(buckets + box->begin, box->end - box->begin, sizeof(rf_median_cut_bucket), compare[box->widest_channel]);
+
+                uint64_t box_pixels = 0;
+                for (rf_int i = box->begin; i < box->end; i++) box_pixels += buckets[i].count;
+
+                rf_int split = box->begin + 1;
+                uint64_t accumulated = buckets[box->begin].count;
+                while (split < box->end - 1 && accumulated < box_pixels / 2)
+                {
+                    accumulated += buckets[split].count;
+                    split++;
+                }
+
+                boxes[boxes_count] = (rf_median_cut_box) { .begin = split, .end = box->end };
+                box->end = split;
+
+                rf_median_cut_measure_box(buckets, box);
+                rf_median_cut_measure_box(buckets, &boxes[boxes_count]);
+                boxes_count++;
+            }
+
+            // Every box becomes the pixel weighted average of its buckets
+            for (rf_int i = 0; i < boxes_count; i++)
+            {
+                uint64_t count = 0;
+                uint64_t sum[4] = {0};
+
+                for (rf_int j = boxes[i].begin; j < boxes[i].end; j++)
+                {
+                    count += buckets[j].count;
+                    for (int c = 0; c < 4; c++) sum[c] += buckets[j].sum[c];
+                }
+
+                palette_dst[i] = (rf_color) {
+                    (unsigned char)((sum[0] + count / 2) / count),
+                    (unsigned char)((sum[1] + count / 2) / count),
+                    (unsigned char)((sum[2] + count / 2) / count),
+                    (unsigned char)((sum[3] + count / 2) / count),
+                };
+            }
+
+            result = boxes_count;
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Failed to grow the color histogram.");
+
+        rf_color_map_free(&histogram_map);
     }
+    else RF_LOG_ERROR(RF_BAD_ALLOC, "Failed to allocate the color histogram.");
+
+    RF_FREE(temp_allocator, boxes);
+    RF_FREE(temp_allocator, buckets);
 
     return result;
 }
 
+RF_API rf_palette rf_image_gen_palette(rf_image image, rf_int palette_size, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    rf_palette result = {0};
+
+    if (rf_is_uncompressed_format(image.format) && palette_size > 0)
+    {
+        rf_color* dst = RF_ALLOC(allocator, sizeof(rf_color) * palette_size);
+
+        if (dst)
+        {
+            result.colors = dst;
+            result.count  = (int) rf_image_gen_palette_to_buffer(image, dst, palette_size, temp_allocator);
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", sizeof(rf_color) * palette_size);
+    }
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region quantize
+
+RF_INTERNAL uint32_t rf_palette_nearest(rf_palette palette, rf_color color)
+{
+    uint32_t nearest = 0;
+    int nearest_distance = INT_MAX;
+
+    for (int i = 0; i < palette.count; i++)
+    {
+        int dr = (int) color.r - palette.colors[i].r;
+        int dg = (int) color.g - palette.colors[i].g;
+        int db = (int) color.b - palette.colors[i].b;
+        int da = (int) color.a - palette.colors[i].a;
+        int distance = dr * dr + dg * dg + db * db + da * da;
+
+        if (distance < nearest_distance)
+        {
+            nearest_distance = distance;
+            nearest = (uint32_t) i;
+        }
+    }
+
+    return nearest;
+}
+
+/*
+ Replace every pixel of the image with the nearest color of the palette, the result is in rgba32.
+ If dither is true the quantization error of the rgb channels is diffused to the neighbouring pixels (Floyd-Steinberg).
+ The nearest color of every distinct color is only searched once.
+*/
+RF_API rf_image rf_image_quantize_to_buffer(rf_image image, rf_palette palette, bool dither, rf_color* dst, rf_int dst_size, rf_allocator temp_allocator)
+{
+    rf_image result = {0};
+
+    if (!image.valid || !rf_is_uncompressed_format(image.format) || !palette.colors || palette.count <= 0)
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Invalid arguments, image must be valid and uncompressed and the palette must not be empty.");
+        return result;
+    }
+
+    if (dst_size < image.width * image.height * (rf_int) sizeof(rf_color))
+    {
+        RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expects a buffer of at least size %d", dst_size, image.width * image.height * sizeof(rf_color));
+        return result;
+    }
+
+    // Error rows for the current and the next row with one pixel of padding on each side, 3 channels per pixel
+    rf_int errors_size = dither ? (image.width + 2) * 3 * 2 * sizeof(int) : 0;
+    int* errors = dither ? RF_CALLOC(temp_allocator, errors_size) : NULL;
+
+    rf_color_map nearest_cache;
+
+    if ((!dither || errors) && rf_color_map_init(&nearest_cache, 1024, temp_allocator))
+    {
+        bool success = rf_format_pixels_to_rgba32(image.data, rf_image_size(image), image.format, dst, dst_size);
+        RF_ASSERT(success);
+
+        for (rf_int y = 0; y < image.height && success; y++)
+        {
+            int* current = errors ? errors + ((y & 1) ? (image.width + 2) * 3 : 0) : NULL;
+            int* next    = errors ? errors + ((y & 1) ? 0 : (image.width + 2) * 3) : NULL;
+
+            if (next) memset(next, 0, (image.width + 2) * 3 * sizeof(int));
+
+            for (rf_int x = 0; x < image.width; x++)
+            {
+                rf_color color = dst[y * image.width + x];
+
+                if (current)
+                {
+                    int* error = current + (x + 1) * 3;
+                    color.r = (unsigned char) rf_max_i(0, rf_min_i(255, color.r + error[0] / 16));
+                    color.g = (unsigned char) rf_max_i(0, rf_min_i(255, color.g + error[1] / 16));
+                    color.b = (unsigned char) rf_max_i(0, rf_min_i(255, color.b + error[2] / 16));
+                }
+
+                bool inserted;
+                uint32_t* index = rf_color_map_get_or_insert(&nearest_cache, rf_color_key(color), 0, &inserted);
+                if (!index) { success = false; break; }
+                if (inserted) *index = rf_palette_nearest(palette, color);
+
+                rf_color quantized = palette.colors[*index];
+                dst[y * image.width + x] = quantized;
+
+                if (current)
+                {
+                    int error[3] = { (int) color.r - quantized.r, (int) color.g - quantized.g, (int) color.b - quantized.b };
+
+                    // Errors are kept multiplied by 16 so the 7/16, 3/16, 5/16, 1/16 weights are exact
+                    for (int c = 0; c < 3; c++)
+                    {
+                        current[(x + 2) * 3 + c] += error[c] * 7;
+                        next   [(x + 0) * 3 + c] += error[c] * 3;
+                        next   [(x + 1) * 3 + c] += error[c] * 5;
+                        next   [(x + 2) * 3 + c] += error[c] * 1;
+                    }
+                }
+            }
+        }
+
+        if (success)
+        {
+            result = (rf_image)
+            {
+                .data   = dst,
+                .width  = image.width,
+                .height = image.height,
+                .format = RF_UNCOMPRESSED_R8G8B8A8,
+                .valid  = true,
+            };
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Failed to grow the color cache.");
+
+        rf_color_map_free(&nearest_cache);
+    }
+    else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", errors_size);
+
+    RF_FREE(temp_allocator, errors);
+
+    return result;
+}
+
+RF_API rf_image rf_image_quantize(rf_image image, rf_palette palette, bool dither, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    rf_image result = {0};
+
+    if (image.valid)
+    {
+        int size = image.width * image.height * sizeof(rf_color);
+        rf_color* dst = RF_ALLOC(allocator, size);
+
+        if (dst)
+        {
+            result = rf_image_quantize_to_buffer(image, palette, dither, dst, size, temp_allocator);
+            if (!result.valid) RF_FREE(allocator, dst);
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", size);
+    }
+    else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image is invalid.");
+
+    return result;
+}
+
+#pragma endregion
+
 // Get image alpha border rectangle
 RF_API rf_rec rf_image_alpha_border(rf_image image, float threshold)
 {
@@ -15538,12 +17765,13 @@ RF_API rf_image rf_load_image_from_hdr_file_data_to_buffer(const void* src, rf_i
 
         // NOTE: Using stb_image to load images (Supports multiple image formats)
         RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(temp_allocator);
-        void* output_buffer = stbi_load_from_memory(src, src_size, &img_width, &img_height, &img_bpp, channels);
+        void* output_buffer = stbi_loadf_from_memory(src, src_size, &img_width, &img_height, &img_bpp, channels);
         RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(RF_NULL_ALLOCATOR);
 
         if (output_buffer)
         {
-            int output_buffer_size = img_width * img_height * img_bpp;
+            if (channels != RF_ANY_CHANNELS) img_bpp = channels;
+            int output_buffer_size = img_width * img_height * img_bpp * sizeof(float);
 
             if (dst_size >= output_buffer_size)
             {
@@ -15579,12 +17807,12 @@ RF_API rf_image rf_load_image_from_hdr_file_data(const void* src, rf_int src_siz
 
         // NOTE: Using stb_image to load images (Supports multiple image formats)
         RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(temp_allocator);
-        void* stbi_result = stbi_load_from_memory(src, src_size, &width, &height, &bpp, RF_ANY_CHANNELS);
+        void* stbi_result = stbi_loadf_from_memory(src, src_size, &width, &height, &bpp, RF_ANY_CHANNELS);
         RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(RF_NULL_ALLOCATOR);
 
         if (stbi_result && bpp)
         {
-            int stbi_result_size = width * height * bpp;
+            int stbi_result_size = width * height * bpp * sizeof(float);
             void* result_buffer = RF_ALLOC(allocator, stbi_result_size);
 
             if (result_buffer)
@@ -15631,11 +17859,105 @@ RF_API rf_image rf_load_image_from_format_to_buffer(const void* src, rf_int src_
     return result;
 }
 
+// Adapts the streaming procs of rf_io_callbacks to the stb_image callbacks so images are decoded straight from the file
+typedef struct rf_stbi_stream
+{
+    rf_io_callbacks io;
+    void* file;
+    rf_int position; // Bytes read or skipped so far, lets the gif player go back to the start of the file
+} rf_stbi_stream;
+
+RF_INTERNAL int rf_stbi_stream_read(void* user, char* data, int size)
+{
+    rf_stbi_stream* stream = (rf_stbi_stream*) user;
+    rf_int read_size = RF_READ_STREAM(stream->io, stream->file, data, size);
+    stream->position += read_size;
+    return (int) read_size;
+}
+
+RF_INTERNAL void rf_stbi_stream_skip(void* user, int n)
+{
+    rf_stbi_stream* stream = (rf_stbi_stream*) user;
+    RF_SKIP_STREAM(stream->io, stream->file, n);
+    stream->position += n;
+}
+
+RF_INTERNAL int rf_stbi_stream_eof(void* user)
+{
+    rf_stbi_stream* stream = (rf_stbi_stream*) user;
+    return RF_STREAM_EOF(stream->io, stream->file);
+}
+
+/*
+ * Decodes an image while stb_image reads the file through its small internal buffer,
+ * so the encoded file is never held in memory as a whole.
+ * stb_image allocates the pixels from the caller's allocator, so they are returned without a copy.
+ */
+RF_INTERNAL rf_image rf_load_image_from_file_stream(const char* filename, rf_allocator allocator, rf_io_callbacks io)
+{
+    rf_image result = {0};
+
+    rf_stbi_stream stream = { io, RF_OPEN_FILE(io, filename), 0 };
+    if (!stream.file)
+    {
+        RF_LOG_ERROR(RF_BAD_IO, "Could not open file %s", filename);
+        return result;
+    }
+
+    stbi_io_callbacks callbacks = { rf_stbi_stream_read, rf_stbi_stream_skip, rf_stbi_stream_eof };
+    bool is_hdr = rf_is_file_extension(filename, ".hdr");
+    int width = 0, height = 0, channels = 0;
+
+    RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(allocator);
+    void* stbi_result = is_hdr ? (void*) stbi_loadf_from_callbacks(&callbacks, &stream, &width, &height, &channels, RF_ANY_CHANNELS)
+                               : (void*) stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, RF_ANY_CHANNELS);
+    RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(RF_NULL_ALLOCATOR);
+
+    RF_CLOSE_FILE(io, stream.file);
+
+    if (stbi_result && channels)
+    {
+        result.data   = stbi_result;
+        result.width  = width;
+        result.height = height;
+        result.valid  = true;
+
+        if (is_hdr)
+        {
+                 if (channels == 1) result.format = RF_UNCOMPRESSED_R32;
+            else if (channels == 3) result.format = RF_UNCOMPRESSED_R32G32B32;
+            else if (channels == 4) result.format = RF_UNCOMPRESSED_R32G32B32A32;
+        }
+        else
+        {
+            switch (channels)
+            {
+                case 1: result.format = RF_UNCOMPRESSED_GRAYSCALE; break;
+                case 2: result.format = RF_UNCOMPRESSED_GRAY_ALPHA; break;
+                case 3: result.format = RF_UNCOMPRESSED_R8G8B8; break;
+                case 4: result.format = RF_UNCOMPRESSED_R8G8B8A8; break;
+                default: break;
+            }
+        }
+    }
+    else
+    {
+        if (stbi_result) RF_FREE(allocator, stbi_result);
+        RF_LOG_ERROR(RF_STBI_FAILED, "File format not supported or could not be loaded. STB Image returned { x: %d, y: %d, channels: %d }", width, height, channels);
+    }
+
+    return result;
+}
+
 RF_API rf_image rf_load_image_from_file(const char* filename, rf_allocator allocator, rf_allocator temp_allocator, rf_io_callbacks io)
 {
     rf_image image = {0};
 
-    if (rf_supports_image_file_type(filename))
+    if (rf_supports_image_file_type(filename) && RF_IO_SUPPORTS_STREAMING(io))
+    {
+        image = rf_load_image_from_file_stream(filename, allocator, io);
+    }
+    else if (rf_supports_image_file_type(filename))
     {
         int file_size = RF_FILE_SIZE(io, filename);
 
@@ -15739,6 +18061,211 @@ RF_API rf_image rf_image_copy(rf_image image, rf_allocator allocator)
     return result;
 }
 
+#pragma region geometric ops
+
+#define RF_TRANSPOSE_TILE_SIZE (16)
+#define RF_GEOMETRIC_OPS_ROWS_PER_JOB (64)
+#define RF_FLIP_SWAP_CHUNK_SIZE (1024)
+#define RF_ALPHA_SCAN_CHUNK_SIZE (256)
+
+RF_INTERNAL inline void rf_copy_pixel(unsigned char* dst, const unsigned char* src, int bpp)
+{
+    switch (bpp)
+    {
+        case 1: *dst = *src; break;
+        case 2: memcpy(dst, src, 2); break;
+        case 4: memcpy(dst, src, 4); break;
+        default: memcpy(dst, src, bpp); break;
+    }
+}
+
+// Writes the transpose of 4 rows of 4 32 bit pixels to 4 rows of dst. The strides are in bytes and can be negative to walk rows backwards.
+RF_INTERNAL inline void rf_transpose_4x4_u32(const unsigned char* src, rf_int src_stride, unsigned char* dst, rf_int dst_stride)
+{
+    #if defined(RF_SIMD_SSE2)
+    __m128i r0 = _mm_loadu_si128((const __m128i*)(src + 0 * src_stride));
+    __m128i r1 = _mm_loadu_si128((const __m128i*)(src + 1 * src_stride));
+    __m128i r2 = _mm_loadu_si128((const __m128i*)(src + 2 * src_stride));
+    __m128i r3 = _mm_loadu_si128((const __m128i*)(src + 3 * src_stride));
+
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1); // a0 b0 a1 b1
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3); // c0 d0 c1 d1
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1); // a2 b2 a3 b3
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3); // c2 d2 c3 d3
+
+    _mm_storeu_si128((__m128i*)(dst + 0 * dst_stride), _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(dst + 1 * dst_stride), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(dst + 2 * dst_stride), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i*)(dst + 3 * dst_stride), _mm_unpackhi_epi64(t2, t3));
+    #elif defined(RF_SIMD_NEON)
+    uint32x4x2_t t01 = vtrnq_u32(vld1q_u32((const uint32_t*)(src + 0 * src_stride)), vld1q_u32((const uint32_t*)(src + 1 * src_stride))); // a0 b0 a2 b2, a1 b1 a3 b3
+    uint32x4x2_t t23 = vtrnq_u32(vld1q_u32((const uint32_t*)(src + 2 * src_stride)), vld1q_u32((const uint32_t*)(src + 3 * src_stride))); // c0 d0 c2 d2, c1 d1 c3 d3
+
+    vst1q_u32((uint32_t*)(dst + 0 * dst_stride), vcombine_u32(vget_low_u32 (t01.val[0]), vget_low_u32 (t23.val[0])));
+    vst1q_u32((uint32_t*)(dst + 1 * dst_stride), vcombine_u32(vget_low_u32 (t01.val[1]), vget_low_u32 (t23.val[1])));
+    vst1q_u32((uint32_t*)(dst + 2 * dst_stride), vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+    vst1q_u32((uint32_t*)(dst + 3 * dst_stride), vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+    #else
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++) memcpy(dst + i * dst_stride + j * 4, src + j * src_stride + i * 4, 4);
+    }
+    #endif
+}
+
+// Writes the transpose of a width x height block of src to dst, so the pixel at row j, column i of src ends up at row i, column j of dst
+RF_INTERNAL void rf_transpose_block(const unsigned char* src, rf_int src_stride, unsigned char* dst, rf_int dst_stride, int width, int height, int bpp)
+{
+    int i = 0;
+
+    if (bpp == 4)
+    {
+        for (; i + 4 <= width; i += 4)
+        {
+            int j = 0;
+            for (; j + 4 <= height; j += 4)
+            {
+                rf_transpose_4x4_u32(src + j * src_stride + i * 4, src_stride, dst + i * dst_stride + j * 4, dst_stride);
+            }
+
+            for (; j < height; j++)
+            {
+                for (int k = i; k < i + 4; k++) memcpy(dst + k * dst_stride + j * 4, src + j * src_stride + k * 4, 4);
+            }
+        }
+    }
+
+    for (; i < width; i++)
+    {
+        for (int j = 0; j < height; j++) rf_copy_pixel(dst + i * dst_stride + j * bpp, src + j * src_stride + i * bpp, bpp);
+    }
+}
+
+typedef struct rf_rotate_job_data
+{
+    rf_image image;
+    unsigned char* dst;
+    bool clockwise;
+} rf_rotate_job_data;
+
+// Rotates a band of source rows tile by tile, each tile is a transpose with the rows (clockwise) or the columns (counter-clockwise) walked backwards
+RF_INTERNAL void rf_rotate_job(void* job_data, rf_int job_index)
+{
+    const rf_rotate_job_data* data = job_data;
+
+    int w = data->image.width;
+    int h = data->image.height;
+    int bpp = rf_bytes_per_pixel(data->image.format);
+    rf_int src_stride = (rf_int) w * bpp;
+    rf_int dst_stride = (rf_int) h * bpp;
+
+    const unsigned char* src = data->image.data;
+    int y_end = rf_min_i((int)((job_index + 1) * RF_GEOMETRIC_OPS_ROWS_PER_JOB), h);
+
+    for (int ty = (int)(job_index * RF_GEOMETRIC_OPS_ROWS_PER_JOB); ty < y_end; ty += RF_TRANSPOSE_TILE_SIZE)
+    {
+        int th = rf_min_i(RF_TRANSPOSE_TILE_SIZE, y_end - ty);
+
+        for (int tx = 0; tx < w; tx += RF_TRANSPOSE_TILE_SIZE)
+        {
+            int tw = rf_min_i(RF_TRANSPOSE_TILE_SIZE, w - tx);
+
+            if (data->clockwise)
+            {
+                // Source pixel (x, y) goes to destination row x, column h - 1 - y
+                const unsigned char* tile_src = src + ((rf_int)(ty + th - 1) * w + tx) * bpp;
+                unsigned char* tile_dst = data->dst + ((rf_int) tx * h + (h - ty - th)) * bpp;
+                rf_transpose_block(tile_src, -src_stride, tile_dst, dst_stride, tw, th, bpp);
+            }
+            else
+            {
+                // Source pixel (x, y) goes to destination row w - 1 - x, column y
+                const unsigned char* tile_src = src + ((rf_int) ty * w + tx) * bpp;
+                unsigned char* tile_dst = data->dst + ((rf_int)(w - 1 - tx) * h + ty) * bpp;
+                rf_transpose_block(tile_src, src_stride, tile_dst, -dst_stride, tw, th, bpp);
+            }
+        }
+    }
+}
+
+RF_INTERNAL void rf_rotate_90(rf_image image, void* dst, bool clockwise)
+{
+    rf_rotate_job_data data = { image, dst, clockwise };
+    rf_parallel_for(rf_rotate_job, &data, (image.height + RF_GEOMETRIC_OPS_ROWS_PER_JOB - 1) / RF_GEOMETRIC_OPS_ROWS_PER_JOB);
+}
+
+// Transposes a square image in place by swapping the tiles above the diagonal with the ones below it
+RF_INTERNAL void rf_transpose_square_in_place(unsigned char* data, int size, int bpp)
+{
+    rf_int stride = (rf_int) size * bpp;
+    unsigned char tile_a[RF_TRANSPOSE_TILE_SIZE * RF_TRANSPOSE_TILE_SIZE * sizeof(rf_vec4)];
+    unsigned char tile_b[RF_TRANSPOSE_TILE_SIZE * RF_TRANSPOSE_TILE_SIZE * sizeof(rf_vec4)];
+    rf_int tile_stride = RF_TRANSPOSE_TILE_SIZE * bpp;
+
+    for (int ty = 0; ty < size; ty += RF_TRANSPOSE_TILE_SIZE)
+    {
+        int th = rf_min_i(RF_TRANSPOSE_TILE_SIZE, size - ty);
+
+        for (int tx = ty; tx < size; tx += RF_TRANSPOSE_TILE_SIZE)
+        {
+            int tw = rf_min_i(RF_TRANSPOSE_TILE_SIZE, size - tx);
+
+            unsigned char* a = data + (rf_int) ty * stride + (rf_int) tx * bpp;
+            unsigned char* b = data + (rf_int) tx * stride + (rf_int) ty * bpp;
+
+            // Tile a is th x tw and tile b is its mirror, tw x th. On the diagonal they are the same tile.
+            rf_transpose_block(a, stride, tile_a, tile_stride, tw, th, bpp);
+            if (tx != ty) rf_transpose_block(b, stride, tile_b, tile_stride, th, tw, bpp);
+
+            for (int y = 0; y < tw; y++) memcpy(b + y * stride, tile_a + y * tile_stride, (size_t) th * bpp);
+            if (tx != ty)
+            {
+                for (int y = 0; y < th; y++) memcpy(a + y * stride, tile_b + y * tile_stride, (size_t) tw * bpp);
+            }
+        }
+    }
+}
+
+// Reverses the order of count pixels, src and dst can be the same row
+RF_INTERNAL void rf_reverse_row(const unsigned char* src, unsigned char* dst, rf_int count, int bpp)
+{
+    rf_int i = 0;
+    rf_int j = count - 1;
+
+    #if defined(RF_SIMD_SSE2) || defined(RF_SIMD_NEON)
+    if (bpp == 4)
+    {
+        // Swap 4 pixels from the start with 4 pixels from the end while they don't overlap
+        for (; i + 4 <= j - 3; i += 4, j -= 4)
+        {
+            #if defined(RF_SIMD_SSE2)
+            __m128i left  = _mm_loadu_si128((const __m128i*)(src + i * 4));
+            __m128i right = _mm_loadu_si128((const __m128i*)(src + (j - 3) * 4));
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_shuffle_epi32(right, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128((__m128i*)(dst + (j - 3) * 4), _mm_shuffle_epi32(left, _MM_SHUFFLE(0, 1, 2, 3)));
+            #else
+            uint32x4_t left  = vld1q_u32((const uint32_t*)(src + i * 4));
+            uint32x4_t right = vld1q_u32((const uint32_t*)(src + (j - 3) * 4));
+            left  = vrev64q_u32(left);
+            right = vrev64q_u32(right);
+            vst1q_u32((uint32_t*)(dst + i * 4), vcombine_u32(vget_high_u32(right), vget_low_u32(right)));
+            vst1q_u32((uint32_t*)(dst + (j - 3) * 4), vcombine_u32(vget_high_u32(left), vget_low_u32(left)));
+            #endif
+        }
+    }
+    #endif
+
+    unsigned char swap[sizeof(rf_vec4)];
+    for (; i <= j; i++, j--)
+    {
+        memcpy(swap, src + i * bpp, bpp);
+        rf_copy_pixel(dst + i * bpp, src + j * bpp, bpp);
+        memcpy(dst + j * bpp, swap, bpp);
+    }
+}
+
+#pragma endregion
+
 /**
  * Crop an image and store the result in a provided buffer.
  * @param image a valid image that we crop from.
@@ -15764,12 +18291,6 @@ RF_API rf_image rf_image_crop_to_buffer(rf_image image, rf_rec crop, void* dst,
             int expected_size = rf_pixel_buffer_size(crop.width, crop.height, dst_format);
             if (dst_size >= expected_size)
             {
-                rf_pixel_format src_format = image.format;
-                int src_size = rf_image_size(image);
-
-                unsigned char* src_ptr = image.data;
-                unsigned char* dst_ptr = dst;
-
                 int src_bpp = rf_bytes_per_pixel(image.format);
                 int dst_bpp = rf_bytes_per_pixel(dst_format);
 
@@ -15778,19 +18299,19 @@ RF_API rf_image rf_image_crop_to_buffer(rf_image image, rf_rec crop, void* dst,
                 int crop_x = crop.x;
                 int crop_w = crop.width;
 
+                // Rows of the crop are contiguous in the source, so they are copied or converted a whole row at a time
                 for (rf_int y = 0; y < crop_h; y++)
                 {
-                    for (rf_int x = 0; x < crop_w; x++)
-                    {
-                        int src_x = x + crop_x;
-                        int src_y = y + crop_y;
+                    const unsigned char* src_row = (unsigned char*) image.data + ((y + crop_y) * image.width + crop_x) * src_bpp;
+                    unsigned char* dst_row = (unsigned char*) dst + y * crop_w * dst_bpp;
 
-                        int src_pixel = (src_y * image.width + src_x) * src_bpp;
-                        int dst_pixel = (y * crop_w + x) * src_bpp;
-                        RF_ASSERT(src_pixel < src_size);
-                        RF_ASSERT(dst_pixel < dst_size);
-
-                        rf_format_one_pixel(&src_ptr[src_pixel], src_format, &dst_ptr[dst_pixel], dst_format);
+                    if (image.format == dst_format)
+                    {
+                        memcpy(dst_row, src_row, crop_w * src_bpp);
+                    }
+                    else
+                    {
+                        rf_format_pixels(src_row, crop_w * src_bpp, image.format, dst_row, crop_w * dst_bpp, dst_format);
                     }
                 }
 
@@ -15849,11 +18370,263 @@ RF_INTERNAL int rf_format_to_stb_channel_count(rf_pixel_format format)
     }
 }
 
+#pragma region resize
+
+// Resizes are split in horizontal bands of at least this many output pixels which are processed on the job system
+#ifndef RF_RESIZE_BAND_PIXELS
+    #define RF_RESIZE_BAND_PIXELS (256 * 64)
+#endif
+
+#ifndef RF_MAX_RESIZE_BANDS
+    #define RF_MAX_RESIZE_BANDS (64)
+#endif
+
+typedef struct rf_resize_band
+{
+    stbir__info info;
+    void*       memory;
+    size_t      memory_size;
+} rf_resize_band;
+
+typedef struct rf_resize_job
+{
+    const unsigned char* src;
+    int                  src_width;
+    int                  src_height;
+    unsigned char*       dst;
+    int                  dst_width;
+    int                  dst_height;
+    int                  channels;
+    int                  band_height;
+    rf_resize_band*      bands;
+} rf_resize_job;
+
+RF_INTERNAL int rf_resize_band_count(int dst_width, int dst_height)
+{
+    int band_count = (int)(((rf_int) dst_width * dst_height) / RF_RESIZE_BAND_PIXELS);
+    if (band_count > dst_height)          band_count = dst_height;
+    if (band_count > RF_MAX_RESIZE_BANDS) band_count = RF_MAX_RESIZE_BANDS;
+    if (band_count < 1)                   band_count = 1;
+    return band_count;
+}
+
+// Downscale two rows by 2x with a 2x2 box filter, rounding to nearest
+RF_INTERNAL void rf_downscale_2x_row(const unsigned char* row0, const unsigned char* row1, unsigned char* dst, int dst_width, int channels)
+{
+    int x = 0;
+
+    #if defined(RF_SIMD_SSE2)
+        const __m128i zero  = _mm_setzero_si128();
+        const __m128i two   = _mm_set1_epi16(2);
+
+        if (channels == 1)
+        {
+            const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+
+            for (; x + 8 <= dst_width; x += 8)
+            {
+                __m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 2));
+                __m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 2));
+
+                __m128i sum = _mm_add_epi16(_mm_and_si128(a, low_bytes), _mm_srli_epi16(a, 8));
+                sum = _mm_add_epi16(sum, _mm_and_si128(b, low_bytes));
+                sum = _mm_add_epi16(sum, _mm_srli_epi16(b, 8));
+                sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+
+                _mm_storel_epi64((__m128i*)(dst + x), _mm_packus_epi16(sum, zero));
+            }
+        }
+        else if (channels == 4)
+        {
+            for (; x + 4 <= dst_width; x += 4)
+            {
+                const unsigned char* a = row0 + x * 8;
+                const unsigned char* b = row1 + x * 8;
+
+                // Reorder each group of 4 pixels as p0 p2 p1 p3 so that the low and high halves hold horizontal neighbours
+                __m128i a0 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(a)),      _MM_SHUFFLE(3, 1, 2, 0));
+                __m128i a1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(a + 16)), _MM_SHUFFLE(3, 1, 2, 0));
+                __m128i b0 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(b)),      _MM_SHUFFLE(3, 1, 2, 0));
+                __m128i b1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(b + 16)), _MM_SHUFFLE(3, 1, 2, 0));
+
+                __m128i sum0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpackhi_epi8(a0, zero));
+                __m128i sum1 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpackhi_epi8(a1, zero));
+                sum0 = _mm_add_epi16(sum0, _mm_add_epi16(_mm_unpacklo_epi8(b0, zero), _mm_unpackhi_epi8(b0, zero)));
+                sum1 = _mm_add_epi16(sum1, _mm_add_epi16(_mm_unpacklo_epi8(b1, zero), _mm_unpackhi_epi8(b1, zero)));
+
+                sum0 = _mm_srli_epi16(_mm_add_epi16(sum0, two), 2);
+                sum1 = _mm_srli_epi16(_mm_add_epi16(sum1, two), 2);
+
+                _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_packus_epi16(sum0, sum1));
+            }
+        }
+    #elif defined(RF_SIMD_NEON)
+        // vld2/3/4 split the channels so every channel is reduced with a pairwise add, vrshrn does the (sum + 2) >> 2
+        if (channels == 1)
+        {
+            for (; x + 8 <= dst_width; x += 8)
+            {
+                uint16x8_t sum = vaddq_u16(vpaddlq_u8(vld1q_u8(row0 + x * 2)), vpaddlq_u8(vld1q_u8(row1 + x * 2)));
+                vst1_u8(dst + x, vrshrn_n_u16(sum, 2));
+            }
+        }
+        else if (channels == 2)
+        {
+            for (; x + 8 <= dst_width; x += 8)
+            {
+                uint8x16x2_t a = vld2q_u8(row0 + x * 4);
+                uint8x16x2_t b = vld2q_u8(row1 + x * 4);
+                uint8x8x2_t out;
+                out.val[0] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[0]), vpaddlq_u8(b.val[0])), 2);
+                out.val[1] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[1]), vpaddlq_u8(b.val[1])), 2);
+                vst2_u8(dst + x * 2, out);
+            }
+        }
+        else if (channels == 3)
+        {
+            for (; x + 8 <= dst_width; x += 8)
+            {
+                uint8x16x3_t a = vld3q_u8(row0 + x * 6);
+                uint8x16x3_t b = vld3q_u8(row1 + x * 6);
+                uint8x8x3_t out;
+                out.val[0] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[0]), vpaddlq_u8(b.val[0])), 2);
+                out.val[1] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[1]), vpaddlq_u8(b.val[1])), 2);
+                out.val[2] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[2]), vpaddlq_u8(b.val[2])), 2);
+                vst3_u8(dst + x * 3, out);
+            }
+        }
+        else if (channels == 4)
+        {
+            for (; x + 8 <= dst_width; x += 8)
+            {
+                uint8x16x4_t a = vld4q_u8(row0 + x * 8);
+                uint8x16x4_t b = vld4q_u8(row1 + x * 8);
+                uint8x8x4_t out;
+                out.val[0] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[0]), vpaddlq_u8(b.val[0])), 2);
+                out.val[1] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[1]), vpaddlq_u8(b.val[1])), 2);
+                out.val[2] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[2]), vpaddlq_u8(b.val[2])), 2);
+                out.val[3] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[3]), vpaddlq_u8(b.val[3])), 2);
+                vst4_u8(dst + x * 4, out);
+            }
+        }
+    #endif
+
+    for (; x < dst_width; x++)
+    {
+        for (int c = 0; c < channels; c++)
+        {
+            int sum = row0[(x * 2) * channels + c] + row0[(x * 2 + 1) * channels + c] + row1[(x * 2) * channels + c] + row1[(x * 2 + 1) * channels + c];
+            dst[x * channels + c] = (unsigned char)((sum + 2) >> 2);
+        }
+    }
+}
+
+RF_INTERNAL void rf_downscale_2x_job(void* job_data, rf_int band)
+{
+    rf_resize_job* job = job_data;
+
+    int y_begin = (int) band * job->band_height;
+    int y_end   = rf_min_i(y_begin + job->band_height, job->dst_height);
+
+    rf_int src_stride = (rf_int) job->src_width * job->channels;
+    rf_int dst_stride = (rf_int) job->dst_width * job->channels;
+
+    for (int y = y_begin; y < y_end; y++)
+    {
+        const unsigned char* row0 = job->src + (y * 2) * src_stride;
+        rf_downscale_2x_row(row0, row0 + src_stride, job->dst + y * dst_stride, job->dst_width, job->channels);
+    }
+}
+
+RF_INTERNAL void rf_stbir_resize_band_job(void* job_data, rf_int band)
+{
+    rf_resize_job*  job  = job_data;
+    rf_resize_band* data = &job->bands[band];
+
+    unsigned char* dst = job->dst + (rf_int) band * job->band_height * job->dst_width * job->channels;
+
+    stbir__resize_allocated(&data->info, job->src, 0, dst, 0, -1, 0, STBIR_TYPE_UINT8, STBIR_EDGE_CLAMP, STBIR_EDGE_CLAMP, STBIR_COLORSPACE_LINEAR, data->memory, data->memory_size);
+}
+
+/*
+ Resize 8 bit per channel pixels.
+ Exact 2x downscales use a 2x2 box filter, everything else goes through stbir.
+ stbir runs once per band of output rows, each band is given the full scale and is shifted by its first row so the filter support
+ reads the input rows outside of the band like a single resize would.
+ All the memory is allocated up front on the calling thread so the temp allocator is never used from the job system.
+*/
+RF_INTERNAL bool rf_resize_u8(const unsigned char* src, int src_width, int src_height, unsigned char* dst, int dst_width, int dst_height, int channels, rf_allocator temp_allocator)
+{
+    int band_count = rf_resize_band_count(dst_width, dst_height);
+
+    rf_resize_job job = {0};
+    job.src         = src;
+    job.src_width   = src_width;
+    job.src_height  = src_height;
+    job.dst         = dst;
+    job.dst_width   = dst_width;
+    job.dst_height  = dst_height;
+    job.channels    = channels;
+    job.band_height = (dst_height + band_count - 1) / band_count;
+
+    band_count = (dst_height + job.band_height - 1) / job.band_height;
+
+    if (src_width == dst_width * 2 && src_height == dst_height * 2)
+    {
+        rf_parallel_for(rf_downscale_2x_job, &job, band_count);
+        return true;
+    }
+
+    rf_resize_band bands[RF_MAX_RESIZE_BANDS];
+    size_t memory_size = 0;
+
+    float transform[4] = { (float) dst_width / src_width, (float) dst_height / src_height, 0, 0 };
+
+    for (int i = 0; i < band_count; i++)
+    {
+        int band_y      = i * job.band_height;
+        int band_height = rf_min_i(job.band_height, dst_height - band_y);
+
+        transform[3] = (float) band_y;
+
+        stbir__setup(&bands[i].info, src_width, src_height, dst_width, band_height, channels);
+        stbir__calculate_transform(&bands[i].info, 0, 0, 1, 1, transform);
+        stbir__choose_filter(&bands[i].info, STBIR_FILTER_DEFAULT, STBIR_FILTER_DEFAULT);
+
+        // Keep each band's memory 16 byte aligned
+        bands[i].memory_size = (stbir__calculate_memory(&bands[i].info) + 15) & ~((size_t) 15);
+        memory_size += bands[i].memory_size;
+    }
+
+    unsigned char* memory = RF_ALLOC(temp_allocator, memory_size);
+
+    if (!memory)
+    {
+        RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", memory_size);
+        return false;
+    }
+
+    for (int i = 0, offset = 0; i < band_count; offset += (int) bands[i].memory_size, i++)
+    {
+        bands[i].memory = memory + offset;
+    }
+
+    job.bands = bands;
+    rf_parallel_for(rf_stbir_resize_band_job, &job, band_count);
+
+    RF_FREE(temp_allocator, memory);
+
+    return true;
+}
+
+#pragma endregion
+
 // Resize and image to new size.
 // Note: Uses stb default scaling filters (both bicubic): STBIR_DEFAULT_FILTER_UPSAMPLE STBIR_FILTER_CATMULLROM STBIR_DEFAULT_FILTER_DOWNSAMPLE STBIR_FILTER_MITCHELL (high-quality Catmull-Rom)
+// Exact 2x downscales use a 2x2 box filter instead. Large images are resized in bands on the job system (see rf_set_job_system).
 RF_API rf_image rf_image_resize_to_buffer(rf_image image, int new_width, int new_height, void* dst, rf_int dst_size, rf_allocator temp_allocator)
 {
-    if (!image.valid || dst_size < new_width * new_height * rf_bytes_per_pixel(image.format)) return (rf_image){0};
+    if (!image.valid || new_width <= 0 || new_height <= 0 || dst_size < new_width * new_height * rf_bytes_per_pixel(image.format)) return (rf_image){0};
 
     rf_image result = {0};
 
@@ -15861,41 +18634,42 @@ RF_API rf_image rf_image_resize_to_buffer(rf_image image, int new_width, int new
 
     if (stb_format)
     {
-        RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(temp_allocator);
-        stbir_resize_uint8((unsigned char*) image.data, image.width, image.height, 0, (unsigned char*) dst, new_width, new_height, 0, stb_format);
-        RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(RF_NULL_ALLOCATOR);
-
-        result.data   = dst;
-        result.width  = new_width;
-        result.height = new_height;
-        result.format = image.format;
-        result.valid  = true;
+        if (rf_resize_u8((unsigned char*) image.data, image.width, image.height, (unsigned char*) dst, new_width, new_height, stb_format, temp_allocator))
+        {
+            result.data   = dst;
+            result.width  = new_width;
+            result.height = new_height;
+            result.format = image.format;
+            result.valid  = true;
+        }
     }
     else // if the format of the image is not supported by stbir
     {
-        int pixels_size = image.width * image.height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
-        rf_color* pixels = RF_ALLOC(temp_allocator, pixels_size);
+        int pixels_size     = image.width * image.height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
+        int new_pixels_size = new_width * new_height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
+        rf_color* pixels     = RF_ALLOC(temp_allocator, pixels_size);
+        rf_color* new_pixels = RF_ALLOC(temp_allocator, new_pixels_size);
 
-        if (pixels)
+        if (pixels && new_pixels)
         {
             bool format_success = rf_format_pixels_to_rgba32(image.data, rf_image_size(image), image.format, pixels, pixels_size);
             RF_ASSERT(format_success);
 
-            RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(temp_allocator);
-            stbir_resize_uint8((unsigned char*)pixels, image.width, image.height, 0, (unsigned char*) dst, new_width, new_height, 0, 4);
-            RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(RF_NULL_ALLOCATOR);
-
-            format_success = rf_format_pixels(pixels, pixels_size, RF_UNCOMPRESSED_R8G8B8A8, dst, dst_size, image.format);
-            RF_ASSERT(format_success);
+            if (rf_resize_u8((unsigned char*) pixels, image.width, image.height, (unsigned char*) new_pixels, new_width, new_height, 4, temp_allocator))
+            {
+                format_success = rf_format_pixels(new_pixels, new_pixels_size, RF_UNCOMPRESSED_R8G8B8A8, dst, dst_size, image.format);
+                RF_ASSERT(format_success);
 
-            result.data   = dst;
-            result.width  = new_width;
-            result.height = new_height;
-            result.format = image.format;
-            result.valid  = true;
+                result.data   = dst;
+                result.width  = new_width;
+                result.height = new_height;
+                result.format = image.format;
+                result.valid  = true;
+            }
         }
-        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", image.width * image.height * sizeof(rf_color));
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", pixels ? new_pixels_size : pixels_size);
 
+        RF_FREE(temp_allocator, new_pixels);
         RF_FREE(temp_allocator, pixels);
     }
 
@@ -16030,7 +18804,7 @@ RF_API rf_image rf_image_format(rf_image image, rf_uncompressed_pixel_format new
     {
         if (rf_is_uncompressed_format(new_format) && rf_is_uncompressed_format(image.format))
         {
-            int dst_size = image.width * image.height * rf_bytes_per_pixel(image.format);
+            int dst_size = image.width * image.height * rf_bytes_per_pixel(new_format);
             void* dst = RF_ALLOC(allocator, dst_size);
 
             if (dst)
@@ -16167,33 +18941,137 @@ RF_API rf_image rf_image_alpha_premultiply(rf_image image, rf_allocator allocato
     return result;
 }
 
-RF_API rf_rec rf_image_alpha_crop_rec(rf_image image, float threshold)
+// Returns the index of the first rgba32 pixel in [begin, end) with an alpha over the threshold, or -1 if there is none
+RF_INTERNAL rf_int rf_find_first_alpha_over(const rf_color* pixels, rf_int begin, rf_int end, unsigned char threshold)
+{
+    rf_int i = begin;
+
+    // Skip 4 pixels at a time while none is over the threshold, the scalar loop then finds the exact one
+    #if defined(RF_SIMD_SSE2)
+    __m128i alpha_threshold = _mm_set1_epi32(threshold);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128i alpha = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(pixels + i)), 24);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(alpha, alpha_threshold))) break;
+    }
+    #elif defined(RF_SIMD_NEON)
+    uint32x4_t alpha_threshold = vdupq_n_u32(threshold);
+    for (; i + 4 <= end; i += 4)
+    {
+        uint32x4_t over = vcgtq_u32(vshrq_n_u32(vld1q_u32((const uint32_t*)(pixels + i)), 24), alpha_threshold);
+        if (vmaxvq_u32(over)) break;
+    }
+    #endif
+
+    for (; i < end; i++)
+    {
+        if (pixels[i].a > threshold) return i;
+    }
+
+    return -1;
+}
+
+// Returns the index of the last rgba32 pixel in [begin, end) with an alpha over the threshold, or -1 if there is none
+RF_INTERNAL rf_int rf_find_last_alpha_over(const rf_color* pixels, rf_int begin, rf_int end, unsigned char threshold)
 {
-    if (!image.valid) return (rf_rec){0};
+    rf_int i = end;
+
+    #if defined(RF_SIMD_SSE2)
+    __m128i alpha_threshold = _mm_set1_epi32(threshold);
+    for (; i - 4 >= begin; i -= 4)
+    {
+        __m128i alpha = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(pixels + i - 4)), 24);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(alpha, alpha_threshold))) break;
+    }
+    #elif defined(RF_SIMD_NEON)
+    uint32x4_t alpha_threshold = vdupq_n_u32(threshold);
+    for (; i - 4 >= begin; i -= 4)
+    {
+        uint32x4_t over = vcgtq_u32(vshrq_n_u32(vld1q_u32((const uint32_t*)(pixels + i - 4)), 24), alpha_threshold);
+        if (vmaxvq_u32(over)) break;
+    }
+    #endif
+
+    for (i = i - 1; i >= begin; i--)
+    {
+        if (pixels[i].a > threshold) return i;
+    }
+
+    return -1;
+}
 
+// Returns the first (or last if reverse is true) x in [begin, end) of row y with an alpha over the threshold, or -1 if there is none
+RF_INTERNAL rf_int rf_image_alpha_scan_row(rf_image image, rf_int y, rf_int begin, rf_int end, unsigned char threshold, bool reverse)
+{
     int bpp = rf_bytes_per_pixel(image.format);
+    const unsigned char* row = (unsigned char*) image.data + y * image.width * bpp;
 
-    int x_min = INT_MAX;
-    int x_max = 0;
-    int y_min = INT_MAX;
-    int y_max = 0;
+    if (image.format == RF_UNCOMPRESSED_R8G8B8A8)
+    {
+        return reverse ? rf_find_last_alpha_over((const rf_color*) row, begin, end, threshold) : rf_find_first_alpha_over((const rf_color*) row, begin, end, threshold);
+    }
 
-    char* src = image.data;
+    // Other formats are converted to rgba32 one chunk at a time, in the direction of the search
+    rf_color chunk[RF_ALPHA_SCAN_CHUNK_SIZE];
 
-    for (rf_int y = 0; y < image.height; y++)
+    for (rf_int done = 0; done < end - begin; done += RF_ALPHA_SCAN_CHUNK_SIZE)
     {
-        for (rf_int x = 0; x < image.width; x++)
+        rf_int count = rf_min_i(RF_ALPHA_SCAN_CHUNK_SIZE, (int)(end - begin - done));
+        rf_int chunk_begin = reverse ? end - done - count : begin + done;
+
+        rf_format_pixels_to_rgba32(row + chunk_begin * bpp, count * bpp, image.format, chunk, sizeof(chunk));
+
+        rf_int found = reverse ? rf_find_last_alpha_over(chunk, 0, count, threshold) : rf_find_first_alpha_over(chunk, 0, count, threshold);
+        if (found >= 0) return chunk_begin + found;
+    }
+
+    return -1;
+}
+
+/*
+ Get the smallest rectangle that contains all pixels with an alpha over the threshold. Returns an empty rectangle if there are none.
+ The first and last such rows are searched from the top and the bottom, then the rows between them only need
+ to be searched left of the leftmost and right of the rightmost pixel found so far.
+*/
+RF_API rf_rec rf_image_alpha_crop_rec(rf_image image, float threshold)
+{
+    if (!image.valid || !rf_is_uncompressed_format(image.format)) return (rf_rec){0};
+
+    unsigned char alpha_threshold = (unsigned char)(threshold * 255.0f);
+
+    rf_int x_min = -1;
+    rf_int x_max = -1;
+    rf_int y_min = 0;
+    rf_int y_max = image.height - 1;
+
+    for (; y_min < image.height && x_min < 0; y_min++)
+    {
+        x_min = rf_image_alpha_scan_row(image, y_min, 0, image.width, alpha_threshold, false);
+    }
+
+    if (x_min < 0) return (rf_rec){0};
+    y_min--;
+
+    for (; y_max > y_min && x_max < 0; y_max--)
+    {
+        x_max = rf_image_alpha_scan_row(image, y_max, 0, image.width, alpha_threshold, true);
+    }
+
+    if (x_max < 0) y_max = y_min;
+    else y_max++;
+
+    for (rf_int y = y_min; y <= y_max; y++)
+    {
+        if (x_min > 0)
         {
-            int pixel = (y * image.width + x) * bpp;
-            rf_color pixel_rgba32 = rf_format_one_pixel_to_rgba32(&src[pixel], image.format);
+            rf_int x = rf_image_alpha_scan_row(image, y, 0, x_min, alpha_threshold, false);
+            if (x >= 0) x_min = x;
+        }
 
-            if (pixel_rgba32.a > (unsigned char)(threshold * 255.0f))
-            {
-                if (x < x_min) x_min = x;
-                if (x > x_max) x_max = x;
-                if (y < y_min) y_min = y;
-                if (y > y_max) y_max = y;
-            }
+        if (x_max < image.width - 1)
+        {
+            rf_int x = rf_image_alpha_scan_row(image, y, x_max + 1, image.width, alpha_threshold, true);
+            if (x >= 0) x_max = x;
         }
     }
 
@@ -16208,111 +19086,259 @@ RF_API rf_image rf_image_alpha_crop(rf_image image, float threshold, rf_allocato
     return rf_image_crop(image, crop, allocator);
 }
 
-// Dither image data to 16bpp or lower (Floyd-Steinberg dithering) Note: In case selected bpp do not represent an known 16bit format, dithered data is stored in the LSB part of the unsigned short
-RF_API rf_image rf_image_dither(const rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, rf_allocator allocator, rf_allocator temp_allocator)
+#pragma region dither
+
+#define RF_DITHER_CHUNK_SIZE    (256)
+#define RF_DITHER_ROWS_PER_JOB  (32)
+
+// Returns the 16bpp format matching the requested bits per channel, or 0 if there is none
+RF_INTERNAL rf_uncompressed_pixel_format rf_dither_format(int r_bpp, int g_bpp, int b_bpp, int a_bpp)
+{
+    if (r_bpp == 5 && g_bpp == 6 && b_bpp == 5 && a_bpp == 0) return RF_UNCOMPRESSED_R5G6B5;
+    if (r_bpp == 5 && g_bpp == 5 && b_bpp == 5 && a_bpp == 1) return RF_UNCOMPRESSED_R5G5B5A1;
+    if (r_bpp == 4 && g_bpp == 4 && b_bpp == 4 && a_bpp == 4) return RF_UNCOMPRESSED_R4G4B4A4;
+
+    RF_LOG_ERROR(RF_BAD_ARGUMENT, "Unsupported dithering bpps: %ibpp (R%i G%i B%i A%i), only R5G6B5, R5G5B5A1 and R4G4B4A4 are supported", (r_bpp + g_bpp + b_bpp + a_bpp), r_bpp, g_bpp, b_bpp, a_bpp);
+    return 0;
+}
+
+// Value a quantized channel has once expanded back to 8 bits, which is what the error has to be computed against
+RF_INTERNAL inline int rf_dither_expand(unsigned int v, int bits)
+{
+    switch (bits)
+    {
+        case 4: return rf_expand_4bit(v);
+        case 5: return rf_expand_5bit(v);
+        case 6: return rf_expand_6bit(v);
+        default: return 0;
+    }
+}
+
+RF_INTERNAL inline unsigned short rf_dither_pack(rf_uncompressed_pixel_format format, unsigned int r, unsigned int g, unsigned int b, unsigned int a)
+{
+    switch (format)
+    {
+        case RF_UNCOMPRESSED_R5G6B5:   return (unsigned short)(r << 11 | g << 5 | b);
+        case RF_UNCOMPRESSED_R5G5B5A1: return (unsigned short)(r << 11 | g << 6 | b << 1 | (a > RF_R5G5B5A1_ALPHA_THRESHOLD ? 1 : 0));
+        case RF_UNCOMPRESSED_R4G4B4A4: return (unsigned short)(r << 12 | g << 8 | b << 4 | rf_quantize_u8(a, 15));
+        default: return 0;
+    }
+}
+
+RF_INTERNAL rf_image rf_dither_check_args(rf_image image, rf_uncompressed_pixel_format format, void* dst, rf_int dst_size)
 {
     rf_image result = {0};
 
-    if (image.valid)
+    if (!image.valid || !rf_is_uncompressed_format(image.format))
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Function only works for valid uncompressed images.");
+        return result;
+    }
+
+    if (!format) return result;
+
+    rf_int size = image.width * image.height * sizeof(unsigned short);
+    if (!dst || dst_size < size)
+    {
+        RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expects a buffer of at least size %d", dst_size, size);
+        return result;
+    }
+
+    if (image.format != RF_UNCOMPRESSED_R8G8B8 && image.format != RF_UNCOMPRESSED_R8G8B8A8)
+    {
+        RF_LOG(RF_LOG_TYPE_WARNING, "rf_image format is already 16bpp or lower, dithering could have no effect");
+    }
+
+    return (rf_image) { .data = dst, .width = image.width, .height = image.height, .format = format, .valid = true };
+}
+
+// Dither image data to a 16bpp format (Floyd-Steinberg dithering). Only the rgb channels are dithered. Supported bpps are R5G6B5, R5G5B5A1 and R4G4B4A4.
+RF_API rf_image rf_image_dither_to_buffer(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, void* dst, rf_int dst_size, rf_allocator temp_allocator)
+{
+    rf_image result = rf_dither_check_args(image, rf_dither_format(r_bpp, g_bpp, b_bpp, a_bpp), dst, dst_size);
+    if (!result.valid) return result;
+
+    // One row of rgba32 pixels, then the error rows for the current and the next row, with one pixel of padding on each side and 3 channels per pixel
+    rf_int errors_row_size = (image.width + 2) * 3;
+    rf_int temp_size = image.width * sizeof(rf_color) + errors_row_size * 2 * sizeof(int);
+    rf_color* row = RF_ALLOC(temp_allocator, temp_size);
+
+    if (!row)
+    {
+        RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", temp_size);
+        return (rf_image) {0};
+    }
+
+    int* current = (int*)(row + image.width);
+    int* next    = current + errors_row_size;
+    memset(current, 0, errors_row_size * sizeof(int));
+
+    int bits[3]   = { r_bpp, g_bpp, b_bpp };
+    int levels[3] = { (1 << r_bpp) - 1, (1 << g_bpp) - 1, (1 << b_bpp) - 1 };
+
+    int src_bpp = rf_bytes_per_pixel(image.format);
+    rf_int src_row_size = image.width * src_bpp;
+    unsigned short* dst_pixels = dst;
+
+    for (rf_int y = 0; y < image.height; y++)
     {
-        if (image.format == RF_UNCOMPRESSED_R8G8B8)
+        rf_format_pixels_to_rgba32((unsigned char*) image.data + y * src_row_size, src_row_size, image.format, row, image.width * sizeof(rf_color));
+        memset(next, 0, errors_row_size * sizeof(int));
+
+        for (rf_int x = 0; x < image.width; x++)
         {
-            if (image.format == RF_UNCOMPRESSED_R8G8B8 && (r_bpp + g_bpp + b_bpp + a_bpp) < 16)
+            unsigned int channels[4] = { row[x].r, row[x].g, row[x].b, row[x].a };
+            unsigned int quantized[3];
+
+            for (int c = 0; c < 3; c++)
             {
-                rf_color* pixels = rf_image_pixels_to_rgba32(image, temp_allocator);
+                // Errors are kept multiplied by 16 so the 7/16, 3/16, 5/16, 1/16 weights are exact
+                int value = rf_max_i(0, rf_min_i(255, (int) channels[c] + current[(x + 1) * 3 + c] / 16));
+                quantized[c] = rf_quantize_u8(value, levels[c]);
 
-                if ((image.format != RF_UNCOMPRESSED_R8G8B8) && (image.format != RF_UNCOMPRESSED_R8G8B8A8))
-                {
-                    RF_LOG(RF_LOG_TYPE_WARNING, "rf_image format is already 16bpp or lower, dithering could have no effect");
-                }
+                int error = value - rf_dither_expand(quantized[c], bits[c]);
+                current[(x + 2) * 3 + c] += error * 7;
+                next   [(x + 0) * 3 + c] += error * 3;
+                next   [(x + 1) * 3 + c] += error * 5;
+                next   [(x + 2) * 3 + c] += error;
+            }
 
-                // Todo: Finish implementing this function
-//                // Define new image format, check if desired bpp match internal known format
-//                if ((r_bpp == 5) && (g_bpp == 6) && (b_bpp == 5) && (a_bpp == 0)) image.format = RF_UNCOMPRESSED_R5G6B5;
-//                else if ((r_bpp == 5) && (g_bpp == 5) && (b_bpp == 5) && (a_bpp == 1)) image.format = RF_UNCOMPRESSED_R5G5B5A1;
-//                else if ((r_bpp == 4) && (g_bpp == 4) && (b_bpp == 4) && (a_bpp == 4)) image.format = RF_UNCOMPRESSED_R4G4B4A4;
-//                else
-//                {
-//                    image.format = 0;
-//                    RF_LOG(RF_LOG_TYPE_WARNING, "Unsupported dithered OpenGL internal format: %ibpp (R%i_g%i_b%i_a%i)", (r_bpp + g_bpp + b_bpp + a_bpp), r_bpp, g_bpp, b_bpp, a_bpp);
-//                }
-//
-//                // NOTE: We will store the dithered data as unsigned short (16bpp)
-//                image.data = (unsigned short*) RF_ALLOC(image.allocator, image.width * image.height * sizeof(unsigned short));
+            dst_pixels[y * image.width + x] = rf_dither_pack(result.format, quantized[0], quantized[1], quantized[2], channels[3]);
+        }
 
-                rf_color old_pixel = RF_WHITE;
-                rf_color new_pixel  = RF_WHITE;
+        int* swap = current;
+        current = next;
+        next = swap;
+    }
 
-                int r_error, g_error, b_error;
-                unsigned short r_pixel, g_pixel, b_pixel, a_pixel; // Used for 16bit pixel composition
+    RF_FREE(temp_allocator, row);
 
-                for (rf_int y = 0; y < image.height; y++)
-                {
-                    for (rf_int x = 0; x < image.width; x++)
-                    {
-                        old_pixel = pixels[y * image.width + x];
+    return result;
+}
 
-                        // NOTE: New pixel obtained by bits truncate, it would be better to round values (check rf_image_format())
-                        new_pixel.r = old_pixel.r >> (8 - r_bpp); // R bits
-                        new_pixel.g = old_pixel.g >> (8 - g_bpp); // G bits
-                        new_pixel.b = old_pixel.b >> (8 - b_bpp); // B bits
-                        new_pixel.a = old_pixel.a >> (8 - a_bpp); // A bits (not used on dithering)
+RF_API rf_image rf_image_dither(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    rf_image result = {0};
 
-                        // NOTE: Error must be computed between new and old pixel but using same number of bits!
-                        // We want to know how much color precision we have lost...
-                        r_error = (int)old_pixel.r - (int)(new_pixel.r << (8 - r_bpp));
-                        g_error = (int)old_pixel.g - (int)(new_pixel.g << (8 - g_bpp));
-                        b_error = (int)old_pixel.b - (int)(new_pixel.b << (8 - b_bpp));
+    if (image.valid && rf_dither_format(r_bpp, g_bpp, b_bpp, a_bpp))
+    {
+        rf_int size = image.width * image.height * sizeof(unsigned short);
+        void* dst = RF_ALLOC(allocator, size);
 
-                        pixels[y*image.width + x] = new_pixel;
+        if (dst)
+        {
+            result = rf_image_dither_to_buffer(image, r_bpp, g_bpp, b_bpp, a_bpp, dst, size, temp_allocator);
+            if (!result.valid) RF_FREE(allocator, dst);
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", size);
+    }
 
-                        // NOTE: Some cases are out of the array and should be ignored
-                        if (x < (image.width - 1))
-                        {
-                            pixels[y*image.width + x+1].r = rf_min_i((int)pixels[y * image.width + x + 1].r + (int)((float)r_error * 7.0f / 16), 0xff);
-                            pixels[y*image.width + x+1].g = rf_min_i((int)pixels[y * image.width + x + 1].g + (int)((float)g_error * 7.0f / 16), 0xff);
-                            pixels[y*image.width + x+1].b = rf_min_i((int)pixels[y * image.width + x + 1].b + (int)((float)b_error * 7.0f / 16), 0xff);
-                        }
+    return result;
+}
 
-                        if ((x > 0) && (y < (image.height - 1)))
-                        {
-                            pixels[(y+1)*image.width + x-1].r = rf_min_i((int)pixels[(y + 1) * image.width + x - 1].r + (int)((float)r_error * 3.0f / 16), 0xff);
-                            pixels[(y+1)*image.width + x-1].g = rf_min_i((int)pixels[(y + 1) * image.width + x - 1].g + (int)((float)g_error * 3.0f / 16), 0xff);
-                            pixels[(y+1)*image.width + x-1].b = rf_min_i((int)pixels[(y + 1) * image.width + x - 1].b + (int)((float)b_error * 3.0f / 16), 0xff);
-                        }
+// 8x8 Bayer matrix, thresholds in [0, 63]
+RF_INTERNAL const unsigned char rf_bayer_matrix_8x8[8][8] =
+{
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
 
-                        if (y < (image.height - 1))
-                        {
-                            pixels[(y+1)*image.width + x].r = rf_min_i((int)pixels[(y+1)*image.width + x].r + (int)((float)r_error*5.0f/16), 0xff);
-                            pixels[(y+1)*image.width + x].g = rf_min_i((int)pixels[(y+1)*image.width + x].g + (int)((float)g_error*5.0f/16), 0xff);
-                            pixels[(y+1)*image.width + x].b = rf_min_i((int)pixels[(y+1)*image.width + x].b + (int)((float)b_error*5.0f/16), 0xff);
-                        }
+typedef struct rf_dither_ordered_job_data
+{
+    rf_image image;
+    unsigned short* dst;
+    rf_uncompressed_pixel_format dst_format;
+    int levels[3];
+    signed char offsets[3][64]; // Bayer offsets of every channel, centered around 0
+} rf_dither_ordered_job_data;
 
-                        if ((x < (image.width - 1)) && (y < (image.height - 1)))
-                        {
-                            pixels[(y+1)*image.width + x+1].r = rf_min_i((int)pixels[(y+1)*image.width + x+1].r + (int)((float)r_error*1.0f/16), 0xff);
-                            pixels[(y+1)*image.width + x+1].g = rf_min_i((int)pixels[(y+1)*image.width + x+1].g + (int)((float)g_error*1.0f/16), 0xff);
-                            pixels[(y+1)*image.width + x+1].b = rf_min_i((int)pixels[(y+1)*image.width + x+1].b + (int)((float)b_error*1.0f/16), 0xff);
-                        }
+RF_INTERNAL void rf_dither_ordered_job(void* job_data, rf_int job_index)
+{
+    rf_dither_ordered_job_data* data = job_data;
+    rf_image image = data->image;
 
-                        r_pixel = (unsigned short)new_pixel.r;
-                        g_pixel = (unsigned short)new_pixel.g;
-                        b_pixel = (unsigned short)new_pixel.b;
-                        a_pixel = (unsigned short)new_pixel.a;
+    int src_bpp = rf_bytes_per_pixel(image.format);
+    rf_int y_end = rf_min_i((int)((job_index + 1) * RF_DITHER_ROWS_PER_JOB), image.height);
+    rf_color chunk[RF_DITHER_CHUNK_SIZE];
 
-                        ((unsigned short *)image.data)[y*image.width + x] = (r_pixel << (g_bpp + b_bpp + a_bpp)) | (g_pixel << (b_bpp + a_bpp)) | (b_pixel << a_bpp) | a_pixel;
-                    }
-                }
+    for (rf_int y = job_index * RF_DITHER_ROWS_PER_JOB; y < y_end; y++)
+    {
+        const signed char* offsets[3] = { data->offsets[0] + (y & 7) * 8, data->offsets[1] + (y & 7) * 8, data->offsets[2] + (y & 7) * 8 };
+
+        for (rf_int x_begin = 0; x_begin < image.width; x_begin += RF_DITHER_CHUNK_SIZE)
+        {
+            rf_int count = rf_min_i(RF_DITHER_CHUNK_SIZE, (int)(image.width - x_begin));
+            const unsigned char* src = (unsigned char*) image.data + (y * image.width + x_begin) * src_bpp;
+            unsigned short* dst = data->dst + y * image.width + x_begin;
 
-                RF_FREE(temp_allocator, pixels);
+            rf_format_pixels_to_rgba32(src, count * src_bpp, image.format, chunk, sizeof(chunk));
+
+            for (rf_int i = 0; i < count; i++)
+            {
+                int t = (int)((x_begin + i) & 7);
+                unsigned int r = rf_quantize_u8(rf_max_i(0, rf_min_i(255, chunk[i].r + offsets[0][t])), data->levels[0]);
+                unsigned int g = rf_quantize_u8(rf_max_i(0, rf_min_i(255, chunk[i].g + offsets[1][t])), data->levels[1]);
+                unsigned int b = rf_quantize_u8(rf_max_i(0, rf_min_i(255, chunk[i].b + offsets[2][t])), data->levels[2]);
+
+                dst[i] = rf_dither_pack(data->dst_format, r, g, b, chunk[i].a);
             }
-            else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Unsupported dithering bpps (%ibpp), only 16bpp or lower modes supported", (r_bpp + g_bpp + b_bpp + a_bpp));
         }
     }
+}
+
+// Dither image data to a 16bpp format using an 8x8 Bayer matrix. Rows are independent so this runs on the job system. Supported bpps are R5G6B5, R5G5B5A1 and R4G4B4A4.
+RF_API rf_image rf_image_dither_ordered_to_buffer(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, void* dst, rf_int dst_size)
+{
+    rf_image result = rf_dither_check_args(image, rf_dither_format(r_bpp, g_bpp, b_bpp, a_bpp), dst, dst_size);
+    if (!result.valid) return result;
+
+    rf_dither_ordered_job_data data = { .image = image, .dst = dst, .dst_format = result.format };
+    int bits[3] = { r_bpp, g_bpp, b_bpp };
+
+    for (int c = 0; c < 3; c++)
+    {
+        data.levels[c] = (1 << bits[c]) - 1;
+
+        for (int t = 0; t < 64; t++)
+        {
+            // The spread is slightly under one quantization step so that colors which are exactly representable come out unchanged
+            data.offsets[c][t] = (signed char)(((2 * rf_bayer_matrix_8x8[t / 8][t % 8] + 1 - 64) * (255 - data.levels[c])) / (128 * data.levels[c]));
+        }
+    }
+
+    rf_parallel_for(rf_dither_ordered_job, &data, (image.height + RF_DITHER_ROWS_PER_JOB - 1) / RF_DITHER_ROWS_PER_JOB);
+
+    return result;
+}
+
+RF_API rf_image rf_image_dither_ordered(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp, rf_allocator allocator)
+{
+    rf_image result = {0};
+
+    if (image.valid && rf_dither_format(r_bpp, g_bpp, b_bpp, a_bpp))
+    {
+        rf_int size = image.width * image.height * sizeof(unsigned short);
+        void* dst = RF_ALLOC(allocator, size);
+
+        if (dst)
+        {
+            result = rf_image_dither_ordered_to_buffer(image, r_bpp, g_bpp, b_bpp, a_bpp, dst, size);
+            if (!result.valid) RF_FREE(allocator, dst);
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", size);
+    }
 
     return result;
 }
 
+#pragma endregion
+
 // Flip image vertically
 RF_API rf_image rf_image_flip_vertical_to_buffer(rf_image image, void* dst, rf_int dst_size)
 {
@@ -16322,27 +19348,51 @@ RF_API rf_image rf_image_flip_vertical_to_buffer(rf_image image, void* dst, rf_i
     {
         if (dst_size >= rf_image_size(image))
         {
-            int bpp = rf_bytes_per_pixel(image.format);
-
-            for (rf_int y = 0; y < image.height; y++)
+            if (dst == image.data)
             {
-                for (rf_int x = 0; x < image.width; x++)
-                {
-                    void* dst_pixel = ((unsigned char*)dst) + (y * image.width + x) * bpp;
-                    void* src_pixel = ((unsigned char*)image.data) + ((image.height - 1 - y) * image.width + x) * bpp;
+                rf_image_flip_vertical_in_place(&image);
+            }
+            else
+            {
+                rf_int row_size = image.width * rf_bytes_per_pixel(image.format);
 
-                    memcpy(dst_pixel, src_pixel, bpp);
+                for (rf_int y = 0; y < image.height; y++)
+                {
+                    memcpy((unsigned char*) dst + y * row_size, (unsigned char*) image.data + (image.height - 1 - y) * row_size, row_size);
                 }
             }
 
             result = image;
             result.data = dst;
         }
+        else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expects a buffer of at least size %d", dst_size, rf_image_size(image));
     }
 
     return result;
 }
 
+RF_API void rf_image_flip_vertical_in_place(rf_image* image)
+{
+    if (!image || !image->valid || !rf_is_uncompressed_format(image->format)) return;
+
+    rf_int row_size = image->width * rf_bytes_per_pixel(image->format);
+    unsigned char swap[RF_FLIP_SWAP_CHUNK_SIZE];
+
+    for (rf_int y = 0; y < image->height / 2; y++)
+    {
+        unsigned char* top    = (unsigned char*) image->data + y * row_size;
+        unsigned char* bottom = (unsigned char*) image->data + (image->height - 1 - y) * row_size;
+
+        for (rf_int offset = 0; offset < row_size; offset += RF_FLIP_SWAP_CHUNK_SIZE)
+        {
+            rf_int count = rf_min_i(RF_FLIP_SWAP_CHUNK_SIZE, (int)(row_size - offset));
+            memcpy(swap, top + offset, count);
+            memcpy(top + offset, bottom + offset, count);
+            memcpy(bottom + offset, swap, count);
+        }
+    }
+}
+
 RF_API rf_image rf_image_flip_vertical(rf_image image, rf_allocator allocator)
 {
     if (!image.valid) return (rf_image) {0};
@@ -16366,26 +19416,30 @@ RF_API rf_image rf_image_flip_horizontal_to_buffer(rf_image image, void* dst, rf
         if (dst_size >= rf_image_size(image))
         {
             int bpp = rf_bytes_per_pixel(image.format);
+            rf_int row_size = image.width * bpp;
 
+            // Works in place as well, each row is reversed from both ends
             for (rf_int y = 0; y < image.height; y++)
             {
-                for (rf_int x = 0; x < image.width; x++)
-                {
-                    void* dst_pixel = ((unsigned char*)dst) + (y * image.width + x) * bpp;
-                    void* src_pixel = ((unsigned char*)image.data) + (y * image.width + (image.width - 1 - x)) * bpp;
-
-                    memcpy(dst_pixel, src_pixel, bpp);
-                }
+                rf_reverse_row((unsigned char*) image.data + y * row_size, (unsigned char*) dst + y * row_size, image.width, bpp);
             }
 
             result = image;
             result.data = dst;
         }
+        else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expects a buffer of at least size %d", dst_size, rf_image_size(image));
     }
 
     return result;
 }
 
+RF_API void rf_image_flip_horizontal_in_place(rf_image* image)
+{
+    if (!image || !image->valid || !rf_is_uncompressed_format(image->format)) return;
+
+    rf_image_flip_horizontal_to_buffer(*image, image->data, rf_image_size(*image));
+}
+
 RF_API rf_image rf_image_flip_horizontal(rf_image image, rf_allocator allocator)
 {
     if (!image.valid) return (rf_image) {0};
@@ -16399,74 +19453,102 @@ RF_API rf_image rf_image_flip_horizontal(rf_image image, rf_allocator allocator)
     return result;
 }
 
-// Rotate image clockwise 90deg
+// Rotate image clockwise 90deg. dst must not be the image data, use rf_image_rotate_cw_in_place for that.
 RF_API rf_image rf_image_rotate_cw_to_buffer(rf_image image, void* dst, rf_int dst_size)
 {
     rf_image result = {0};
 
-    if (image.valid)
+    if (image.valid && rf_is_uncompressed_format(image.format) && dst != image.data)
     {
         if (dst_size >= rf_image_size(image))
         {
-            int bpp = rf_bytes_per_pixel(image.format);
-
-            for (rf_int y = 0; y < image.height; y++)
-            {
-                for (rf_int x = 0; x < image.width; x++)
-                {
-                    void* dst_pixel = ((unsigned char*)dst) + (x * image.height + (image.height - y - 1)) * bpp;
-                    void* src_pixel = ((unsigned char*)image.data) + (y * image.width + x) * bpp;
-
-                    memcpy(dst_pixel, src_pixel, bpp);
-                }
-            }
+            rf_rotate_90(image, dst, true);
 
             result = image;
-            result.data = dst;
+            result.data   = dst;
+            result.width  = image.height;
+            result.height = image.width;
         }
+        else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expects a buffer of at least size %d", dst_size, rf_image_size(image));
     }
+    else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image must be valid and uncompressed and dst must not be the image data.");
+
+    return result;
+}
+
+RF_API rf_image rf_image_rotate_cw(rf_image image, rf_allocator allocator)
+{
+    if (!image.valid) return (rf_image) {0};
+
+    int size = rf_image_size(image);
+    void* dst = RF_ALLOC(allocator, size);
+
+    rf_image result = rf_image_rotate_cw_to_buffer(image, dst, size);
+    if (!result.valid) RF_FREE(allocator, dst);
 
     return result;
 }
 
-RF_API rf_image rf_image_rotate_cw(rf_image image)
+// Rotate a square image clockwise 90deg without a second buffer (transpose, then flip each row)
+RF_API void rf_image_rotate_cw_in_place(rf_image* image)
 {
-    return rf_image_rotate_cw_to_buffer(image, image.data, rf_image_size(image));
+    if (!image || !image->valid || !rf_is_uncompressed_format(image->format)) return;
+
+    if (image->width == image->height)
+    {
+        rf_transpose_square_in_place(image->data, image->width, rf_bytes_per_pixel(image->format));
+        rf_image_flip_horizontal_in_place(image);
+    }
+    else RF_LOG_ERROR(RF_UNSUPPORTED, "Only square images can be rotated in place.");
 }
 
-// Rotate image counter-clockwise 90deg
+// Rotate image counter-clockwise 90deg. dst must not be the image data, use rf_image_rotate_ccw_in_place for that.
 RF_API rf_image rf_image_rotate_ccw_to_buffer(rf_image image, void* dst, rf_int dst_size)
 {
     rf_image result = {0};
 
-    if (image.valid)
+    if (image.valid && rf_is_uncompressed_format(image.format) && dst != image.data)
     {
         if (dst_size >= rf_image_size(image))
         {
-            int bpp = rf_bytes_per_pixel(image.format);
-
-            for (rf_int y = 0; y < image.height; y++)
-            {
-                for (rf_int x = 0; x < image.width; x++)
-                {
-                    void* dst_pixel = ((unsigned char*)dst) + (x * image.height + y) * bpp;
-                    void* src_pixel = ((unsigned char*)image.data) + (y * image.width + (image.width - x - 1)) * bpp;
-
-                    memcpy(dst_pixel, src_pixel, bpp);
-                }
-            }
+            rf_rotate_90(image, dst, false);
 
             result = image;
-            result.data = dst;
+            result.data   = dst;
+            result.width  = image.height;
+            result.height = image.width;
         }
+        else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expects a buffer of at least size %d", dst_size, rf_image_size(image));
     }
+    else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image must be valid and uncompressed and dst must not be the image data.");
 
     return result;
 }
 
-RF_API rf_image rf_image_rotate_ccw(rf_image image)
+RF_API rf_image rf_image_rotate_ccw(rf_image image, rf_allocator allocator)
 {
-    return rf_image_rotate_ccw_to_buffer(image, image.data, rf_image_size(image));
+    if (!image.valid) return (rf_image) {0};
+
+    int size = rf_image_size(image);
+    void* dst = RF_ALLOC(allocator, size);
+
+    rf_image result = rf_image_rotate_ccw_to_buffer(image, dst, size);
+    if (!result.valid) RF_FREE(allocator, dst);
+
+    return result;
+}
+
+// Rotate a square image counter-clockwise 90deg without a second buffer (transpose, then flip vertically)
+RF_API void rf_image_rotate_ccw_in_place(rf_image* image)
+{
+    if (!image || !image->valid || !rf_is_uncompressed_format(image->format)) return;
+
+    if (image->width == image->height)
+    {
+        rf_transpose_square_in_place(image->data, image->width, rf_bytes_per_pixel(image->format));
+        rf_image_flip_vertical_in_place(image);
+    }
+    else RF_LOG_ERROR(RF_UNSUPPORTED, "Only square images can be rotated in place.");
 }
 
 // Modify image color: tint
@@ -16747,6 +19829,446 @@ RF_API rf_image rf_image_color_replace(rf_image image, rf_color color, rf_color
     return rf_image_color_replace_to_buffer(image, color, replace, image.data, rf_image_size(image));
 }
 
+#pragma region image pipeline
+
+#define RF_IMAGE_PIPELINE_TILE_SIZE  (64)
+#define RF_IMAGE_PIPELINE_CHUNK_SIZE (256)
+
+RF_API rf_image_pipeline rf_image_pipeline_begin(rf_image image)
+{
+    rf_image_pipeline result = {0};
+
+    if (image.valid && rf_is_uncompressed_format(image.format))
+    {
+        result.image = image;
+        result.valid = true;
+    }
+    else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image pipelines only work on valid uncompressed images.");
+
+    return result;
+}
+
+RF_INTERNAL void rf_image_pipeline_push(rf_image_pipeline* pipeline, rf_image_op op)
+{
+    if (!pipeline->valid) return;
+
+    if (pipeline->ops_count < RF_IMAGE_PIPELINE_MAX_OPS)
+    {
+        pipeline->ops[pipeline->ops_count++] = op;
+    }
+    else
+    {
+        RF_LOG_ERROR(RF_LIMIT_REACHED, "Image pipeline is limited to %d operations.", RF_IMAGE_PIPELINE_MAX_OPS);
+        pipeline->valid = false;
+    }
+}
+
+RF_API void rf_image_pipeline_color_tint(rf_image_pipeline* pipeline, rf_color color) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_COLOR_TINT, .color = color }); }
+RF_API void rf_image_pipeline_color_invert(rf_image_pipeline* pipeline) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_COLOR_INVERT }); }
+RF_API void rf_image_pipeline_color_grayscale(rf_image_pipeline* pipeline) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_COLOR_GRAYSCALE }); }
+RF_API void rf_image_pipeline_color_contrast(rf_image_pipeline* pipeline, float contrast) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_COLOR_CONTRAST, .value = contrast }); }
+RF_API void rf_image_pipeline_color_brightness(rf_image_pipeline* pipeline, int brightness) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_COLOR_BRIGHTNESS, .value = (float) brightness }); }
+RF_API void rf_image_pipeline_color_replace(rf_image_pipeline* pipeline, rf_color color, rf_color replace) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_COLOR_REPLACE, .color = color, .replace = replace }); }
+RF_API void rf_image_pipeline_flip_vertical(rf_image_pipeline* pipeline) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_FLIP_VERTICAL }); }
+RF_API void rf_image_pipeline_flip_horizontal(rf_image_pipeline* pipeline) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_FLIP_HORIZONTAL }); }
+RF_API void rf_image_pipeline_rotate_cw(rf_image_pipeline* pipeline) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_ROTATE_CW }); }
+RF_API void rf_image_pipeline_rotate_ccw(rf_image_pipeline* pipeline) { rf_image_pipeline_push(pipeline, (rf_image_op) { .type = RF_IMAGE_OP_ROTATE_CCW }); }
+
+/*
+ Color ops that work on each channel on its own (tint, invert, contrast, brightness) are folded into lookup tables,
+ consecutive ones share the same table. Grayscale and replace mix the channels so they get a stage of their own.
+*/
+typedef enum rf_image_pipeline_stage_type
+{
+    RF_IMAGE_PIPELINE_STAGE_LUT,
+    RF_IMAGE_PIPELINE_STAGE_GRAYSCALE,
+    RF_IMAGE_PIPELINE_STAGE_REPLACE,
+} rf_image_pipeline_stage_type;
+
+typedef struct rf_image_pipeline_stage
+{
+    rf_image_pipeline_stage_type type;
+    rf_color color;
+    rf_color replace;
+    unsigned char lut[4][256];
+} rf_image_pipeline_stage;
+
+typedef struct rf_image_pipeline_job_data
+{
+    rf_image src;
+    unsigned char* dst;
+    int dst_width;
+    int dst_height;
+    int bpp;
+
+    // The geometric ops composed into one mapping from destination to source coordinates:
+    // src_x = transform[0] * x + transform[1] * y + transform[2]
+    // src_y = transform[3] * x + transform[4] * y + transform[5]
+    rf_int transform[6];
+
+    rf_image_pipeline_stage stages[RF_IMAGE_PIPELINE_MAX_OPS];
+    int stages_count;
+} rf_image_pipeline_job_data;
+
+// Same math as the rf_image_color_* functions so that a pipeline gives the same result as calling them one after the other
+RF_INTERNAL unsigned char rf_image_op_channel(rf_image_op op, int channel, unsigned char v)
+{
+    switch (op.type)
+    {
+        case RF_IMAGE_OP_COLOR_TINT:
+        {
+            unsigned char tint[4] = { op.color.r, op.color.g, op.color.b, op.color.a };
+            float c = ((float) tint[channel]) / 255.0f;
+            return (unsigned char) (255.f * (((float)v) / 255.f * c));
+        }
+
+        case RF_IMAGE_OP_COLOR_INVERT:
+            return channel < 3 ? 255 - v : v;
+
+        case RF_IMAGE_OP_COLOR_CONTRAST:
+        {
+            if (channel == 3) return v;
+
+            float contrast = op.value;
+            if (contrast < -100) contrast = -100;
+            if (contrast > +100) contrast = +100;
+
+            contrast = (100.0f + contrast) / 100.0f;
+            contrast *= contrast;
+
+            float p = ((float)v) / 255.0f;
+            p -= 0.5;
+            p *= contrast;
+            p += 0.5;
+            p *= 255;
+            if (p < 0) p = 0;
+            if (p > 255) p = 255;
+
+            return (unsigned char) p;
+        }
+
+        case RF_IMAGE_OP_COLOR_BRIGHTNESS:
+        {
+            if (channel == 3) return v;
+
+            int brightness = (int) op.value;
+            if (brightness < -255) brightness = -255;
+            if (brightness > +255) brightness = +255;
+
+            int c = v + brightness;
+            if (c < 0) c = 1;
+            if (c > 255) c = 255;
+
+            return (unsigned char) c;
+        }
+
+        default: return v;
+    }
+}
+
+RF_INTERNAL void rf_image_pipeline_compose(rf_int transform[6], const rf_int op[6])
+{
+    rf_int m[6];
+    memcpy(m, transform, sizeof(m));
+
+    transform[0] = m[0] * op[0] + m[1] * op[3];
+    transform[1] = m[0] * op[1] + m[1] * op[4];
+    transform[2] = m[0] * op[2] + m[1] * op[5] + m[2];
+    transform[3] = m[3] * op[0] + m[4] * op[3];
+    transform[4] = m[3] * op[1] + m[4] * op[4];
+    transform[5] = m[3] * op[2] + m[4] * op[5] + m[5];
+}
+
+RF_INTERNAL void rf_image_pipeline_compile(const rf_image_pipeline* pipeline, rf_image_pipeline_job_data* data)
+{
+    int width  = pipeline->image.width;
+    int height = pipeline->image.height;
+
+    rf_int identity[6] = { 1, 0, 0, 0, 1, 0 };
+    memcpy(data->transform, identity, sizeof(identity));
+    data->stages_count = 0;
+
+    // Formats without alpha read back as opaque, the alpha table is left alone so that it stays that way between ops
+    rf_uncompressed_pixel_format format = pipeline->image.format;
+    int channels = (format == RF_UNCOMPRESSED_GRAY_ALPHA || format == RF_UNCOMPRESSED_R5G5B5A1 || format == RF_UNCOMPRESSED_R4G4B4A4 || format == RF_UNCOMPRESSED_R8G8B8A8 || format == RF_UNCOMPRESSED_R32G32B32A32) ? 4 : 3;
+
+    for (int i = 0; i < pipeline->ops_count; i++)
+    {
+        rf_image_op op = pipeline->ops[i];
+
+        switch (op.type)
+        {
+            case RF_IMAGE_OP_COLOR_TINT:
+            case RF_IMAGE_OP_COLOR_INVERT:
+            case RF_IMAGE_OP_COLOR_CONTRAST:
+            case RF_IMAGE_OP_COLOR_BRIGHTNESS:
+            {
+                rf_image_pipeline_stage* stage = data->stages_count ? &data->stages[data->stages_count - 1] : NULL;
+
+                if (!stage || stage->type != RF_IMAGE_PIPELINE_STAGE_LUT)
+                {
+                    stage = &data->stages[data->stages_count++];
+                    stage->type = RF_IMAGE_PIPELINE_STAGE_LUT;
+
+                    for (int c = 0; c < 4; c++)
+                    {
+                        for (int v = 0; v < 256; v++) stage->lut[c][v] = (unsigned char) v;
+                    }
+                }
+
+                for (int c = 0; c < channels; c++)
+                {
+                    for (int v = 0; v < 256; v++) stage->lut[c][v] = rf_image_op_channel(op, c, stage->lut[c][v]);
+                }
+            }
+            break;
+
+            case RF_IMAGE_OP_COLOR_GRAYSCALE:
+                data->stages[data->stages_count++].type = RF_IMAGE_PIPELINE_STAGE_GRAYSCALE;
+                break;
+
+            case RF_IMAGE_OP_COLOR_REPLACE:
+                data->stages[data->stages_count++] = (rf_image_pipeline_stage) { .type = RF_IMAGE_PIPELINE_STAGE_REPLACE, .color = op.color, .replace = op.replace };
+                break;
+
+            // Each geometric op maps its output coordinates back to its input coordinates
+            case RF_IMAGE_OP_FLIP_VERTICAL:
+            {
+                rf_int flip[6] = { 1, 0, 0, 0, -1, height - 1 };
+                rf_image_pipeline_compose(data->transform, flip);
+            }
+            break;
+
+            case RF_IMAGE_OP_FLIP_HORIZONTAL:
+            {
+                rf_int flip[6] = { -1, 0, width - 1, 0, 1, 0 };
+                rf_image_pipeline_compose(data->transform, flip);
+            }
+            break;
+
+            case RF_IMAGE_OP_ROTATE_CW:
+            {
+                rf_int rotate[6] = { 0, 1, 0, -1, 0, height - 1 };
+                rf_image_pipeline_compose(data->transform, rotate);
+
+                int swap = width;
+                width = height;
+                height = swap;
+            }
+            break;
+
+            case RF_IMAGE_OP_ROTATE_CCW:
+            {
+                rf_int rotate[6] = { 0, -1, width - 1, 1, 0, 0 };
+                rf_image_pipeline_compose(data->transform, rotate);
+
+                int swap = width;
+                width = height;
+                height = swap;
+            }
+            break;
+
+            default: break;
+        }
+    }
+
+    data->dst_width  = width;
+    data->dst_height = height;
+}
+
+RF_INTERNAL void rf_image_pipeline_apply_stages(const rf_image_pipeline_job_data* data, rf_color* pixels, rf_int count)
+{
+    for (int s = 0; s < data->stages_count; s++)
+    {
+        const rf_image_pipeline_stage* stage = &data->stages[s];
+
+        switch (stage->type)
+        {
+            case RF_IMAGE_PIPELINE_STAGE_LUT:
+                for (rf_int i = 0; i < count; i++)
+                {
+                    pixels[i].r = stage->lut[0][pixels[i].r];
+                    pixels[i].g = stage->lut[1][pixels[i].g];
+                    pixels[i].b = stage->lut[2][pixels[i].b];
+                    pixels[i].a = stage->lut[3][pixels[i].a];
+                }
+                break;
+
+            case RF_IMAGE_PIPELINE_STAGE_GRAYSCALE:
+                // Same weights as the conversion to RF_UNCOMPRESSED_GRAYSCALE, but the format and alpha are kept
+                for (rf_int i = 0; i < count; i++)
+                {
+                    unsigned char gray = (unsigned char)((((float)pixels[i].r / 255.0f) * 0.299f + ((float)pixels[i].g / 255.0f) * 0.587f + ((float)pixels[i].b / 255.0f) * 0.114f) * 255.0f);
+                    pixels[i].r = gray;
+                    pixels[i].g = gray;
+                    pixels[i].b = gray;
+                }
+                break;
+
+            case RF_IMAGE_PIPELINE_STAGE_REPLACE:
+                for (rf_int i = 0; i < count; i++)
+                {
+                    if (rf_color_match(pixels[i], stage->color)) pixels[i] = stage->replace;
+                }
+                break;
+
+            default: break;
+        }
+    }
+}
+
+// Processes count pixels of destination row y starting at x
+RF_INTERNAL void rf_image_pipeline_run_span(const rf_image_pipeline_job_data* data, rf_int x, rf_int y, rf_int count)
+{
+    const rf_int* m = data->transform;
+    int bpp = data->bpp;
+
+    rf_int src_x = m[0] * x + m[1] * y + m[2];
+    rf_int src_y = m[3] * x + m[4] * y + m[5];
+    rf_int src_step = (m[0] + m[3] * data->src.width) * bpp;
+
+    const unsigned char* src = (unsigned char*) data->src.data + (src_y * data->src.width + src_x) * bpp;
+    unsigned char* dst = data->dst + (y * data->dst_width + x) * bpp;
+
+    bool rgba32 = data->src.format == RF_UNCOMPRESSED_R8G8B8A8;
+    bool contiguous = src_step == bpp;
+
+    // Gather the source pixels in destination order, straight into the destination when no conversion is needed
+    unsigned char gathered[RF_IMAGE_PIPELINE_CHUNK_SIZE * sizeof(rf_vec4)];
+    const unsigned char* span = src;
+
+    if (!contiguous)
+    {
+        unsigned char* gather_dst = (rgba32 || data->stages_count == 0) ? dst : gathered;
+
+        switch (bpp)
+        {
+            case 1: for (rf_int i = 0; i < count; i++, src += src_step) gather_dst[i] = *src; break;
+            case 2: for (rf_int i = 0; i < count; i++, src += src_step) memcpy(gather_dst + i * 2, src, 2); break;
+            case 4: for (rf_int i = 0; i < count; i++, src += src_step) memcpy(gather_dst + i * 4, src, 4); break;
+            default: for (rf_int i = 0; i < count; i++, src += src_step) memcpy(gather_dst + i * bpp, src, bpp); break;
+        }
+
+        span = gather_dst;
+    }
+    else if (rgba32 || data->stages_count == 0)
+    {
+        if (dst != src) memmove(dst, src, count * bpp);
+        span = dst;
+    }
+
+    if (data->stages_count == 0) return;
+
+    if (rgba32)
+    {
+        rf_image_pipeline_apply_stages(data, (rf_color*) dst, count);
+    }
+    else
+    {
+        rf_color pixels[RF_IMAGE_PIPELINE_CHUNK_SIZE];
+
+        rf_format_pixels_to_rgba32(span, count * bpp, data->src.format, pixels, sizeof(pixels));
+        rf_image_pipeline_apply_stages(data, pixels, count);
+        rf_format_pixels(pixels, count * sizeof(rf_color), RF_UNCOMPRESSED_R8G8B8A8, dst, count * bpp, data->src.format);
+    }
+}
+
+RF_INTERNAL void rf_image_pipeline_job(void* job_data, rf_int job_index)
+{
+    const rf_image_pipeline_job_data* data = job_data;
+
+    rf_int y_begin = job_index * RF_IMAGE_PIPELINE_TILE_SIZE;
+    rf_int y_end   = rf_min_i((int)(y_begin + RF_IMAGE_PIPELINE_TILE_SIZE), data->dst_height);
+
+    if (data->transform[0] == 0)
+    {
+        // Destination rows walk source columns, go tile by tile so that the source lines stay in cache
+        for (rf_int x = 0; x < data->dst_width; x += RF_IMAGE_PIPELINE_TILE_SIZE)
+        {
+            rf_int count = rf_min_i(RF_IMAGE_PIPELINE_TILE_SIZE, (int)(data->dst_width - x));
+            for (rf_int y = y_begin; y < y_end; y++) rf_image_pipeline_run_span(data, x, y, count);
+        }
+    }
+    else
+    {
+        for (rf_int y = y_begin; y < y_end; y++)
+        {
+            for (rf_int x = 0; x < data->dst_width; x += RF_IMAGE_PIPELINE_CHUNK_SIZE)
+            {
+                rf_image_pipeline_run_span(data, x, y, rf_min_i(RF_IMAGE_PIPELINE_CHUNK_SIZE, (int)(data->dst_width - x)));
+            }
+        }
+    }
+}
+
+/*
+ Executes all the recorded operations in one pass over the image and writes the result to dst, which needs to be rf_image_size(pipeline->image) big.
+ Color operations happen in rgba32, so like the rf_image_color_* functions, float formats are processed with 8 bits per channel.
+ dst can be the source image data only if the pipeline has no flips or rotations.
+*/
+RF_API rf_image rf_image_pipeline_execute_to_buffer(const rf_image_pipeline* pipeline, void* dst, rf_int dst_size)
+{
+    rf_image result = {0};
+
+    if (!pipeline || !pipeline->valid)
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image pipeline is invalid.");
+        return result;
+    }
+
+    rf_image image = pipeline->image;
+    rf_int size = rf_image_size(image);
+
+    if (!dst || dst_size < size)
+    {
+        RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expects a buffer of at least size %d", dst_size, size);
+        return result;
+    }
+
+    rf_image_pipeline_job_data data = { .src = image, .dst = dst, .bpp = rf_bytes_per_pixel(image.format) };
+    rf_image_pipeline_compile(pipeline, &data);
+
+    bool identity = data.transform[0] == 1 && data.transform[1] == 0 && data.transform[2] == 0 && data.transform[3] == 0 && data.transform[4] == 1 && data.transform[5] == 0;
+
+    if (!identity && dst == image.data)
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image pipelines with flips or rotations can't write to the source image.");
+        return result;
+    }
+
+    rf_parallel_for(rf_image_pipeline_job, &data, (data.dst_height + RF_IMAGE_PIPELINE_TILE_SIZE - 1) / RF_IMAGE_PIPELINE_TILE_SIZE);
+
+    result = image;
+    result.data   = dst;
+    result.width  = data.dst_width;
+    result.height = data.dst_height;
+
+    return result;
+}
+
+RF_API rf_image rf_image_pipeline_execute(const rf_image_pipeline* pipeline, rf_allocator allocator)
+{
+    rf_image result = {0};
+
+    if (pipeline && pipeline->valid)
+    {
+        rf_int size = rf_image_size(pipeline->image);
+        void* dst = RF_ALLOC(allocator, size);
+
+        if (dst)
+        {
+            result = rf_image_pipeline_execute_to_buffer(pipeline, dst, size);
+            if (!result.valid) RF_FREE(allocator, dst);
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", size);
+    }
+    else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image pipeline is invalid.");
+
+    return result;
+}
+
+#pragma endregion
+
 // Generate image: plain color
 RF_API rf_image rf_gen_image_color_to_buffer(int width, int height, rf_color color, rf_color* dst, rf_int dst_size)
 {
@@ -16983,7 +20505,52 @@ RF_API rf_image rf_gen_image_checked(int width, int height, int checks_x, int ch
     return result;
 }
 
+// The noise generators below process this many rows per job
+#ifndef RF_GEN_IMAGE_ROWS_PER_JOB
+    #define RF_GEN_IMAGE_ROWS_PER_JOB (16)
+#endif
+
+typedef struct rf_gen_image_job
+{
+    rf_color*    dst;
+    int          width;
+    int          height;
+    unsigned int seed;      // White noise and cellular
+    float        factor;    // White noise
+    int          offset_x;  // Perlin noise
+    int          offset_y;  // Perlin noise
+    float        scale;     // Perlin noise
+    int          tile_size; // Cellular
+} rf_gen_image_job;
+
+RF_INTERNAL rf_int rf_gen_image_job_count(int height)
+{
+    return (height + RF_GEN_IMAGE_ROWS_PER_JOB - 1) / RF_GEN_IMAGE_ROWS_PER_JOB;
+}
+
+// rf_rand_proc implementations like rf_libc_rand_wrapper can only be relied on for 15 bits
+RF_INTERNAL unsigned int rf_seed_from_rand_proc(rf_rand_proc rand)
+{
+    return ((unsigned int) rand(0, 0x7FFF) << 15) ^ (unsigned int) rand(0, 0x7FFF);
+}
+
+RF_INTERNAL void rf_gen_image_white_noise_job(void* job_data, rf_int job_index)
+{
+    rf_gen_image_job* job = job_data;
+
+    int    threshold = (int)(job->factor * 100.0f);
+    rf_int y_begin   = job_index * RF_GEN_IMAGE_ROWS_PER_JOB;
+    rf_int y_end     = rf_min_i(y_begin + RF_GEN_IMAGE_ROWS_PER_JOB, job->height);
+
+    for (rf_int i = y_begin * job->width; i < y_end * job->width; i++)
+    {
+        bool white = (int)(rf_hash_u32(job->seed ^ (unsigned int) i) % 100) < threshold;
+        job->dst[i] = white ? RF_WHITE : RF_BLACK;
+    }
+}
+
 // Generate image: white noise
+// Note: `rand` is only called once to seed the generator, the pixels are generated on the job system
 RF_API rf_image rf_gen_image_white_noise_to_buffer(int width, int height, float factor, rf_rand_proc rand, rf_color* dst, rf_int dst_size)
 {
     int result_image_size = width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
@@ -16991,17 +20558,14 @@ RF_API rf_image rf_gen_image_white_noise_to_buffer(int width, int height, float
 
     if (dst_size < result_image_size || !rand || result_image_size <= 0) return result;
 
-    for (rf_int i = 0; i < width * height; i++)
-    {
-        if (rand(0, 99) < (int)(factor * 100.0f))
-        {
-            dst[i] = RF_WHITE;
-        }
-        else
-        {
-            dst[i] = RF_BLACK;
-        }
-    }
+    rf_gen_image_job job = {0};
+    job.dst    = dst;
+    job.width  = width;
+    job.height = height;
+    job.factor = factor;
+    job.seed   = rf_seed_from_rand_proc(rand);
+
+    rf_parallel_for(rf_gen_image_white_noise_job, &job, rf_gen_image_job_count(height));
 
     result = (rf_image)
     {
@@ -17029,6 +20593,165 @@ RF_API rf_image rf_gen_image_white_noise(int width, int height, float factor, rf
     return result;
 }
 
+#if defined(RF_SIMD_SSE2)
+// x and y components of the gradients of stb__perlin_grad
+RF_INTERNAL const float rf_perlin_basis[12][2] =
+{
+    {  1, 1 }, { -1, 1 }, {  1,-1 }, { -1,-1 },
+    {  1, 0 }, { -1, 0 }, {  1, 0 }, { -1, 0 },
+    {  0, 1 }, {  0,-1 }, {  0, 1 }, {  0,-1 },
+};
+
+/*
+ stb_perlin_fbm_noise3(x, y, 1.0f, 2.0f, 0.5f, 6) for 4 pixels at a time.
+ The z coordinate of every octave is a whole number so its fractional part, and with it the z ease and the z-1 corners, is always 0.
+ Only the 4 remaining corners are evaluated, with the same float operations as stb_perlin so the results are identical.
+ The permutation table lookups are done per lane.
+*/
+RF_INTERNAL __m128 rf_perlin_fbm_noise3_z1_sse2(__m128 x, __m128 y)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 v6  = _mm_set1_ps(6.0f);
+    const __m128 v15 = _mm_set1_ps(15.0f);
+    const __m128 v10 = _mm_set1_ps(10.0f);
+
+    float  frequency = 1.0f;
+    float  amplitude = 1.0f;
+    __m128 sum       = _mm_setzero_ps();
+
+    for (int octave = 0; octave < 6; octave++)
+    {
+        unsigned char seed = (unsigned char) octave;
+
+        __m128 fx = _mm_mul_ps(x, _mm_set1_ps(frequency));
+        __m128 fy = _mm_mul_ps(y, _mm_set1_ps(frequency));
+        int    z0 = ((int) frequency) & 255;
+
+        // stb__perlin_fastfloor
+        __m128i px = _mm_cvttps_epi32(fx);
+        __m128i py = _mm_cvttps_epi32(fy);
+        px = _mm_add_epi32(px, _mm_castps_si128(_mm_cmplt_ps(fx, _mm_cvtepi32_ps(px))));
+        py = _mm_add_epi32(py, _mm_castps_si128(_mm_cmplt_ps(fy, _mm_cvtepi32_ps(py))));
+
+        fx = _mm_sub_ps(fx, _mm_cvtepi32_ps(px));
+        fy = _mm_sub_ps(fy, _mm_cvtepi32_ps(py));
+
+        // stb__perlin_ease: (((a*6-15)*a + 10) * a * a * a)
+        __m128 u = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(fx, v6), v15), fx), v10), fx), fx), fx);
+        __m128 v = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(fy, v6), v15), fy), v10), fy), fy), fy);
+
+        int lanes_x[4], lanes_y[4];
+        _mm_storeu_si128((__m128i*) lanes_x, px);
+        _mm_storeu_si128((__m128i*) lanes_y, py);
+
+        // Gradient components of the corners 00, 01, 10, 11
+        float gx[4][4], gy[4][4];
+        for (int lane = 0; lane < 4; lane++)
+        {
+            int x0 = lanes_x[lane] & 255, x1 = (lanes_x[lane] + 1) & 255;
+            int y0 = lanes_y[lane] & 255, y1 = (lanes_y[lane] + 1) & 255;
+
+            int r0 = stb__perlin_randtab[x0 + seed];
+            int r1 = stb__perlin_randtab[x1 + seed];
+
+            int corners[4] = {
+                stb__perlin_randtab_grad_idx[stb__perlin_randtab[r0 + y0] + z0],
+                stb__perlin_randtab_grad_idx[stb__perlin_randtab[r0 + y1] + z0],
+                stb__perlin_randtab_grad_idx[stb__perlin_randtab[r1 + y0] + z0],
+                stb__perlin_randtab_grad_idx[stb__perlin_randtab[r1 + y1] + z0],
+            };
+
+            for (int corner = 0; corner < 4; corner++)
+            {
+                gx[corner][lane] = rf_perlin_basis[corners[corner]][0];
+                gy[corner][lane] = rf_perlin_basis[corners[corner]][1];
+            }
+        }
+
+        __m128 fx1 = _mm_sub_ps(fx, one);
+        __m128 fy1 = _mm_sub_ps(fy, one);
+
+        __m128 n00 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(gx[0]), fx),  _mm_mul_ps(_mm_loadu_ps(gy[0]), fy));
+        __m128 n01 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(gx[1]), fx),  _mm_mul_ps(_mm_loadu_ps(gy[1]), fy1));
+        __m128 n10 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(gx[2]), fx1), _mm_mul_ps(_mm_loadu_ps(gy[2]), fy));
+        __m128 n11 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(gx[3]), fx1), _mm_mul_ps(_mm_loadu_ps(gy[3]), fy1));
+
+        // stb__perlin_lerp: a + (b-a) * t
+        __m128 n0 = _mm_add_ps(n00, _mm_mul_ps(_mm_sub_ps(n01, n00), v));
+        __m128 n1 = _mm_add_ps(n10, _mm_mul_ps(_mm_sub_ps(n11, n10), v));
+        __m128 n  = _mm_add_ps(n0,  _mm_mul_ps(_mm_sub_ps(n1, n0), u));
+
+        sum = _mm_add_ps(sum, _mm_mul_ps(n, _mm_set1_ps(amplitude)));
+
+        frequency *= 2.0f;
+        amplitude *= 0.5f;
+    }
+
+    return sum;
+}
+#endif
+
+RF_INTERNAL void rf_gen_image_perlin_noise_job(void* job_data, rf_int job_index)
+{
+    rf_gen_image_job* job = job_data;
+
+    rf_int y_begin = job_index * RF_GEN_IMAGE_ROWS_PER_JOB;
+    rf_int y_end   = rf_min_i(y_begin + RF_GEN_IMAGE_ROWS_PER_JOB, job->height);
+
+    int width = job->width;
+
+    for (rf_int y = y_begin; y < y_end; y++)
+    {
+        float    ny  = (float)(y + job->offset_y)*job->scale/(float)job->height;
+        rf_color* row = job->dst + y * width;
+        rf_int   x   = 0;
+
+        #if defined(RF_SIMD_SSE2)
+            const __m128  zero      = _mm_setzero_ps();
+            const __m128  one       = _mm_set1_ps(1.0f);
+            const __m128  max       = _mm_set1_ps(255.0f);
+            const __m128  scale     = _mm_set1_ps(job->scale);
+            const __m128  width_f   = _mm_set1_ps((float) width);
+            const __m128i opaque    = _mm_set1_epi32((int) 0xFF000000);
+            const __m128i lane_offs = _mm_setr_epi32(0, 1, 2, 3);
+
+            for (; x + 4 <= width; x += 4)
+            {
+                __m128i xs = _mm_add_epi32(_mm_set1_epi32((int)(x + job->offset_x)), lane_offs);
+                __m128  nx = _mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(xs), scale), width_f);
+
+                // NOTE: We need to translate the data from [-1..1] to [0..1]
+                __m128 p = _mm_div_ps(_mm_add_ps(rf_perlin_fbm_noise3_z1_sse2(nx, _mm_set1_ps(ny)), one), _mm_set1_ps(2.0f));
+
+                // NOTE: fbm can overshoot [-1..1], clamp so the intensity does not spill into the other channels
+                p = _mm_min_ps(_mm_max_ps(p, zero), one);
+
+                __m128i intensity = _mm_cvttps_epi32(_mm_mul_ps(p, max));
+                __m128i pixels = _mm_or_si128(_mm_or_si128(intensity, _mm_slli_epi32(intensity, 8)), _mm_or_si128(_mm_slli_epi32(intensity, 16), opaque));
+
+                _mm_storeu_si128((__m128i*)(row + x), pixels);
+            }
+        #endif
+
+        for (; x < width; x++)
+        {
+            float nx = (float)(x + job->offset_x)*job->scale/(float)width;
+
+            // Typical values to start playing with:
+            //   lacunarity = ~2.0   -- spacing between successive octaves (use exactly 2.0 for wrapping output)
+            //   gain       =  0.5   -- relative weighting applied to each successive octave
+            //   octaves    =  6     -- number of "octaves" of noise3() to sum
+
+            // NOTE: We need to translate the data from [-1..1] to [0..1]
+            float p = (stb_perlin_fbm_noise3(nx, ny, 1.0f, 2.0f, 0.5f, 6) + 1.0f) / 2.0f;
+            p = rf_clamp(p, 0.0f, 1.0f);
+
+            int intensity = (int)(p * 255.0f);
+            row[x] = (rf_color){ intensity, intensity, intensity, 255 };
+        }
+    }
+}
+
 // Generate image: perlin noise
 RF_API rf_image rf_gen_image_perlin_noise_to_buffer(int width, int height, int offset_x, int offset_y, float scale, rf_color* dst, rf_int dst_size)
 {
@@ -17036,458 +20759,1850 @@ RF_API rf_image rf_gen_image_perlin_noise_to_buffer(int width, int height, int o
 
     if (dst_size >= width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8))
     {
-        for (rf_int y = 0; y < height; y++)
+        rf_gen_image_job job = {0};
+        job.dst      = dst;
+        job.width    = width;
+        job.height   = height;
+        job.offset_x = offset_x;
+        job.offset_y = offset_y;
+        job.scale    = scale;
+
+        rf_parallel_for(rf_gen_image_perlin_noise_job, &job, rf_gen_image_job_count(height));
+
+        result = (rf_image)
         {
-            for (rf_int x = 0; x < width; x++)
+            .data = dst,
+            .width = width,
+            .height = height,
+            .format = RF_UNCOMPRESSED_R8G8B8A8,
+            .valid = true,
+        };
+    }
+
+    return result;
+}
+
+RF_API rf_image rf_gen_image_perlin_noise(int width, int height, int offset_x, int offset_y, float scale, rf_allocator allocator)
+{
+    rf_image result = {0};
+
+    int dst_size = width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
+    rf_color* dst = RF_ALLOC(allocator, dst_size);
+
+    if (dst)
+    {
+        result = rf_gen_image_perlin_noise_to_buffer(width, height, offset_x, offset_y, scale, dst, dst_size);
+    }
+
+    return result;
+}
+
+RF_API rf_vec2 rf_get_seed_for_cellular_image(int seeds_per_row, int tile_size, int i, rf_rand_proc rand)
+{
+    rf_vec2 result = {0};
+
+    int y = (i / seeds_per_row) * tile_size + rand(0, tile_size - 1);
+    int x = (i % seeds_per_row) * tile_size + rand(0, tile_size - 1);
+    result = (rf_vec2) { (float) x, (float) y };
+
+    return result;
+}
+
+// Position of the seed of a tile, derived from a hash of the tile index so it is the same for every pixel that looks at it
+RF_INTERNAL inline void rf_cellular_seed(unsigned int seed, int tile_size, int tile_index, int seeds_per_row, int* x, int* y)
+{
+    unsigned int hash_x = rf_hash_u32(seed ^ (unsigned int)(tile_index * 2));
+    unsigned int hash_y = rf_hash_u32(seed ^ (unsigned int)(tile_index * 2 + 1));
+
+    *x = (tile_index % seeds_per_row) * tile_size + (int)(hash_x % (unsigned int) tile_size);
+    *y = (tile_index / seeds_per_row) * tile_size + (int)(hash_y % (unsigned int) tile_size);
+}
+
+RF_INTERNAL void rf_gen_image_cellular_job(void* job_data, rf_int job_index)
+{
+    rf_gen_image_job* job = job_data;
+
+    int tile_size     = job->tile_size;
+    int seeds_per_row = job->width  / tile_size;
+    int seeds_per_col = job->height / tile_size;
+
+    rf_int y_begin = job_index * RF_GEN_IMAGE_ROWS_PER_JOB;
+    rf_int y_end   = rf_min_i(y_begin + RF_GEN_IMAGE_ROWS_PER_JOB, job->height);
+
+    for (rf_int y = y_begin; y < y_end; y++)
+    {
+        int tile_y = (int) y / tile_size;
+
+        // Pixels of the same tile share the same 3x3 neighbour seeds, so they are computed once per tile
+        for (int x_begin = 0; x_begin < job->width; x_begin += tile_size)
+        {
+            int tile_x = x_begin / tile_size;
+            int x_end  = rf_min_i(x_begin + tile_size, job->width);
+
+            int seeds_x[9], seeds_y[9];
+            int seeds_count = 0;
+
+            // Check all adjacent tiles
+            for (int j = -1; j < 2; j++)
             {
-                float nx = (float)(x + offset_x)*scale/(float)width;
-                float ny = (float)(y + offset_y)*scale/(float)height;
+                if ((tile_y + j < 0) || (tile_y + j >= seeds_per_col)) continue;
+
+                for (int i = -1; i < 2; i++)
+                {
+                    if ((tile_x + i < 0) || (tile_x + i >= seeds_per_row)) continue;
+
+                    rf_cellular_seed(job->seed, tile_size, (tile_y + j) * seeds_per_row + tile_x + i, seeds_per_row, &seeds_x[seeds_count], &seeds_y[seeds_count]);
+                    seeds_count++;
+                }
+            }
+
+            for (int x = x_begin; x < x_end; x++)
+            {
+                // Squared distances are compared and only the closest one goes through sqrtf
+                int min_distance_sqr = INT_MAX;
+
+                for (int i = 0; i < seeds_count; i++)
+                {
+                    int dx = x - seeds_x[i];
+                    int dy = (int) y - seeds_y[i];
+                    int distance_sqr = dx * dx + dy * dy;
+                    if (distance_sqr < min_distance_sqr) min_distance_sqr = distance_sqr;
+                }
+
+                // I made this up but it seems to give good results at all tile sizes
+                int intensity = 255;
+                if (seeds_count > 0)
+                {
+                    float scaled = sqrtf((float) min_distance_sqr) * 256.0f / tile_size;
+                    if (scaled < 255.0f) intensity = (int) scaled;
+                }
+
+                job->dst[y * job->width + x] = (rf_color) { intensity, intensity, intensity, 255 };
+            }
+        }
+    }
+}
+
+// Generate image: cellular algorithm. Bigger tileSize means bigger cells
+// Note: `rand` is only called once to seed the generator, the seed of each tile is derived from it
+RF_API rf_image rf_gen_image_cellular_to_buffer(int width, int height, int tile_size, rf_rand_proc rand, rf_color* dst, rf_int dst_size)
+{
+    rf_image result = {0};
+
+    if (tile_size <= 0 || !rand) return result;
+
+    if (dst_size >= width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8))
+    {
+        rf_gen_image_job job = {0};
+        job.dst       = dst;
+        job.width     = width;
+        job.height    = height;
+        job.tile_size = tile_size;
+        job.seed      = rf_seed_from_rand_proc(rand);
+
+        rf_parallel_for(rf_gen_image_cellular_job, &job, rf_gen_image_job_count(height));
+
+        result = (rf_image)
+        {
+            .data = dst,
+            .width = width,
+            .height = height,
+            .format = RF_UNCOMPRESSED_R8G8B8A8,
+            .valid = true,
+        };
+    }
+
+    return result;
+}
+
+RF_API rf_image rf_gen_image_cellular(int width, int height, int tile_size, rf_rand_proc rand, rf_allocator allocator)
+{
+    rf_image result = {0};
+
+    int dst_size = width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
+
+    rf_color* dst = RF_ALLOC(allocator, dst_size);
+
+    if (dst)
+    {
+        result = rf_gen_image_cellular_to_buffer(width, height, tile_size, rand, dst, dst_size);
+    }
+
+    return result;
+}
+
+#pragma region image drawing
+
+// Pixels are blended in chunks of this size so that formats other than rgba32 can be converted on the stack
+#ifndef RF_IMAGE_DRAW_CHUNK_SIZE
+    #define RF_IMAGE_DRAW_CHUNK_SIZE (256)
+#endif
+
+/*
+ Alpha blend `src` tinted by `tint` over `dst` (https://en.wikipedia.org/wiki/Alpha_compositing).
+ The math is done on floats in the [0, 255] range, the simd and scalar paths perform the same operations in the same order.
+*/
+#if defined(RF_SIMD_AVX2)
+RF_INTERNAL RF_AVX2_FUNC rf_int rf_blend_rgba32_row_avx2(rf_color* dst, const rf_color* src, rf_int count, rf_color tint)
+{
+    const __m256i mask     = _mm256_set1_epi32(0xFF);
+    const __m256  max      = _mm256_set1_ps(255.0f);
+    const __m256  min_a    = _mm256_set1_ps(FLT_MIN);
+    const __m256  tint_r   = _mm256_set1_ps(tint.r / 255.0f);
+    const __m256  tint_g   = _mm256_set1_ps(tint.g / 255.0f);
+    const __m256  tint_b   = _mm256_set1_ps(tint.b / 255.0f);
+    const __m256  tint_a   = _mm256_set1_ps(tint.a / 255.0f);
+
+    rf_int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+
+        __m256 sr = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(s, mask)), tint_r);
+        __m256 sg = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(s,  8), mask)), tint_g);
+        __m256 sb = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(s, 16), mask)), tint_b);
+        __m256 sa = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(s, 24)), tint_a);
+
+        __m256 dr = _mm256_cvtepi32_ps(_mm256_and_si256(d, mask));
+        __m256 dg = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(d,  8), mask));
+        __m256 db = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(d, 16), mask));
+        __m256 da = _mm256_cvtepi32_ps(_mm256_srli_epi32(d, 24));
+
+        __m256 dw = _mm256_div_ps(_mm256_mul_ps(da, _mm256_sub_ps(max, sa)), max);
+        __m256 oa = _mm256_add_ps(sa, dw);
+        __m256 div = _mm256_max_ps(oa, min_a);
+
+        __m256i r = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(sr, sa), _mm256_mul_ps(dr, dw)), div));
+        __m256i g = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(sg, sa), _mm256_mul_ps(dg, dw)), div));
+        __m256i b = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(sb, sa), _mm256_mul_ps(db, dw)), div));
+        __m256i a = _mm256_cvttps_epi32(oa);
+
+        __m256i out = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)), _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_slli_epi32(a, 24)));
+        _mm256_storeu_si256((__m256i*)(dst + i), out);
+    }
+
+    return i;
+}
+#endif
+
+RF_INTERNAL void rf_blend_rgba32_row(rf_color* dst, const rf_color* src, rf_int count, rf_color tint)
+{
+    rf_int i = 0;
+
+    #if defined(RF_SIMD_AVX2)
+        if (rf_cpu_supports_avx2()) i = rf_blend_rgba32_row_avx2(dst, src, count, tint);
+    #endif
+
+    #if defined(RF_SIMD_SSE2)
+        __m128i mask   = _mm_set1_epi32(0xFF);
+        __m128  max    = _mm_set1_ps(255.0f);
+        __m128  min_a  = _mm_set1_ps(FLT_MIN);
+        __m128  tint_r = _mm_set1_ps(tint.r / 255.0f);
+        __m128  tint_g = _mm_set1_ps(tint.g / 255.0f);
+        __m128  tint_b = _mm_set1_ps(tint.b / 255.0f);
+        __m128  tint_a = _mm_set1_ps(tint.a / 255.0f);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+
+            __m128 sr = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(s, mask)), tint_r);
+            __m128 sg = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(s,  8), mask)), tint_g);
+            __m128 sb = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(s, 16), mask)), tint_b);
+            __m128 sa = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(s, 24)), tint_a);
+
+            __m128 dr = _mm_cvtepi32_ps(_mm_and_si128(d, mask));
+            __m128 dg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d,  8), mask));
+            __m128 db = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, 16), mask));
+            __m128 da = _mm_cvtepi32_ps(_mm_srli_epi32(d, 24));
+
+            __m128 dw  = _mm_div_ps(_mm_mul_ps(da, _mm_sub_ps(max, sa)), max);
+            __m128 oa  = _mm_add_ps(sa, dw);
+            __m128 div = _mm_max_ps(oa, min_a);
+
+            __m128i r = _mm_cvttps_epi32(_mm_div_ps(_mm_add_ps(_mm_mul_ps(sr, sa), _mm_mul_ps(dr, dw)), div));
+            __m128i g = _mm_cvttps_epi32(_mm_div_ps(_mm_add_ps(_mm_mul_ps(sg, sa), _mm_mul_ps(dg, dw)), div));
+            __m128i b = _mm_cvttps_epi32(_mm_div_ps(_mm_add_ps(_mm_mul_ps(sb, sa), _mm_mul_ps(db, dw)), div));
+            __m128i a = _mm_cvttps_epi32(oa);
+
+            __m128i out = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), _mm_slli_epi32(a, 24)));
+            _mm_storeu_si128((__m128i*)(dst + i), out);
+        }
+    #elif defined(RF_SIMD_NEON) && defined(__aarch64__)
+        uint32x4_t  mask   = vdupq_n_u32(0xFF);
+        float32x4_t max    = vdupq_n_f32(255.0f);
+        float32x4_t min_a  = vdupq_n_f32(FLT_MIN);
+        float32x4_t tint_r = vdupq_n_f32(tint.r / 255.0f);
+        float32x4_t tint_g = vdupq_n_f32(tint.g / 255.0f);
+        float32x4_t tint_b = vdupq_n_f32(tint.b / 255.0f);
+        float32x4_t tint_a = vdupq_n_f32(tint.a / 255.0f);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t s = vld1q_u32((const uint32_t*)(src + i));
+            uint32x4_t d = vld1q_u32((const uint32_t*)(dst + i));
+
+            float32x4_t sr = vmulq_f32(vcvtq_f32_u32(vandq_u32(s, mask)), tint_r);
+            float32x4_t sg = vmulq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(s,  8), mask)), tint_g);
+            float32x4_t sb = vmulq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(s, 16), mask)), tint_b);
+            float32x4_t sa = vmulq_f32(vcvtq_f32_u32(vshrq_n_u32(s, 24)), tint_a);
+
+            float32x4_t dr = vcvtq_f32_u32(vandq_u32(d, mask));
+            float32x4_t dg = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(d,  8), mask));
+            float32x4_t db = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(d, 16), mask));
+            float32x4_t da = vcvtq_f32_u32(vshrq_n_u32(d, 24));
+
+            float32x4_t dw  = vdivq_f32(vmulq_f32(da, vsubq_f32(max, sa)), max);
+            float32x4_t oa  = vaddq_f32(sa, dw);
+            float32x4_t div = vmaxq_f32(oa, min_a);
+
+            uint32x4_t r = vcvtq_u32_f32(vdivq_f32(vaddq_f32(vmulq_f32(sr, sa), vmulq_f32(dr, dw)), div));
+            uint32x4_t g = vcvtq_u32_f32(vdivq_f32(vaddq_f32(vmulq_f32(sg, sa), vmulq_f32(dg, dw)), div));
+            uint32x4_t b = vcvtq_u32_f32(vdivq_f32(vaddq_f32(vmulq_f32(sb, sa), vmulq_f32(db, dw)), div));
+            uint32x4_t a = vcvtq_u32_f32(oa);
+
+            uint32x4_t out = vorrq_u32(vorrq_u32(r, vshlq_n_u32(g, 8)), vorrq_u32(vshlq_n_u32(b, 16), vshlq_n_u32(a, 24)));
+            vst1q_u32((uint32_t*)(dst + i), out);
+        }
+    #endif
+
+    float tr = tint.r / 255.0f;
+    float tg = tint.g / 255.0f;
+    float tb = tint.b / 255.0f;
+    float ta = tint.a / 255.0f;
+
+    for (; i < count; i++)
+    {
+        float sr = (float)src[i].r * tr;
+        float sg = (float)src[i].g * tg;
+        float sb = (float)src[i].b * tb;
+        float sa = (float)src[i].a * ta;
+
+        float dw  = ((float)dst[i].a * (255.0f - sa)) / 255.0f;
+        float oa  = sa + dw;
+        float div = oa > FLT_MIN ? oa : FLT_MIN;
+
+        dst[i].r = (unsigned char)((sr * sa + (float)dst[i].r * dw) / div);
+        dst[i].g = (unsigned char)((sg * sa + (float)dst[i].g * dw) / div);
+        dst[i].b = (unsigned char)((sb * sa + (float)dst[i].b * dw) / div);
+        dst[i].a = (unsigned char)oa;
+    }
+}
+
+// Bilinear sample of the area `area` of `image` at the continuous coordinates u, v. Coordinates are clamped to the area.
+RF_INTERNAL rf_color rf_image_sample_bilinear(rf_image image, int area_x0, int area_y0, int area_x1, int area_y1, float u, float v)
+{
+    if (u < area_x0) u = (float) area_x0;
+    if (v < area_y0) v = (float) area_y0;
+    if (u > area_x1 - 1) u = (float) (area_x1 - 1);
+    if (v > area_y1 - 1) v = (float) (area_y1 - 1);
+
+    int x0 = (int) u;
+    int y0 = (int) v;
+    int x1 = x0 + 1 < area_x1 ? x0 + 1 : x0;
+    int y1 = y0 + 1 < area_y1 ? y0 + 1 : y0;
+
+    // 8 bit fixed point weights
+    int fx = (int)((u - x0) * 256.0f);
+    int fy = (int)((v - y0) * 256.0f);
+
+    rf_color c00, c10, c01, c11;
+    if (image.format == RF_UNCOMPRESSED_R8G8B8A8)
+    {
+        const rf_color* pixels = image.data;
+        c00 = pixels[y0 * image.width + x0];
+        c10 = pixels[y0 * image.width + x1];
+        c01 = pixels[y1 * image.width + x0];
+        c11 = pixels[y1 * image.width + x1];
+    }
+    else
+    {
+        int bpp = rf_bytes_per_pixel(image.format);
+        const unsigned char* pixels = image.data;
+        c00 = rf_format_one_pixel_to_rgba32(pixels + (y0 * image.width + x0) * bpp, image.format);
+        c10 = rf_format_one_pixel_to_rgba32(pixels + (y0 * image.width + x1) * bpp, image.format);
+        c01 = rf_format_one_pixel_to_rgba32(pixels + (y1 * image.width + x0) * bpp, image.format);
+        c11 = rf_format_one_pixel_to_rgba32(pixels + (y1 * image.width + x1) * bpp, image.format);
+    }
+
+    int w00 = (256 - fx) * (256 - fy);
+    int w10 = fx * (256 - fy);
+    int w01 = (256 - fx) * fy;
+    int w11 = fx * fy;
+
+    rf_color result;
+    result.r = (unsigned char)((c00.r * w00 + c10.r * w10 + c01.r * w01 + c11.r * w11 + (1 << 15)) >> 16);
+    result.g = (unsigned char)((c00.g * w00 + c10.g * w10 + c01.g * w01 + c11.g * w11 + (1 << 15)) >> 16);
+    result.b = (unsigned char)((c00.b * w00 + c10.b * w10 + c01.b * w01 + c11.b * w11 + (1 << 15)) >> 16);
+    result.a = (unsigned char)((c00.a * w00 + c10.a * w10 + c01.a * w01 + c11.a * w11 + (1 << 15)) >> 16);
+
+    return result;
+}
+
+/*
+ Blends `count` pixels of `src_row` over `dst` starting at the pixel (x, y).
+ If `dst` is not rgba32 the pixels are converted to rgba32 on the stack, blended and then converted back.
+*/
+RF_INTERNAL void rf_image_blend_span(rf_image* dst, int x, int y, const rf_color* src_row, rf_int count, rf_color tint)
+{
+    if (dst->format == RF_UNCOMPRESSED_R8G8B8A8)
+    {
+        rf_blend_rgba32_row(((rf_color*) dst->data) + y * dst->width + x, src_row, count, tint);
+    }
+    else
+    {
+        rf_color dst_row[RF_IMAGE_DRAW_CHUNK_SIZE];
+
+        int   dst_bpp  = rf_bytes_per_pixel(dst->format);
+        void* dst_span = ((unsigned char*) dst->data) + (y * dst->width + x) * dst_bpp;
+
+        RF_ASSERT(count <= RF_IMAGE_DRAW_CHUNK_SIZE);
+
+        rf_format_pixels_to_rgba32(dst_span, count * dst_bpp, dst->format, dst_row, sizeof(dst_row));
+        rf_blend_rgba32_row(dst_row, src_row, count, tint);
+        rf_format_pixels(dst_row, count * sizeof(rf_color), RF_UNCOMPRESSED_R8G8B8A8, dst_span, count * dst_bpp, dst->format);
+    }
+}
+
+// Draw an image (source) within an image (destination)
+// NOTE: rf_color tint is applied to source image
+RF_API void rf_image_draw(rf_image* dst, rf_image src, rf_rec src_rec, rf_rec dst_rec, rf_color tint, rf_allocator temp_allocator)
+{
+    ((void) temp_allocator); // Drawing is done in place without any intermediate allocations
+
+    if (src.valid && dst->valid && rf_is_uncompressed_format(src.format) && rf_is_uncompressed_format(dst->format))
+    {
+        if (src_rec.x < 0) src_rec.x = 0;
+        if (src_rec.y < 0) src_rec.y = 0;
+
+        if ((src_rec.x + src_rec.width) > src.width)
+        {
+            src_rec.width = src.width - src_rec.x;
+            RF_LOG(RF_LOG_TYPE_WARNING, "Source rectangle width out of bounds, rescaled width: %i", src_rec.width);
+        }
+
+        if ((src_rec.y + src_rec.height) > src.height)
+        {
+            src_rec.height = src.height - src_rec.y;
+            RF_LOG(RF_LOG_TYPE_WARNING, "Source rectangle height out of bounds, rescaled height: %i", src_rec.height);
+        }
+
+        int src_x = (int) src_rec.x;
+        int src_y = (int) src_rec.y;
+        int src_w = (int) src_rec.width;
+        int src_h = (int) src_rec.height;
+
+        int dst_x = (int) dst_rec.x;
+        int dst_y = (int) dst_rec.y;
+        int dst_w = (int) dst_rec.width;
+        int dst_h = (int) dst_rec.height;
+
+        if (src_w <= 0 || src_h <= 0 || dst_w <= 0 || dst_h <= 0) return;
+
+        // Clip the destination rectangle against the destination image, the source is mapped through the clipped area
+        int x_begin = rf_max_i(dst_x, 0);
+        int y_begin = rf_max_i(dst_y, 0);
+        int x_end   = rf_min_i(dst_x + dst_w, dst->width);
+        int y_end   = rf_min_i(dst_y + dst_h, dst->height);
+
+        if (x_begin >= x_end || y_begin >= y_end) return;
+
+        bool scaled = (src_w != dst_w) || (src_h != dst_h);
+
+        float scale_x = (float) src_w / (float) dst_w;
+        float scale_y = (float) src_h / (float) dst_h;
+
+        int src_bpp = rf_bytes_per_pixel(src.format);
+
+        rf_color src_row[RF_IMAGE_DRAW_CHUNK_SIZE];
+
+        for (rf_int y = y_begin; y < y_end; y++)
+        {
+            for (rf_int x = x_begin; x < x_end; x += RF_IMAGE_DRAW_CHUNK_SIZE)
+            {
+                rf_int count = rf_min_i(RF_IMAGE_DRAW_CHUNK_SIZE, x_end - x);
+                const rf_color* src_pixels = src_row;
+
+                if (!scaled)
+                {
+                    rf_int sx = src_x + (x - dst_x);
+                    rf_int sy = src_y + (y - dst_y);
+
+                    if (src.format == RF_UNCOMPRESSED_R8G8B8A8)
+                    {
+                        src_pixels = ((rf_color*) src.data) + sy * src.width + sx;
+                    }
+                    else
+                    {
+                        const unsigned char* src_span = ((unsigned char*) src.data) + (sy * src.width + sx) * src_bpp;
+                        rf_format_pixels_to_rgba32(src_span, count * src_bpp, src.format, src_row, sizeof(src_row));
+                    }
+                }
+                else
+                {
+                    // Sample at the pixel centers
+                    float v = src_y + ((float)(y - dst_y) + 0.5f) * scale_y - 0.5f;
+
+                    for (rf_int i = 0; i < count; i++)
+                    {
+                        float u = src_x + ((float)(x + i - dst_x) + 0.5f) * scale_x - 0.5f;
+                        src_row[i] = rf_image_sample_bilinear(src, src_x, src_y, src_x + src_w, src_y + src_h, u, v);
+                    }
+                }
+
+                rf_image_blend_span(dst, x, y, src_pixels, count, tint);
+            }
+        }
+    }
+}
+
+// Draw rectangle within an image
+RF_API void rf_image_draw_rectangle(rf_image* dst, rf_rec rec, rf_color color, rf_allocator temp_allocator)
+{
+    ((void) temp_allocator); // Drawing is done in place without any intermediate allocations
+
+    if (dst->valid && rf_is_uncompressed_format(dst->format))
+    {
+        int x_begin = rf_max_i((int) rec.x, 0);
+        int y_begin = rf_max_i((int) rec.y, 0);
+        int x_end   = rf_min_i((int) rec.x + (int) rec.width,  dst->width);
+        int y_end   = rf_min_i((int) rec.y + (int) rec.height, dst->height);
+
+        if (x_begin >= x_end || y_begin >= y_end) return;
+
+        rf_color src_row[RF_IMAGE_DRAW_CHUNK_SIZE];
+        rf_int   fill_count = rf_min_i(RF_IMAGE_DRAW_CHUNK_SIZE, x_end - x_begin);
+        for (rf_int i = 0; i < fill_count; i++)
+        {
+            src_row[i] = color;
+        }
+
+        for (rf_int y = y_begin; y < y_end; y++)
+        {
+            for (rf_int x = x_begin; x < x_end; x += RF_IMAGE_DRAW_CHUNK_SIZE)
+            {
+                rf_image_blend_span(dst, x, y, src_row, rf_min_i(RF_IMAGE_DRAW_CHUNK_SIZE, x_end - x), RF_WHITE);
+            }
+        }
+    }
+}
+
+// Draw rectangle lines within an image
+RF_API void rf_image_draw_rectangle_lines(rf_image* dst, rf_rec rec, int thick, rf_color color, rf_allocator temp_allocator)
+{
+    rf_image_draw_rectangle(dst, (rf_rec) { rec.x, rec.y, rec.width, thick }, color, temp_allocator);
+    rf_image_draw_rectangle(dst, (rf_rec) { rec.x, rec.y + thick, thick, rec.height - thick * 2 }, color, temp_allocator);
+    rf_image_draw_rectangle(dst, (rf_rec) { rec.x + rec.width - thick, rec.y + thick, thick, rec.height - thick * 2 }, color, temp_allocator);
+    rf_image_draw_rectangle(dst, (rf_rec) { rec.x, rec.y + rec.height - thick, rec.width, thick }, color, temp_allocator);
+}
+
+#pragma endregion
+
+#pragma endregion
+
+#pragma region mipmaps
+
+RF_API int rf_mipmaps_image_size(rf_mipmaps_image image)
+{
+    int size   = 0;
+    int width  = image.width;
+    int height = image.height;
+
+    for (rf_int i = 0; i < image.mipmaps; i++)
+    {
+        size += width * height * rf_bytes_per_pixel(image.format);
+
+        width  /= 2;
+        height /= 2;
+
+        // Security check for NPOT textures
+        if (width  < 1) width  = 1;
+        if (height < 1) height = 1;
+    }
+
+    return size;
+}
+
+// Compute the amount of levels, up to desired_mipmaps_count, and the buffer size needed for the mipmap chain of an image. A desired_mipmaps_count <= 0 computes the full chain.
+RF_API rf_mipmaps_stats rf_compute_mipmaps_stats(rf_image image, int desired_mipmaps_count)
+{
+    if (!image.valid) return (rf_mipmaps_stats) {0};
+
+    int possible_mip_count = 1;
+    int mipmaps_size = rf_image_size(image);
+
+    int mip_width = image.width;
+    int mip_height = image.height;
+
+    while ((mip_width != 1 || mip_height != 1) && (desired_mipmaps_count <= 0 || possible_mip_count < desired_mipmaps_count))
+    {
+        if (mip_width  != 1) mip_width  /= 2;
+        if (mip_height != 1) mip_height /= 2;
+
+        // Safety check for NPOT textures
+        if (mip_width  < 1) mip_width  = 1;
+        if (mip_height < 1) mip_height = 1;
+
+        mipmaps_size += mip_width * mip_height * rf_bytes_per_pixel(image.format);
+
+        possible_mip_count++;
+    }
+
+    return (rf_mipmaps_stats) { possible_mip_count, mipmaps_size };
+}
+
+// Levels are generated in square tiles of this size so that every level of a tile is computed while the previous one is still in cache
+#ifndef RF_MIPMAPS_TILE_SIZE
+    #define RF_MIPMAPS_TILE_SIZE (64)
+#endif
+
+#define RF_MAX_MIPMAP_LEVELS (32)
+
+typedef struct rf_mipmaps_job
+{
+    unsigned char* levels  [RF_MAX_MIPMAP_LEVELS];
+    int            widths  [RF_MAX_MIPMAP_LEVELS];
+    int            heights [RF_MAX_MIPMAP_LEVELS];
+    int            channels;
+    bool           srgb;
+    int            tile_levels; // Levels that are generated per tile, the rest are small enough to be generated whole
+    int            tiles_x;
+} rf_mipmaps_job;
+
+RF_INTERNAL unsigned short rf_srgb_to_linear_table[256];  // 16 bit linear values
+RF_INTERNAL unsigned char  rf_linear_to_srgb_table[4096]; // Indexed by the 12 most significant bits of a 16 bit linear value
+
+// Called before any job starts so the tables are never written concurrently
+RF_INTERNAL void rf_init_srgb_tables()
+{
+    static bool initialized = false;
+    if (initialized) return;
+
+    for (int i = 0; i < 256; i++)
+    {
+        float c = i / 255.0f;
+        float linear = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+        rf_srgb_to_linear_table[i] = (unsigned short)(linear * 65535.0f + 0.5f);
+    }
+
+    for (int i = 0; i < 4096; i++)
+    {
+        float linear = i / 4095.0f;
+        float c = linear <= 0.0031308f ? linear * 12.92f : 1.055f * powf(linear, 1.0f / 2.4f) - 0.055f;
+        rf_linear_to_srgb_table[i] = (unsigned char)(c * 255.0f + 0.5f);
+    }
+
+    initialized = true;
+}
+
+RF_INTERNAL inline unsigned char rf_linear16_to_srgb(int linear)
+{
+    int index = (linear + 8) >> 4;
+    return rf_linear_to_srgb_table[index > 4095 ? 4095 : index];
+}
+
+// Same as rf_downscale_2x_row but the color channels are averaged in linear space, alpha is averaged as is
+RF_INTERNAL void rf_downscale_2x_row_srgb(const unsigned char* row0, const unsigned char* row1, unsigned char* dst, int dst_width, int channels)
+{
+    int alpha_channel = (channels == 2 || channels == 4) ? channels - 1 : -1;
+
+    for (int x = 0; x < dst_width; x++)
+    {
+        const unsigned char* a = row0 + (x * 2) * channels;
+        const unsigned char* b = row1 + (x * 2) * channels;
+
+        for (int c = 0; c < channels; c++)
+        {
+            if (c == alpha_channel)
+            {
+                dst[x * channels + c] = (unsigned char)((a[c] + a[c + channels] + b[c] + b[c + channels] + 2) >> 2);
+            }
+            else
+            {
+                int sum = rf_srgb_to_linear_table[a[c]] + rf_srgb_to_linear_table[a[c + channels]] + rf_srgb_to_linear_table[b[c]] + rf_srgb_to_linear_table[b[c + channels]];
+                dst[x * channels + c] = rf_linear16_to_srgb((sum + 2) >> 2);
+            }
+        }
+    }
+}
+
+/*
+ Generate a level from the previous one. When one of the sides of the previous level is already 1 pixel only the other side is halved.
+ Passing the same row twice to the 2x2 box averages horizontal pairs with the same rounding as a 2x1 box.
+*/
+RF_INTERNAL void rf_mipmaps_gen_level(const rf_mipmaps_job* job, int level)
+{
+    const unsigned char* src = job->levels[level - 1];
+    unsigned char*       dst = job->levels[level];
+
+    int src_width  = job->widths [level - 1];
+    int src_height = job->heights[level - 1];
+    int dst_width  = job->widths [level];
+    int dst_height = job->heights[level];
+    int channels   = job->channels;
+
+    for (int y = 0; y < dst_height; y++)
+    {
+        const unsigned char* row0 = src + (src_height == 1 ? 0 : (y * 2) * src_width * channels);
+        const unsigned char* row1 = src + (src_height == 1 ? 0 : (y * 2 + 1) * src_width * channels);
+
+        if (src_width == 1)
+        {
+            int alpha_channel = (channels == 2 || channels == 4) ? channels - 1 : -1;
+
+            for (int c = 0; c < channels; c++)
+            {
+                if (job->srgb && c != alpha_channel) dst[y * channels + c] = rf_linear16_to_srgb((rf_srgb_to_linear_table[row0[c]] + rf_srgb_to_linear_table[row1[c]] + 1) >> 1);
+                else                                 dst[y * channels + c] = (unsigned char)((row0[c] + row1[c] + 1) >> 1);
+            }
+        }
+        else if (job->srgb) rf_downscale_2x_row_srgb(row0, row1, dst + y * dst_width * channels, dst_width, channels);
+        else                rf_downscale_2x_row(row0, row1, dst + y * dst_width * channels, dst_width, channels);
+    }
+}
+
+RF_INTERNAL void rf_mipmaps_tile_job(void* job_data, rf_int tile)
+{
+    rf_mipmaps_job* job = job_data;
+
+    int tile_x = (int)(tile % job->tiles_x) * RF_MIPMAPS_TILE_SIZE;
+    int tile_y = (int)(tile / job->tiles_x) * RF_MIPMAPS_TILE_SIZE;
+    int channels = job->channels;
+
+    for (int level = 1; level <= job->tile_levels; level++)
+    {
+        int x_begin = tile_x >> level;
+        int y_begin = tile_y >> level;
+        int x_end   = rf_min_i((tile_x + RF_MIPMAPS_TILE_SIZE) >> level, job->widths [level]);
+        int y_end   = rf_min_i((tile_y + RF_MIPMAPS_TILE_SIZE) >> level, job->heights[level]);
+
+        rf_int src_stride = (rf_int) job->widths[level - 1] * channels;
+        rf_int dst_stride = (rf_int) job->widths[level] * channels;
+
+        for (int y = y_begin; y < y_end; y++)
+        {
+            const unsigned char* row0 = job->levels[level - 1] + (y * 2) * src_stride + x_begin * 2 * channels;
+            unsigned char*       dst  = job->levels[level] + y * dst_stride + x_begin * channels;
+
+            if (job->srgb) rf_downscale_2x_row_srgb(row0, row0 + src_stride, dst, x_end - x_begin, channels);
+            else           rf_downscale_2x_row(row0, row0 + src_stride, dst, x_end - x_begin, channels);
+        }
+    }
+}
+
+/*
+ Generate the mipmap chain of 8 bit per channel pixels in place, levels[0] must already hold the base image.
+ The levels that halve both sides are generated per tile on the job system, a 2x2 box only reads pixels of the same tile.
+ The remaining levels are at most RF_MIPMAPS_TILE_SIZE times smaller than the base image and are generated one after the other.
+*/
+RF_INTERNAL void rf_mipmaps_gen_chain(rf_mipmaps_job* job, int levels_count)
+{
+    if (job->srgb) rf_init_srgb_tables();
+
+    job->tile_levels = 0;
+    while (job->tile_levels + 1 < levels_count &&
+           (RF_MIPMAPS_TILE_SIZE >> (job->tile_levels + 1)) >= 1 &&
+           job->widths [job->tile_levels] >= 2 &&
+           job->heights[job->tile_levels] >= 2)
+    {
+        job->tile_levels++;
+    }
+
+    if (job->tile_levels > 0)
+    {
+        job->tiles_x  = (job->widths[0]  + RF_MIPMAPS_TILE_SIZE - 1) / RF_MIPMAPS_TILE_SIZE;
+        int tiles_y   = (job->heights[0] + RF_MIPMAPS_TILE_SIZE - 1) / RF_MIPMAPS_TILE_SIZE;
+
+        rf_parallel_for(rf_mipmaps_tile_job, job, (rf_int) job->tiles_x * tiles_y);
+    }
+
+    for (int level = job->tile_levels + 1; level < levels_count; level++)
+    {
+        rf_mipmaps_gen_level(job, level);
+    }
+}
+
+RF_INTERNAL rf_mipmaps_image rf_image_gen_mipmaps_impl(rf_image image, int gen_mipmaps_count, void* dst, rf_int dst_size, bool srgb, rf_allocator temp_allocator)
+{
+    if (!image.valid || !rf_is_uncompressed_format(image.format)) return (rf_mipmaps_image) {0};
+
+    rf_mipmaps_image result = {0};
+    rf_mipmaps_stats mipmap_stats = rf_compute_mipmaps_stats(image, gen_mipmaps_count);
+    int levels_count = rf_min_i(mipmap_stats.possible_mip_counts, RF_MAX_MIPMAP_LEVELS);
+
+    if (dst_size >= mipmap_stats.mipmaps_buffer_size)
+    {
+        int channels = rf_format_to_stb_channel_count(image.format);
+
+        // Formats that don't have 8 bits per channel are generated in rgba32 and converted back level by level
+        unsigned char* chain = dst;
+        if (!channels)
+        {
+            rf_mipmaps_image rgba32_chain = { .width = image.width, .height = image.height, .format = RF_UNCOMPRESSED_R8G8B8A8, .mipmaps = levels_count };
+            chain = RF_ALLOC(temp_allocator, rf_mipmaps_image_size(rgba32_chain));
+            channels = 4;
+
+            if (chain)
+            {
+                bool success = rf_format_pixels_to_rgba32(image.data, rf_image_size(image), image.format, (rf_color*) chain, rf_mipmaps_image_size(rgba32_chain));
+                RF_ASSERT(success);
+            }
+            else
+            {
+                RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", rf_mipmaps_image_size(rgba32_chain));
+                return result;
+            }
+        }
+        else
+        {
+            memcpy(chain, image.data, rf_image_size(image));
+        }
+
+        rf_mipmaps_job job = {0};
+        job.channels = channels;
+        job.srgb     = srgb;
+
+        unsigned char* level_iter = chain;
+        int mip_width  = image.width;
+        int mip_height = image.height;
+        for (int level = 0; level < levels_count; level++)
+        {
+            job.levels [level] = level_iter;
+            job.widths [level] = mip_width;
+            job.heights[level] = mip_height;
+
+            level_iter += mip_width * mip_height * channels;
+
+            mip_width  = rf_max_i(mip_width  / 2, 1);
+            mip_height = rf_max_i(mip_height / 2, 1);
+        }
+
+        rf_mipmaps_gen_chain(&job, levels_count);
+
+        if (chain != dst)
+        {
+            unsigned char* dst_iter = dst;
+            for (int level = 0; level < levels_count; level++)
+            {
+                int pixels_count = job.widths[level] * job.heights[level];
+                int level_size   = pixels_count * rf_bytes_per_pixel(image.format);
+
+                bool success = rf_format_pixels(job.levels[level], pixels_count * 4, RF_UNCOMPRESSED_R8G8B8A8, dst_iter, level_size, image.format);
+                RF_ASSERT(success);
+
+                dst_iter += level_size;
+            }
+
+            RF_FREE(temp_allocator, chain);
+        }
+
+        result = (rf_mipmaps_image){
+            .data = dst,
+            .width = image.width,
+            .height = image.height,
+            .mipmaps = levels_count,
+            .format = image.format,
+            .valid = true
+        };
+    }
+    else RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer of size %d is too small for the mipmaps, expected size %d.", dst_size, mipmap_stats.mipmaps_buffer_size);
+
+    return result;
+}
+
+// Generate all mipmap levels for a provided image. image.data is scaled to include mipmap levels. Mipmaps format is the same as base image
+RF_API rf_mipmaps_image rf_image_gen_mipmaps_to_buffer(rf_image image, int gen_mipmaps_count, void* dst, rf_int dst_size, rf_allocator temp_allocator)
+{
+    return rf_image_gen_mipmaps_impl(image, gen_mipmaps_count, dst, dst_size, false, temp_allocator);
+}
+
+RF_API rf_mipmaps_image rf_image_gen_mipmaps(rf_image image, int desired_mipmaps_count, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    if (!image.valid) return (rf_mipmaps_image) {0};
+
+    rf_mipmaps_image result = {0};
+    rf_mipmaps_stats mipmap_stats = rf_compute_mipmaps_stats(image, desired_mipmaps_count);
+
+    void* dst = RF_ALLOC(allocator, mipmap_stats.mipmaps_buffer_size);
+
+    if (dst)
+    {
+        result = rf_image_gen_mipmaps_to_buffer(image, desired_mipmaps_count, dst, mipmap_stats.mipmaps_buffer_size, temp_allocator);
+        if (!result.valid)
+        {
+            RF_FREE(allocator, dst);
+        }
+    }
+    else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", mipmap_stats.mipmaps_buffer_size);
+
+    return result;
+}
+
+// Same as rf_image_gen_mipmaps_to_buffer but the color channels of the image are treated as sRGB and averaged in linear space
+RF_API rf_mipmaps_image rf_image_gen_srgb_mipmaps_to_buffer(rf_image image, int gen_mipmaps_count, void* dst, rf_int dst_size, rf_allocator temp_allocator)
+{
+    return rf_image_gen_mipmaps_impl(image, gen_mipmaps_count, dst, dst_size, true, temp_allocator);
+}
+
+RF_API rf_mipmaps_image rf_image_gen_srgb_mipmaps(rf_image image, int desired_mipmaps_count, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    if (!image.valid) return (rf_mipmaps_image) {0};
+
+    rf_mipmaps_image result = {0};
+    rf_mipmaps_stats mipmap_stats = rf_compute_mipmaps_stats(image, desired_mipmaps_count);
+
+    void* dst = RF_ALLOC(allocator, mipmap_stats.mipmaps_buffer_size);
+
+    if (dst)
+    {
+        result = rf_image_gen_srgb_mipmaps_to_buffer(image, desired_mipmaps_count, dst, mipmap_stats.mipmaps_buffer_size, temp_allocator);
+        if (!result.valid)
+        {
+            RF_FREE(allocator, dst);
+        }
+    }
+    else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", mipmap_stats.mipmaps_buffer_size);
+
+    return result;
+}
+
+RF_API void rf_unload_mipmaps_image(rf_mipmaps_image image, rf_allocator allocator)
+{
+    RF_FREE(allocator, image.data);
+}
+
+#pragma endregion
+
+#pragma region block compression
+
+#define RF_BLOCK_COMPRESSION_ROWS_PER_JOB (8) // Rows of 4x4 blocks encoded by one job
+
+RF_API bool rf_supports_block_compression(rf_compressed_pixel_format format)
+{
+    switch (format)
+    {
+        case RF_COMPRESSED_DXT1_RGB:
+        case RF_COMPRESSED_DXT1_RGBA:
+        case RF_COMPRESSED_DXT3_RGBA:
+        case RF_COMPRESSED_DXT5_RGBA:
+        case RF_COMPRESSED_ETC1_RGB:
+        case RF_COMPRESSED_ETC2_RGB:
+        case RF_COMPRESSED_ETC2_EAC_RGBA:
+            return true;
+
+        default: return false;
+    }
+}
+
+// Copies a 4x4 block of pixels, blocks on the right and bottom edges repeat the last column and row of the image
+RF_INTERNAL void rf_load_block(const rf_color* src, int width, int height, int x, int y, rf_color block[16])
+{
+    if (x + 4 <= width && y + 4 <= height)
+    {
+        for (int j = 0; j < 4; j++) memcpy(block + j * 4, src + (rf_int)(y + j) * width + x, 4 * sizeof(rf_color));
+    }
+    else
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            const rf_color* row = src + (rf_int) rf_min_i(y + j, height - 1) * width;
+            for (int i = 0; i < 4; i++) block[j * 4 + i] = row[rf_min_i(x + i, width - 1)];
+        }
+    }
+}
+
+// Per channel minimum and maximum of a block
+RF_INTERNAL void rf_block_bounds(const rf_color block[16], rf_color* min, rf_color* max)
+{
+    #if defined(RF_SIMD_SSE2)
+    __m128i r0 = _mm_loadu_si128((const __m128i*)(block + 0));
+    __m128i r1 = _mm_loadu_si128((const __m128i*)(block + 4));
+    __m128i r2 = _mm_loadu_si128((const __m128i*)(block + 8));
+    __m128i r3 = _mm_loadu_si128((const __m128i*)(block + 12));
+
+    __m128i lo = _mm_min_epu8(_mm_min_epu8(r0, r1), _mm_min_epu8(r2, r3));
+    __m128i hi = _mm_max_epu8(_mm_max_epu8(r0, r1), _mm_max_epu8(r2, r3));
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    int lo_bits = _mm_cvtsi128_si32(lo);
+    int hi_bits = _mm_cvtsi128_si32(hi);
+    memcpy(min, &lo_bits, 4);
+    memcpy(max, &hi_bits, 4);
+    #elif defined(RF_SIMD_NEON)
+    const unsigned char* p = (const unsigned char*) block;
+    uint8x16_t r0 = vld1q_u8(p + 0), r1 = vld1q_u8(p + 16), r2 = vld1q_u8(p + 32), r3 = vld1q_u8(p + 48);
+
+    uint8x16_t lo = vminq_u8(vminq_u8(r0, r1), vminq_u8(r2, r3));
+    uint8x16_t hi = vmaxq_u8(vmaxq_u8(r0, r1), vmaxq_u8(r2, r3));
+    uint8x8_t lo8 = vmin_u8(vget_low_u8(lo), vget_high_u8(lo));
+    uint8x8_t hi8 = vmax_u8(vget_low_u8(hi), vget_high_u8(hi));
+    lo8 = vmin_u8(lo8, vreinterpret_u8_u32(vrev64_u32(vreinterpret_u32_u8(lo8))));
+    hi8 = vmax_u8(hi8, vreinterpret_u8_u32(vrev64_u32(vreinterpret_u32_u8(hi8))));
+
+    uint32_t lo_bits = vget_lane_u32(vreinterpret_u32_u8(lo8), 0);
+    uint32_t hi_bits = vget_lane_u32(vreinterpret_u32_u8(hi8), 0);
+    memcpy(min, &lo_bits, 4);
+    memcpy(max, &hi_bits, 4);
+    #else
+    *min = block[0];
+    *max = block[0];
+    for (int i = 1; i < 16; i++)
+    {
+        min->r = rf_min_i(min->r, block[i].r); max->r = rf_max_i(max->r, block[i].r);
+        min->g = rf_min_i(min->g, block[i].g); max->g = rf_max_i(max->g, block[i].g);
+        min->b = rf_min_i(min->b, block[i].b); max->b = rf_max_i(max->b, block[i].b);
+        min->a = rf_min_i(min->a, block[i].a); max->a = rf_max_i(max->a, block[i].a);
+    }
+    #endif
+}
+
+RF_INTERNAL inline int rf_color_distance_sq(const int a[3], rf_color b)
+{
+    int dr = a[0] - b.r, dg = a[1] - b.g, db = a[2] - b.b;
+    return dr * dr + dg * dg + db * db;
+}
+
+RF_INTERNAL inline int rf_pack_565(float r, float g, float b)
+{
+    int r5 = (int) rf_quantize_u8((unsigned int) rf_clamp_i((int)(r + 0.5f), 0, 255), 31);
+    int g6 = (int) rf_quantize_u8((unsigned int) rf_clamp_i((int)(g + 0.5f), 0, 255), 63);
+    int b5 = (int) rf_quantize_u8((unsigned int) rf_clamp_i((int)(b + 0.5f), 0, 255), 31);
+    return r5 << 11 | g6 << 5 | b5;
+}
+
+// The palette decoders build from two 565 endpoints, the 3 color mode has black (transparent in DXT1 RGBA) as the last entry
+RF_INTERNAL void rf_bc1_palette(int c0, int c1, bool three_colors, int palette[4][3])
+{
+    palette[0][0] = rf_expand_5bit(c0 >> 11); palette[0][1] = rf_expand_6bit((c0 >> 5) & 63); palette[0][2] = rf_expand_5bit(c0 & 31);
+    palette[1][0] = rf_expand_5bit(c1 >> 11); palette[1][1] = rf_expand_6bit((c1 >> 5) & 63); palette[1][2] = rf_expand_5bit(c1 & 31);
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (three_colors)
+        {
+            palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+            palette[3][i] = 0;
+        }
+        else
+        {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+        }
+    }
+}
+
+/*
+ * Orders the endpoints for the mode, picks the closest palette entry for every pixel in opaque_mask and returns the squared error.
+ * In the 3 color mode the pixels outside of opaque_mask are set to the transparent entry.
+ */
+RF_INTERNAL int rf_bc1_fit(const rf_color block[16], unsigned int opaque_mask, int c0, int c1, bool three_colors, int* out_c0, int* out_c1, unsigned int* out_indices)
+{
+    // 4 colors needs c0 > c1 and 3 colors c0 <= c1, equal endpoints decode as 3 colors where index 0 is still the color
+    if ((three_colors && c0 > c1) || (!three_colors && c0 < c1))
+    {
+        int t = c0; c0 = c1; c1 = t;
+    }
 
-                // Typical values to start playing with:
-                //   lacunarity = ~2.0   -- spacing between successive octaves (use exactly 2.0 for wrapping output)
-                //   gain       =  0.5   -- relative weighting applied to each successive octave
-                //   octaves    =  6     -- number of "octaves" of noise3() to sum
+    int palette[4][3];
+    rf_bc1_palette(c0, c1, three_colors || c0 == c1, palette);
 
-                // NOTE: We need to translate the data from [-1..1] to [0..1]
-                float p = (stb_perlin_fbm_noise3(nx, ny, 1.0f, 2.0f, 0.5f, 6) + 1.0f) / 2.0f;
+    int palette_count = (three_colors || c0 == c1) ? 3 : 4;
+    int error = 0;
+    unsigned int indices = 0;
+
+    for (int i = 0; i < 16; i++)
+    {
+        unsigned int best = 3;
 
-                int intensity = (int)(p * 255.0f);
-                dst[y * width + x] = (rf_color){ intensity, intensity, intensity, 255 };
+        if (opaque_mask & (1u << i))
+        {
+            int best_error = INT_MAX;
+            for (int j = 0; j < palette_count; j++)
+            {
+                int e = rf_color_distance_sq(palette[j], block[i]);
+                if (e < best_error) { best_error = e; best = j; }
             }
+            error += best_error;
         }
 
-        result = (rf_image)
-        {
-            .data = dst,
-            .width = width,
-            .height = height,
-            .format = RF_UNCOMPRESSED_R8G8B8A8,
-            .valid = true,
-        };
+        indices |= best << (2 * i);
     }
 
-    return result;
+    *out_c0 = c0;
+    *out_c1 = c1;
+    *out_indices = indices;
+
+    return error;
 }
 
-RF_API rf_image rf_gen_image_perlin_noise(int width, int height, int offset_x, int offset_y, float scale, rf_allocator allocator)
+// Least squares endpoints for the current indices, returns false if the indices don't constrain both endpoints
+RF_INTERNAL bool rf_bc1_refine(const rf_color block[16], unsigned int opaque_mask, unsigned int indices, bool three_colors, int* c0, int* c1)
 {
-    rf_image result = {0};
+    static const float weights_4[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    static const float weights_3[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+    const float* weights = three_colors ? weights_3 : weights_4;
 
-    int dst_size = width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
-    rf_color* dst = RF_ALLOC(allocator, dst_size);
+    float aa = 0, bb = 0, ab = 0;
+    float ax[3] = {0}, bx[3] = {0};
 
-    if (dst)
+    for (int i = 0; i < 16; i++)
     {
-        result = rf_gen_image_perlin_noise_to_buffer(width, height, offset_x, offset_y, scale, dst, dst_size);
+        unsigned int index = (indices >> (2 * i)) & 3;
+        if (!(opaque_mask & (1u << i)) || (three_colors && index == 3)) continue;
+
+        float w = weights[index];
+        float x[3] = { block[i].r, block[i].g, block[i].b };
+
+        aa += w * w;
+        bb += (1 - w) * (1 - w);
+        ab += w * (1 - w);
+
+        for (int c = 0; c < 3; c++)
+        {
+            ax[c] += w * x[c];
+            bx[c] += (1 - w) * x[c];
+        }
     }
 
-    return result;
-}
+    float det = aa * bb - ab * ab;
+    if (det < 1e-6f) return false;
 
-RF_API rf_vec2 rf_get_seed_for_cellular_image(int seeds_per_row, int tile_size, int i, rf_rand_proc rand)
-{
-    rf_vec2 result = {0};
+    float a[3], b[3];
+    for (int c = 0; c < 3; c++)
+    {
+        a[c] = (ax[c] * bb - bx[c] * ab) / det;
+        b[c] = (bx[c] * aa - ax[c] * ab) / det;
+    }
 
-    int y = (i / seeds_per_row) * tile_size + rand(0, tile_size - 1);
-    int x = (i % seeds_per_row) * tile_size + rand(0, tile_size - 1);
-    result = (rf_vec2) { (float) x, (float) y };
+    *c0 = rf_pack_565(a[0], a[1], a[2]);
+    *c1 = rf_pack_565(b[0], b[1], b[2]);
 
-    return result;
+    return true;
 }
 
-// Generate image: cellular algorithm. Bigger tileSize means bigger cells
-RF_API rf_image rf_gen_image_cellular_to_buffer(int width, int height, int tile_size, rf_rand_proc rand, rf_color* dst, rf_int dst_size)
+/*
+ * Encodes the 8 byte color block shared by DXT1, DXT3 and DXT5. The endpoints start at the extremes of the pixels along their
+ * principal axis and are refined once with least squares. With dxt1_alpha the pixels with alpha below 128 become transparent.
+ */
+RF_INTERNAL void rf_encode_bc1_block(const rf_color block[16], bool dxt1_alpha, unsigned char* dst)
 {
-    rf_image result = {0};
+    unsigned int opaque_mask = 0xFFFF;
+    if (dxt1_alpha)
+    {
+        for (int i = 0; i < 16; i++) if (block[i].a < 128) opaque_mask &= ~(1u << i);
+    }
 
-    int seeds_per_row = width / tile_size;
-    int seeds_per_col = height / tile_size;
-    int seeds_count = seeds_per_row * seeds_per_col;
+    int c0 = 0, c1 = 0;
+    unsigned int indices = 0xFFFFFFFF;
+    bool three_colors = opaque_mask != 0xFFFF;
 
-    if (dst_size >= width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8))
+    if (opaque_mask)
     {
-        for (rf_int y = 0; y < height; y++)
+        float count = 0, mean[3] = {0};
+        for (int i = 0; i < 16; i++)
         {
-            int tile_y = y / tile_size;
-
-            for (rf_int x = 0; x < width; x++)
-            {
-                int tile_x = x / tile_size;
+            if (!(opaque_mask & (1u << i))) continue;
+            mean[0] += block[i].r; mean[1] += block[i].g; mean[2] += block[i].b;
+            count++;
+        }
+        for (int c = 0; c < 3; c++) mean[c] /= count;
 
-                float min_distance = INFINITY;
+        float cov[6] = {0}; // rr rg rb gg gb bb
+        for (int i = 0; i < 16; i++)
+        {
+            if (!(opaque_mask & (1u << i))) continue;
+            float r = block[i].r - mean[0], g = block[i].g - mean[1], b = block[i].b - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
 
-                // Check all adjacent tiles
-                for (rf_int i = -1; i < 2; i++)
-                {
-                    if ((tile_x + i < 0) || (tile_x + i >= seeds_per_row)) continue;
+        // Principal axis with a few power iterations, starting from the bounding box diagonal
+        rf_color lo, hi;
+        rf_block_bounds(block, &lo, &hi);
+        float axis[3] = { (float)(hi.r - lo.r), (float)(hi.g - lo.g), (float)(hi.b - lo.b) };
+        for (int iteration = 0; iteration < 4; iteration++)
+        {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float m = fmaxf(fabsf(x), fmaxf(fabsf(y), fabsf(z)));
+            if (m < 1e-6f) break;
+            axis[0] = x / m; axis[1] = y / m; axis[2] = z / m;
+        }
 
-                    for (rf_int j = -1; j < 2; j++)
-                    {
-                        if ((tile_y + j < 0) || (tile_y + j >= seeds_per_col)) continue;
+        float axis_length_sq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        float t_min = 0, t_max = 0;
 
-                        rf_vec2 neighbor_seed = rf_get_seed_for_cellular_image(seeds_per_row, tile_size, (tile_y + j) * seeds_per_row + tile_x + i, rand);
+        if (axis_length_sq > 1e-6f)
+        {
+            t_min = FLT_MAX; t_max = -FLT_MAX;
+            for (int i = 0; i < 16; i++)
+            {
+                if (!(opaque_mask & (1u << i))) continue;
+                float t = ((block[i].r - mean[0]) * axis[0] + (block[i].g - mean[1]) * axis[1] + (block[i].b - mean[2]) * axis[2]) / axis_length_sq;
+                t_min = fminf(t_min, t);
+                t_max = fmaxf(t_max, t);
+            }
+        }
 
-                        float dist = (float)hypot(x - (int)neighbor_seed.x, y - (int)neighbor_seed.y);
-                        min_distance = (float)fmin(min_distance, dist);
-                    }
-                }
+        int e0 = rf_pack_565(mean[0] + axis[0] * t_max, mean[1] + axis[1] * t_max, mean[2] + axis[2] * t_max);
+        int e1 = rf_pack_565(mean[0] + axis[0] * t_min, mean[1] + axis[1] * t_min, mean[2] + axis[2] * t_min);
+        int error = rf_bc1_fit(block, opaque_mask, e0, e1, three_colors, &c0, &c1, &indices);
 
-                // I made this up but it seems to give good results at all tile sizes
-                int intensity = (int)(min_distance * 256.0f / tile_size);
-                if (intensity > 255) intensity = 255;
+        int r0, r1;
+        if (error > 0 && rf_bc1_refine(block, opaque_mask, indices, three_colors, &r0, &r1))
+        {
+            int refined_c0, refined_c1;
+            unsigned int refined_indices;
+            int refined_error = rf_bc1_fit(block, opaque_mask, r0, r1, three_colors, &refined_c0, &refined_c1, &refined_indices);
 
-                dst[y * width + x] = (rf_color) { intensity, intensity, intensity, 255 };
+            if (refined_error < error)
+            {
+                c0 = refined_c0;
+                c1 = refined_c1;
+                indices = refined_indices;
             }
         }
-
-        result = (rf_image)
-        {
-            .data = dst,
-            .width = width,
-            .height = height,
-            .format = RF_UNCOMPRESSED_R8G8B8A8,
-            .valid = true,
-        };
     }
 
-    return result;
+    dst[0] = (unsigned char)(c0 & 0xFF); dst[1] = (unsigned char)(c0 >> 8);
+    dst[2] = (unsigned char)(c1 & 0xFF); dst[3] = (unsigned char)(c1 >> 8);
+    for (int i = 0; i < 4; i++) dst[4 + i] = (unsigned char)(indices >> (8 * i));
 }
 
-RF_API rf_image rf_gen_image_cellular(int width, int height, int tile_size, rf_rand_proc rand, rf_allocator allocator)
+// DXT3 alpha, 4 explicit bits per pixel
+RF_INTERNAL void rf_encode_bc2_alpha_block(const rf_color block[16], unsigned char* dst)
 {
-    rf_image result = {0};
+    for (int i = 0; i < 8; i++)
+    {
+        dst[i] = (unsigned char)(rf_quantize_u8(block[2 * i].a, 15) | rf_quantize_u8(block[2 * i + 1].a, 15) << 4);
+    }
+}
 
-    int dst_size = width * height * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
+// DXT5 alpha, 3 bit indices into 8 values interpolated between the smallest and the largest alpha of the block
+RF_INTERNAL void rf_encode_bc3_alpha_block(const rf_color block[16], unsigned char* dst)
+{
+    rf_color lo, hi;
+    rf_block_bounds(block, &lo, &hi);
 
-    rf_color* dst = RF_ALLOC(allocator, dst_size);
+    int a0 = hi.a, a1 = lo.a, range = a0 - a1;
+    uint64_t indices = 0;
 
-    if (dst)
+    if (range > 0)
     {
-        result = rf_gen_image_cellular_to_buffer(width, height, tile_size, rand, dst, dst_size);
+        for (int i = 0; i < 16; i++)
+        {
+            // t is the weight of a0 in sevenths, index 0 is a0, index 1 is a1 and index i in [2, 7] has a weight of 8 - i
+            int t = ((block[i].a - a1) * 7 + range / 2) / range;
+            uint64_t index = t == 7 ? 0 : (t == 0 ? 1 : 8 - t);
+            indices |= index << (3 * i);
+        }
     }
 
-    return result;
+    dst[0] = (unsigned char) a0;
+    dst[1] = (unsigned char) a1;
+    for (int i = 0; i < 6; i++) dst[2 + i] = (unsigned char)(indices >> (8 * i));
 }
 
-// Draw an image (source) within an image (destination)
-// NOTE: rf_color tint is applied to source image
-RF_API void rf_image_draw(rf_image* dst, rf_image src, rf_rec src_rec, rf_rec dst_rec, rf_color tint, rf_allocator temp_allocator)
-{
-    if (src.valid && dst->valid)
-    {
-        dst->valid = false;
+static const int rf_etc1_modifier_table[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
 
-        if (src_rec.x < 0) src_rec.x = 0;
-        if (src_rec.y < 0) src_rec.y = 0;
+// Finds the modifier table with the least error for the pixels of one sub block around a base color, indices are 2 bits per pixel in block order
+RF_INTERNAL int rf_etc1_fit_sub_block(const rf_color block[16], unsigned int pixel_mask, const int base[3], int* out_table, unsigned int* out_indices)
+{
+    int best_error = INT_MAX;
 
-        if ((src_rec.x + src_rec.width) > src.width)
+    for (int table = 0; table < 8; table++)
+    {
+        // Pixel index values 0 to 3 select +small, +large, -small and -large
+        int modifiers[4] = { rf_etc1_modifier_table[table][0], rf_etc1_modifier_table[table][1], -rf_etc1_modifier_table[table][0], -rf_etc1_modifier_table[table][1] };
+        int palette[4][3];
+        for (int m = 0; m < 4; m++)
         {
-            src_rec.width = src.width - src_rec.x;
-            RF_LOG(RF_LOG_TYPE_WARNING, "Source rectangle width out of bounds, rescaled width: %i", src_rec.width);
+            for (int c = 0; c < 3; c++) palette[m][c] = rf_clamp_i(base[c] + modifiers[m], 0, 255);
         }
 
-        if ((src_rec.y + src_rec.height) > src.height)
+        int error = 0;
+        unsigned int indices = 0;
+        for (int i = 0; i < 16 && error < best_error; i++)
         {
-            src_rec.height = src.height - src_rec.y;
-            RF_LOG(RF_LOG_TYPE_WARNING, "Source rectangle height out of bounds, rescaled height: %i", src_rec.height);
-        }
+            if (!(pixel_mask & (1u << i))) continue;
 
-        rf_image src_copy = rf_image_copy(src, temp_allocator); // Make a copy of source src to work with it
+            int best = 0, best_pixel_error = INT_MAX;
+            for (int m = 0; m < 4; m++)
+            {
+                int e = rf_color_distance_sq(palette[m], block[i]);
+                if (e < best_pixel_error) { best_pixel_error = e; best = m; }
+            }
 
-        // Crop source image to desired source rectangle (if required)
-        if ((src.width != (int)src_rec.width) && (src.height != (int)src_rec.height))
-        {
-            rf_image old_src_copy = src_copy;
-            src_copy = rf_image_crop(src_copy, src_rec, temp_allocator);
-            rf_unload_image(old_src_copy, temp_allocator);
+            error += best_pixel_error;
+            indices |= (unsigned int) best << (2 * i);
         }
 
-        // Scale source image in case destination rec size is different than source rec size
-        if (((int)dst_rec.width != (int)src_rec.width) || ((int)dst_rec.height != (int)src_rec.height))
+        if (error < best_error)
         {
-            rf_image old_src_copy = src_copy;
-            src_copy = rf_image_resize(src_copy, (int)dst_rec.width, (int)dst_rec.height, temp_allocator, temp_allocator);
-            rf_unload_image(old_src_copy, temp_allocator);
+            best_error = error;
+            *out_table = table;
+            *out_indices = indices;
         }
+    }
 
-        // Check that dstRec is inside dst image
-        // Allow negative position within destination with cropping
-        if (dst_rec.x < 0)
-        {
-            rf_image old_src_copy = src_copy;
-            src_copy = rf_image_crop(src_copy, (rf_rec) { -dst_rec.x, 0, dst_rec.width + dst_rec.x, dst_rec.height }, temp_allocator);
-            dst_rec.width = dst_rec.width + dst_rec.x;
-            dst_rec.x = 0;
-            rf_unload_image(old_src_copy, temp_allocator);
-        }
+    return best_error;
+}
 
-        if ((dst_rec.x + dst_rec.width) > dst->width)
-        {
-            rf_image old_src_copy = src_copy;
-            src_copy = rf_image_crop(src_copy, (rf_rec) { 0, 0, dst->width - dst_rec.x, dst_rec.height }, temp_allocator);
-            dst_rec.width = dst->width - dst_rec.x;
-            rf_unload_image(old_src_copy, temp_allocator);
-        }
+/*
+ * Encodes an ETC1 block with the individual or differential mode and the better of the two sub block orientations.
+ * The differential colors never overflow, so the block decodes the same as ETC2 RGB.
+ */
+RF_INTERNAL void rf_encode_etc1_block(const rf_color block[16], unsigned char* dst)
+{
+    uint64_t best_bits = 0;
+    int best_error = INT_MAX;
 
-        if (dst_rec.y < 0)
-        {
-            rf_image old_src_copy = src_copy;
-            src_copy = rf_image_crop(src_copy, (rf_rec) { 0, -dst_rec.y, dst_rec.width, dst_rec.height + dst_rec.y }, temp_allocator);
-            dst_rec.height = dst_rec.height + dst_rec.y;
-            dst_rec.y = 0;
-            rf_unload_image(old_src_copy, temp_allocator);
-        }
+    for (int flip = 0; flip < 2; flip++)
+    {
+        // Sub block 0 is the left half when flip is 0 and the top half when flip is 1, masks are in block order (y * 4 + x)
+        unsigned int masks[2] = { flip ? 0x00FF : 0x3333, flip ? 0xFF00 : 0xCCCC };
+        float average[2][3] = {0};
 
-        if ((dst_rec.y + dst_rec.height) > dst->height)
+        for (int s = 0; s < 2; s++)
         {
-            rf_image old_src_copy = src_copy;
-            src_copy = rf_image_crop(src_copy, (rf_rec) { 0, 0, dst_rec.width, dst->height - dst_rec.y }, temp_allocator);
-            dst_rec.height = dst->height - dst_rec.y;
-            rf_unload_image(old_src_copy, temp_allocator);
+            for (int i = 0; i < 16; i++)
+            {
+                if (!(masks[s] & (1u << i))) continue;
+                average[s][0] += block[i].r; average[s][1] += block[i].g; average[s][2] += block[i].b;
+            }
+            for (int c = 0; c < 3; c++) average[s][c] /= 8.0f;
         }
 
-        if (src_copy.valid)
+        // The differential mode keeps 5 bits per channel, the individual mode is only tried when the two colors are too far apart for it
+        for (int differential = 1; differential >= 0; differential--)
         {
-            // Get image data as rf_color pixels array to work with it
-            rf_color* dst_pixels = rf_image_pixels_to_rgba32(*dst, temp_allocator);
-            rf_color* src_pixels = rf_image_pixels_to_rgba32(src_copy, temp_allocator);
-
-            rf_unload_image(src_copy, temp_allocator); // Source copy not required any more
+            int levels = differential ? 31 : 15;
+            int quantized[2][3], base[2][3];
+            bool fits = true;
 
-            rf_vec4 fsrc, fdst, fout; // Normalized pixel data (ready for operation)
-            rf_vec4 ftint = rf_color_normalize(tint); // Normalized color tint
-
-            // Blit pixels, copy source image into destination
-            // TODO: Maybe out-of-bounds blitting could be considered here instead of so much cropping
-            for (rf_int j = (int)dst_rec.y; j < (int)(dst_rec.y + dst_rec.height); j++)
+            for (int s = 0; s < 2; s++)
             {
-                for (rf_int i = (int)dst_rec.x; i < (int)(dst_rec.x + dst_rec.width); i++)
+                for (int c = 0; c < 3; c++)
                 {
-                    // Alpha blending (https://en.wikipedia.org/wiki/Alpha_compositing)
+                    quantized[s][c] = (int) rf_quantize_u8((unsigned int)(average[s][c] + 0.5f), levels);
+                    base[s][c] = differential ? rf_expand_5bit(quantized[s][c]) : rf_expand_4bit(quantized[s][c]);
+                }
+            }
 
-                    fdst = rf_color_normalize(dst_pixels[j * (int)dst->width + i]);
-                    fsrc = rf_color_normalize(src_pixels[(j - (int)dst_rec.y) * (int)dst_rec.width + (i - (int)dst_rec.x)]);
+            if (differential)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    int delta = quantized[1][c] - quantized[0][c];
+                    if (delta < -4 || delta > 3) fits = false;
+                }
+            }
 
-                    // Apply color tint to source image
-                    fsrc.x *= ftint.x; fsrc.y *= ftint.y; fsrc.z *= ftint.z; fsrc.w *= ftint.w;
+            if (!fits) continue;
+            if (!differential && best_error != INT_MAX) break;
 
-                    fout.w = fsrc.w + fdst.w * (1.0f - fsrc.w);
+            int tables[2];
+            unsigned int indices[2];
+            int error = rf_etc1_fit_sub_block(block, masks[0], base[0], &tables[0], &indices[0]);
+            error += rf_etc1_fit_sub_block(block, masks[1], base[1], &tables[1], &indices[1]);
 
-                    if (fout.w <= 0.0f)
-                    {
-                        fout.x = 0.0f;
-                        fout.y = 0.0f;
-                        fout.z = 0.0f;
-                    }
-                    else
-                    {
-                        fout.x = (fsrc.x*fsrc.w + fdst.x*fdst.w*(1 - fsrc.w))/fout.w;
-                        fout.y = (fsrc.y*fsrc.w + fdst.y*fdst.w*(1 - fsrc.w))/fout.w;
-                        fout.z = (fsrc.z*fsrc.w + fdst.z*fdst.w*(1 - fsrc.w))/fout.w;
-                    }
+            if (error >= best_error) continue;
+            best_error = error;
 
-                    dst_pixels[j*(int)dst->width + i] = (rf_color) { (unsigned char)(fout.x * 255.0f),
-                                                                    (unsigned char)(fout.y * 255.0f),
-                                                                    (unsigned char)(fout.z * 255.0f),
-                                                                    (unsigned char)(fout.w * 255.0f) };
+            uint64_t bits = 0;
+            if (differential)
+            {
+                bits |= (uint64_t) quantized[0][0] << 59 | (uint64_t)((quantized[1][0] - quantized[0][0]) & 7) << 56;
+                bits |= (uint64_t) quantized[0][1] << 51 | (uint64_t)((quantized[1][1] - quantized[0][1]) & 7) << 48;
+                bits |= (uint64_t) quantized[0][2] << 43 | (uint64_t)((quantized[1][2] - quantized[0][2]) & 7) << 40;
+            }
+            else
+            {
+                bits |= (uint64_t) quantized[0][0] << 60 | (uint64_t) quantized[1][0] << 56;
+                bits |= (uint64_t) quantized[0][1] << 52 | (uint64_t) quantized[1][1] << 48;
+                bits |= (uint64_t) quantized[0][2] << 44 | (uint64_t) quantized[1][2] << 40;
+            }
+            bits |= (uint64_t) tables[0] << 37 | (uint64_t) tables[1] << 34 | (uint64_t) differential << 33 | (uint64_t) flip << 32;
 
-                    // TODO: Support other blending options
-                }
+            // The pixel index bits are stored column by column, the high bits in the upper half word and the low bits in the lower one
+            for (int i = 0; i < 16; i++)
+            {
+                unsigned int index = (indices[(masks[0] >> i) & 1 ? 0 : 1] >> (2 * i)) & 3;
+                int bit = (i & 3) * 4 + (i >> 2);
+                bits |= (uint64_t)(index >> 1) << (16 + bit) | (uint64_t)(index & 1) << bit;
             }
 
-            bool format_success = rf_format_pixels(dst_pixels, rf_image_size_in_format(*dst, RF_UNCOMPRESSED_R8G8B8A8), RF_UNCOMPRESSED_R8G8B8A8,
-                             dst->data, rf_image_size(*dst), dst->format);
-            RF_ASSERT(format_success);
+            best_bits = bits;
+        }
+    }
+
+    for (int i = 0; i < 8; i++) dst[i] = (unsigned char)(best_bits >> (56 - 8 * i));
+}
+
+static const int rf_eac_modifier_table[16][8] = {
+    { -3, -6,  -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 }, { -2, -5, -8, -13, 1, 4, 7, 12 }, { -2, -4, -6, -13, 1, 3, 5, 12 },
+    { -3, -6,  -8, -12, 2, 5, 7, 11 }, { -3, -7,  -9, -11, 2, 6, 8, 10 }, { -4, -7, -8, -11, 3, 6, 7, 10 }, { -3, -5, -8, -11, 2, 4, 7, 10 },
+    { -2, -6,  -8, -10, 1, 5, 7,  9 }, { -2, -5,  -8, -10, 1, 4, 7,  9 }, { -2, -4, -8, -10, 1, 3, 7,  9 }, { -2, -5, -7, -10, 1, 4, 6,  9 },
+    { -3, -4,  -7, -10, 2, 3, 6,  9 }, { -1, -2,  -3, -10, 0, 1, 2,  9 }, { -4, -6, -8,  -9, 3, 5, 7,  8 }, { -3, -5, -7,  -9, 2, 4, 6,  8 },
+};
+
+// ETC2 EAC alpha, a base value plus a multiplier times one of the 8 modifiers of a table, the tables and multipliers around the alpha range are searched
+RF_INTERNAL void rf_encode_eac_alpha_block(const rf_color block[16], unsigned char* dst)
+{
+    rf_color lo, hi;
+    rf_block_bounds(block, &lo, &hi);
+
+    // Table 13 has a 0 modifier, so flat blocks are stored exactly
+    int best_base = lo.a, best_multiplier = 1, best_table = 13, best_error = INT_MAX;
+    uint64_t best_indices = 0;
+
+    if (lo.a == hi.a)
+    {
+        for (int i = 0; i < 16; i++) best_indices |= (uint64_t) 4 << (45 - 3 * ((i & 3) * 4 + (i >> 2)));
+    }
+    else for (int table = 0; table < 16 && best_error; table++)
+    {
+        const int* modifiers = rf_eac_modifier_table[table];
+        int span = modifiers[7] - modifiers[3];
+        int center_multiplier = rf_clamp_i(((hi.a - lo.a) + span / 2) / span, 1, 15);
+
+        for (int multiplier = rf_max_i(center_multiplier - 1, 1); multiplier <= rf_min_i(center_multiplier + 1, 15); multiplier++)
+        {
+            int base = rf_clamp_i((lo.a + hi.a - (modifiers[3] + modifiers[7]) * multiplier + 1) / 2, 0, 255);
+            int error = 0;
+            uint64_t indices = 0;
+
+            for (int i = 0; i < 16 && error < best_error; i++)
+            {
+                int best = 0, best_pixel_error = INT_MAX;
+                for (int m = 0; m < 8; m++)
+                {
+                    int d = rf_clamp_i(base + modifiers[m] * multiplier, 0, 255) - block[i].a;
+                    if (d * d < best_pixel_error) { best_pixel_error = d * d; best = m; }
+                }
 
-            RF_FREE(temp_allocator, src_pixels);
-            RF_FREE(temp_allocator, dst_pixels);
+                error += best_pixel_error;
+                indices |= (uint64_t) best << (45 - 3 * ((i & 3) * 4 + (i >> 2)));
+            }
 
-            dst->valid = true;
+            if (error < best_error)
+            {
+                best_error = error;
+                best_base = base;
+                best_multiplier = multiplier;
+                best_table = table;
+                best_indices = indices;
+            }
         }
     }
+
+    uint64_t bits = (uint64_t) best_base << 56 | (uint64_t) best_multiplier << 52 | (uint64_t) best_table << 48 | best_indices;
+    for (int i = 0; i < 8; i++) dst[i] = (unsigned char)(bits >> (56 - 8 * i));
 }
 
-// Draw rectangle within an image
-RF_API void rf_image_draw_rectangle(rf_image* dst, rf_rec rec, rf_color color, rf_allocator temp_allocator)
+RF_INTERNAL void rf_encode_block(rf_compressed_pixel_format format, const rf_color block[16], unsigned char* dst)
 {
-    if (dst->valid)
+    switch (format)
     {
-        dst->valid = false;
+        case RF_COMPRESSED_DXT1_RGB:  rf_encode_bc1_block(block, false, dst); break;
+        case RF_COMPRESSED_DXT1_RGBA: rf_encode_bc1_block(block, true, dst); break;
+        case RF_COMPRESSED_DXT3_RGBA: rf_encode_bc2_alpha_block(block, dst); rf_encode_bc1_block(block, false, dst + 8); break;
+        case RF_COMPRESSED_DXT5_RGBA: rf_encode_bc3_alpha_block(block, dst); rf_encode_bc1_block(block, false, dst + 8); break;
+        case RF_COMPRESSED_ETC1_RGB:
+        case RF_COMPRESSED_ETC2_RGB:  rf_encode_etc1_block(block, dst); break;
+        case RF_COMPRESSED_ETC2_EAC_RGBA: rf_encode_eac_alpha_block(block, dst); rf_encode_etc1_block(block, dst + 8); break;
+        default: break;
+    }
+}
+
+typedef struct rf_block_compression_job_data
+{
+    const rf_color* src;
+    int width;
+    int height;
+    rf_compressed_pixel_format format;
+    unsigned char* dst;
+} rf_block_compression_job_data;
 
-        rf_image src = rf_gen_image_color((int)rec.width, (int)rec.height, color, temp_allocator);
+RF_INTERNAL void rf_block_compression_job(void* job_data, rf_int job_index)
+{
+    const rf_block_compression_job_data* data = job_data;
 
-        if (src.valid)
-        {
-            rf_rec src_rec = (rf_rec){ 0, 0, rec.width, rec.height };
+    int blocks_x = (data->width + 3) / 4;
+    int blocks_y = (data->height + 3) / 4;
+    int block_size = rf_pixel_buffer_size(4, 4, data->format);
+    int by_end = rf_min_i((int)((job_index + 1) * RF_BLOCK_COMPRESSION_ROWS_PER_JOB), blocks_y);
 
-            rf_image_draw(dst, src, src_rec, rec, RF_WHITE, temp_allocator);
+    for (int by = (int)(job_index * RF_BLOCK_COMPRESSION_ROWS_PER_JOB); by < by_end; by++)
+    {
+        unsigned char* dst = data->dst + (rf_int) by * blocks_x * block_size;
 
-            rf_unload_image(src, temp_allocator);
+        for (int bx = 0; bx < blocks_x; bx++)
+        {
+            rf_color block[16];
+            rf_load_block(data->src, data->width, data->height, bx * 4, by * 4, block);
+            rf_encode_block(data->format, block, dst + (rf_int) bx * block_size);
         }
     }
 }
 
-// Draw rectangle lines within an image
-RF_API void rf_image_draw_rectangle_lines(rf_image* dst, rf_rec rec, int thick, rf_color color, rf_allocator temp_allocator)
+/**
+ * Compresses an image to one of the block compressed formats that gpus decode in hardware.
+ * Images that are not RGBA are converted first with the temp_allocator.
+ * @param image a valid image in an uncompressed format.
+ * @param dst_format DXT1 (RGB or RGBA with 1 bit alpha), DXT3, DXT5, ETC1, ETC2 RGB or ETC2 EAC RGBA, check with rf_supports_block_compression.
+ * @param dst a buffer of at least rf_pixel_buffer_size(image.width, image.height, dst_format) bytes.
+ * @return a compressed image pointing to dst, or an invalid image on failure.
+ */
+RF_API rf_image rf_image_compress_to_buffer(rf_image image, rf_compressed_pixel_format dst_format, void* dst, rf_int dst_size, rf_allocator temp_allocator)
 {
-    rf_image_draw_rectangle(dst, (rf_rec) { rec.x, rec.y, rec.width, thick }, color, temp_allocator);
-    rf_image_draw_rectangle(dst, (rf_rec) { rec.x, rec.y + thick, thick, rec.height - thick * 2 }, color, temp_allocator);
-    rf_image_draw_rectangle(dst, (rf_rec) { rec.x + rec.width - thick, rec.y + thick, thick, rec.height - thick * 2 }, color, temp_allocator);
-    rf_image_draw_rectangle(dst, (rf_rec) { rec.x, rec.y + rec.height - thick, rec.width, thick }, color, temp_allocator);
-}
+    rf_image result = {0};
 
-#pragma endregion
+    if (!image.valid || !rf_is_uncompressed_format(image.format))
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image is invalid or already compressed. Image format: %d.", image.format);
+        return result;
+    }
 
-#pragma region mipmaps
+    if (!rf_supports_block_compression(dst_format))
+    {
+        RF_LOG_ERROR(RF_UNSUPPORTED, "Cannot compress to format %d.", dst_format);
+        return result;
+    }
 
-RF_API int rf_mipmaps_image_size(rf_mipmaps_image image)
+    int compressed_size = rf_pixel_buffer_size(image.width, image.height, dst_format);
+    if (dst_size < compressed_size)
+    {
+        RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Destination buffer is too small. Expected: %d, Received: %d.", compressed_size, dst_size);
+        return result;
+    }
+
+    const rf_color* src = image.data;
+    rf_color* converted = NULL;
+
+    if (image.format != RF_UNCOMPRESSED_R8G8B8A8)
+    {
+        rf_int converted_size = (rf_int) image.width * image.height * sizeof(rf_color);
+        converted = RF_ALLOC(temp_allocator, converted_size);
+
+        if (!converted)
+        {
+            RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", converted_size);
+            return result;
+        }
+
+        rf_format_pixels_to_rgba32(image.data, rf_image_size(image), image.format, converted, converted_size);
+        src = converted;
+    }
+
+    rf_block_compression_job_data data = { src, image.width, image.height, dst_format, dst };
+    int blocks_y = (image.height + 3) / 4;
+    rf_parallel_for(rf_block_compression_job, &data, (blocks_y + RF_BLOCK_COMPRESSION_ROWS_PER_JOB - 1) / RF_BLOCK_COMPRESSION_ROWS_PER_JOB);
+
+    RF_FREE(temp_allocator, converted);
+
+    result = (rf_image)
+    {
+        .data   = dst,
+        .width  = image.width,
+        .height = image.height,
+        .format = dst_format,
+        .valid  = true,
+    };
+
+    return result;
+}
+
+RF_API rf_image rf_image_compress(rf_image image, rf_compressed_pixel_format dst_format, rf_allocator allocator, rf_allocator temp_allocator)
 {
-    int size   = 0;
-    int width  = image.width;
-    int height = image.height;
+    rf_image result = {0};
 
-    for (rf_int i = 0; i < image.mipmaps; i++)
+    if (image.valid && rf_supports_block_compression(dst_format))
     {
-        size += width * height * rf_bytes_per_pixel(image.format);
+        int dst_size = rf_pixel_buffer_size(image.width, image.height, dst_format);
+        void* dst = RF_ALLOC(allocator, dst_size);
 
-        width  /= 2;
-        height /= 2;
+        if (dst)
+        {
+            result = rf_image_compress_to_buffer(image, dst_format, dst, dst_size, temp_allocator);
 
-        // Security check for NPOT textures
-        if (width  < 1) width  = 1;
-        if (height < 1) height = 1;
+            if (!result.valid) RF_FREE(allocator, dst);
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", dst_size);
     }
+    else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image is invalid or format %d cannot be compressed to.", dst_format);
 
-    return size;
+    return result;
 }
 
-RF_API rf_mipmaps_stats rf_compute_mipmaps_stats(rf_image image, int desired_mipmaps_count)
+#pragma endregion
+
+#pragma region collision mask
+
+RF_API rf_int rf_collision_mask_size(int width, int height)
 {
-    if (!image.valid) return (rf_mipmaps_stats) {0};
+    if (width <= 0 || height <= 0) return 0;
 
-    int possible_mip_count = 1;
-    int mipmaps_size = rf_image_size(image);
+    return (rf_int) height * ((width + 63) / 64 + 2) * sizeof(uint64_t);
+}
 
-    int mip_width = image.width;
-    int mip_height = image.height;
+// Sets the bit of every pixel in the row with an alpha above the threshold, dst must be cleared before
+RF_INTERNAL void rf_collision_mask_fill_row(const rf_color* src, int width, unsigned char threshold, uint64_t* dst)
+{
+    int x = 0;
 
-    while (mip_width != 1 || mip_height != 1 || possible_mip_count == desired_mipmaps_count)
+    #if defined(RF_SIMD_SSE2)
+    // Unsigned compare done as a signed compare after flipping the top bit
+    __m128i bias  = _mm_set1_epi8((char) 0x80);
+    __m128i limit = _mm_set1_epi8((char)(threshold ^ 0x80));
+
+    for (; x + 16 <= width; x += 16)
     {
-        if (mip_width  != 1) mip_width  /= 2;
-        if (mip_height != 1) mip_height /= 2;
+        const __m128i* p = (const __m128i*)(src + x);
+        __m128i a0 = _mm_srli_epi32(_mm_loadu_si128(p + 0), 24);
+        __m128i a1 = _mm_srli_epi32(_mm_loadu_si128(p + 1), 24);
+        __m128i a2 = _mm_srli_epi32(_mm_loadu_si128(p + 2), 24);
+        __m128i a3 = _mm_srli_epi32(_mm_loadu_si128(p + 3), 24);
 
-        // Safety check for NPOT textures
-        if (mip_width  < 1) mip_width  = 1;
-        if (mip_height < 1) mip_height = 1;
+        __m128i alpha = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+        uint64_t bits = (unsigned) _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_xor_si128(alpha, bias), limit));
 
-        mipmaps_size += mip_width * mip_height * rf_bytes_per_pixel(image.format);
+        dst[x >> 6] |= bits << (x & 63);
+    }
+    #elif defined(RF_SIMD_NEON)
+    static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t weight = vld1q_u8(weights);
+    uint8x16_t limit  = vdupq_n_u8(threshold);
 
-        possible_mip_count++;
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8((const uint8_t*)(src + x));
+        uint8x16_t set = vandq_u8(vcgtq_u8(pixels.val[3], limit), weight);
+        uint64x2_t sums = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(set)));
+        uint64_t bits = vgetq_lane_u64(sums, 0) | (vgetq_lane_u64(sums, 1) << 8);
+
+        dst[x >> 6] |= bits << (x & 63);
     }
+    #endif
 
-    return (rf_mipmaps_stats) { possible_mip_count, mipmaps_size };
+    for (; x < width; x++)
+    {
+        if (src[x].a > threshold) dst[x >> 6] |= (uint64_t) 1 << (x & 63);
+    }
 }
 
-// Generate all mipmap levels for a provided image. image.data is scaled to include mipmap levels. Mipmaps format is the same as base image
-RF_API rf_mipmaps_image rf_image_gen_mipmaps_to_buffer(rf_image image, int gen_mipmaps_count, void* dst, rf_int dst_size, rf_allocator temp_allocator)
+// Grows the bounds of the mask to include the set pixels of row y
+RF_INTERNAL void rf_collision_mask_add_row_bounds(rf_collision_mask* mask, const uint64_t* row, int y)
 {
-    if (image.valid) return (rf_mipmaps_image) {0};
+    int words = mask->words_per_row - 2;
 
-    rf_mipmaps_image result = {0};
-    rf_mipmaps_stats mipmap_stats = rf_compute_mipmaps_stats(image, gen_mipmaps_count);
+    int first = 0;
+    while (first < words && !row[first]) first++;
+    if (first == words) return;
+
+    int last = words - 1;
+    while (!row[last]) last--;
+
+    int min_x = first * 64;
+    while (!((row[first] >> (min_x & 63)) & 1)) min_x++;
+
+    int max_x = last * 64 + 63;
+    while (!((row[last] >> (max_x & 63)) & 1)) max_x--;
+
+    mask->min_x = rf_min_i(mask->min_x, min_x);
+    mask->max_x = rf_max_i(mask->max_x, max_x);
+    mask->min_y = rf_min_i(mask->min_y, y);
+    mask->max_y = rf_max_i(mask->max_y, y);
+}
+
+/**
+ * Builds a collision mask from the alpha of an image, images that are not RGBA are converted one row at a time with the temp_allocator.
+ * @param threshold pixels with an alpha above threshold * 255 are set.
+ * @param dst a buffer of at least rf_collision_mask_size(image.width, image.height) bytes aligned to 8 bytes.
+ * @return a mask pointing to dst, or an invalid mask on failure.
+ */
+RF_API rf_collision_mask rf_collision_mask_from_image_to_buffer(rf_image image, float threshold, void* dst, rf_int dst_size, rf_allocator temp_allocator)
+{
+    rf_collision_mask result = {0};
+
+    if (!image.valid || !rf_is_uncompressed_format(image.format))
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image is invalid or compressed. Image format: %d.", image.format);
+        return result;
+    }
+
+    rf_int mask_size = rf_collision_mask_size(image.width, image.height);
+    if (dst_size < mask_size)
+    {
+        RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Destination buffer is too small. Expected: %d, Received: %d.", mask_size, dst_size);
+        return result;
+    }
 
-    if (mipmap_stats.possible_mip_counts <= gen_mipmaps_count)
+    int bpp = rf_bytes_per_pixel(image.format);
+    rf_color* converted_row = NULL;
+
+    if (image.format != RF_UNCOMPRESSED_R8G8B8A8)
     {
-        if (dst_size == mipmap_stats.mipmaps_buffer_size)
+        converted_row = RF_ALLOC(temp_allocator, image.width * sizeof(rf_color));
+
+        if (!converted_row)
         {
-            // Pointer to current mip location in the dst buffer
-            unsigned char* dst_iter = dst;
+            RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", image.width * sizeof(rf_color));
+            return result;
+        }
+    }
 
-            // Copy the image to the dst as the first mipmap level
-            memcpy(dst_iter, image.data, rf_image_size(image));
-            dst_iter += rf_image_size(image);
+    memset(dst, 0, mask_size);
+
+    result = (rf_collision_mask)
+    {
+        .bits          = dst,
+        .width         = image.width,
+        .height        = image.height,
+        .words_per_row = (image.width + 63) / 64 + 2,
+        .min_x         = image.width,
+        .min_y         = image.height,
+        .max_x         = -1,
+        .max_y         = -1,
+        .valid         = true,
+    };
 
-            // Create a rgba32 buffer for the mipmap result, half the image size is enough for any mipmap level
-            int temp_mipmap_buffer_size = (image.width / 2) * (image.height / 2) * rf_bytes_per_pixel(RF_UNCOMPRESSED_R8G8B8A8);
-            void* temp_mipmap_buffer = RF_ALLOC(temp_allocator, temp_mipmap_buffer_size);
+    unsigned char alpha_threshold = (unsigned char)(threshold * 255.0f);
 
-            if (temp_mipmap_buffer)
-            {
-                int mip_width  = image.width  / 2;
-                int mip_height = image.height / 2;
-                int mip_count = 1;
-                for (; mip_count < gen_mipmaps_count; mip_count++)
-                {
-                    rf_image mipmap = rf_image_resize_to_buffer(image, mip_width, mip_height, temp_mipmap_buffer, temp_mipmap_buffer_size, temp_allocator);
+    for (int y = 0; y < image.height; y++)
+    {
+        const rf_color* src = (const rf_color*) image.data + (rf_int) y * image.width;
 
-                    if (mipmap.valid)
-                    {
-                        int dst_iter_size = dst_size - ((int)(dst_iter - ((unsigned char*)(dst))));
+        if (converted_row)
+        {
+            const unsigned char* src_row = (const unsigned char*) image.data + (rf_int) y * image.width * bpp;
+            rf_format_pixels_to_rgba32(src_row, image.width * bpp, image.format, converted_row, image.width * sizeof(rf_color));
+            src = converted_row;
+        }
 
-                        bool success = rf_format_pixels(mipmap.data, rf_image_size(mipmap), mipmap.format, dst_iter, dst_iter_size, image.format);
-                        RF_ASSERT(success);
-                    }
-                    else break;
+        uint64_t* row = result.bits + (rf_int) y * result.words_per_row + 1;
+        rf_collision_mask_fill_row(src, image.width, alpha_threshold, row);
+        rf_collision_mask_add_row_bounds(&result, row, y);
+    }
 
-                    mip_width  /= 2;
-                    mip_height /= 2;
+    RF_FREE(temp_allocator, converted_row);
 
-                    // Security check for NPOT textures
-                    if (mip_width  < 1) mip_width  = 1;
-                    if (mip_height < 1) mip_height = 1;
+    return result;
+}
 
-                    // Compute next mipmap location in the dst buffer
-                    dst_iter += mip_width * mip_height * rf_bytes_per_pixel(image.format);
-                }
+RF_API rf_collision_mask rf_collision_mask_from_image(rf_image image, float threshold, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    rf_collision_mask result = {0};
 
-                if (mip_count == gen_mipmaps_count)
-                {
-                    result = (rf_mipmaps_image){
-                        .data = dst,
-                        .width = image.width,
-                        .height = image.height,
-                        .mipmaps = gen_mipmaps_count,
-                        .format = image.format,
-                        .valid = true
-                    };
-                }
-            }
+    if (image.valid)
+    {
+        rf_int size = rf_collision_mask_size(image.width, image.height);
+        void* dst = RF_ALLOC(allocator, size);
+
+        if (dst)
+        {
+            result = rf_collision_mask_from_image_to_buffer(image, threshold, dst, size, temp_allocator);
 
-            RF_FREE(temp_allocator, temp_mipmap_buffer);
+            if (!result.valid) RF_FREE(allocator, dst);
         }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed.", size);
     }
-    else RF_LOG(RF_LOG_TYPE_WARNING, "rf_image mipmaps already available");
+    else RF_LOG_ERROR(RF_BAD_ARGUMENT, "Image is invalid.");
 
     return result;
 }
 
-RF_API rf_mipmaps_image rf_image_gen_mipmaps(rf_image image, int desired_mipmaps_count, rf_allocator allocator, rf_allocator temp_allocator)
+RF_API bool rf_collision_mask_get(rf_collision_mask mask, int x, int y)
 {
-    if (!image.valid) return (rf_mipmaps_image) {0};
+    if (!mask.valid || x < 0 || y < 0 || x >= mask.width || y >= mask.height) return false;
 
-    rf_mipmaps_image result = {0};
-    rf_mipmaps_stats mipmap_stats = rf_compute_mipmaps_stats(image, desired_mipmaps_count);
+    const uint64_t* row = mask.bits + (rf_int) y * mask.words_per_row + 1;
+
+    return (row[x >> 6] >> (x & 63)) & 1;
+}
+
+// The 64 pixels of a row that start at bit shift of word, word can be -1 or one past the last word because of the padding
+RF_INTERNAL inline uint64_t rf_collision_mask_word(const uint64_t* row, int word, int shift)
+{
+    uint64_t result = row[word] >> shift;
+    if (shift) result |= row[word + 1] << (64 - shift);
+    return result;
+}
+
+/*
+ * The overlap of the bounds of the set pixels is tested first, then for every row in the overlap the words of a are
+ * AND-ed with the words of b shifted to the same x. Only the words that cover the overlap are read.
+ */
+RF_API bool rf_check_collision_masks(rf_collision_mask a, int a_x, int a_y, rf_collision_mask b, int b_x, int b_y)
+{
+    if (!a.valid || !b.valid) return false;
+
+    int x0 = rf_max_i(a_x + a.min_x, b_x + b.min_x);
+    int x1 = rf_min_i(a_x + a.max_x, b_x + b.max_x);
+    int y0 = rf_max_i(a_y + a.min_y, b_y + b.min_y);
+    int y1 = rf_min_i(a_y + a.max_y, b_y + b.max_y);
+
+    if (x0 > x1 || y0 > y1) return false;
 
-    if (mipmap_stats.possible_mip_counts <= desired_mipmaps_count)
+    // Word w of a row of a covers the pixels of b starting at w * 64 + (a_x - b_x)
+    int offset = a_x - b_x;
+    int shift = ((offset % 64) + 64) % 64;
+    int word_offset = (offset - shift) / 64;
+
+    int first_word = (x0 - a_x) / 64;
+    int last_word  = (x1 - a_x) / 64;
+
+    for (int y = y0; y <= y1; y++)
     {
-        void* dst = RF_ALLOC(allocator, mipmap_stats.mipmaps_buffer_size);
+        const uint64_t* row_a = a.bits + (rf_int)(y - a_y) * a.words_per_row + 1;
+        const uint64_t* row_b = b.bits + (rf_int)(y - b_y) * b.words_per_row + 1;
+        int w = first_word;
 
-        if (dst)
+        #if defined(RF_SIMD_SSE2)
+        __m128i right = _mm_cvtsi32_si128(shift);
+        __m128i left  = _mm_cvtsi32_si128(64 - shift); // A shift by 64 gives 0 so no special case for shift 0
+
+        for (; w + 1 <= last_word; w += 2)
         {
-            result = rf_image_gen_mipmaps_to_buffer(image, desired_mipmaps_count, dst, mipmap_stats.mipmaps_buffer_size, temp_allocator);
-            if (!result.valid)
-            {
-                RF_FREE(allocator, dst);
-            }
+            __m128i lo  = _mm_srl_epi64(_mm_loadu_si128((const __m128i*)(row_b + w + word_offset)), right);
+            __m128i hi  = _mm_sll_epi64(_mm_loadu_si128((const __m128i*)(row_b + w + word_offset + 1)), left);
+            __m128i hit = _mm_and_si128(_mm_loadu_si128((const __m128i*)(row_a + w)), _mm_or_si128(lo, hi));
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(hit, _mm_setzero_si128())) != 0xFFFF) return true;
+        }
+        #elif defined(RF_SIMD_NEON)
+        int64x2_t right = vdupq_n_s64(-shift);
+        int64x2_t left  = vdupq_n_s64(64 - shift);
+
+        for (; w + 1 <= last_word; w += 2)
+        {
+            uint64x2_t lo  = vshlq_u64(vld1q_u64(row_b + w + word_offset), right);
+            uint64x2_t hi  = vshlq_u64(vld1q_u64(row_b + w + word_offset + 1), left);
+            uint64x2_t hit = vandq_u64(vld1q_u64(row_a + w), vorrq_u64(lo, hi));
+
+            if (vgetq_lane_u64(hit, 0) | vgetq_lane_u64(hit, 1)) return true;
+        }
+        #endif
+
+        for (; w <= last_word; w++)
+        {
+            if (row_a[w] & rf_collision_mask_word(row_b, w + word_offset, shift)) return true;
         }
     }
 
-    return result;
+    return false;
 }
 
-RF_API void rf_unload_mipmaps_image(rf_mipmaps_image image, rf_allocator allocator)
+RF_API void rf_unload_collision_mask(rf_collision_mask mask, rf_allocator allocator)
 {
-    RF_FREE(allocator, image.data);
+    RF_FREE(allocator, mask.bits);
 }
 
 #pragma endregion
@@ -18145,6 +23260,250 @@ RF_API void rf_unload_gif(rf_gif gif, rf_allocator allocator)
     }
 }
 
+#pragma region gif player
+
+// Browsers show frames with a delay of 10ms or less for 100ms, most gifs are made with that in mind
+#ifndef RF_GIF_DEFAULT_FRAME_DELAY
+    #define RF_GIF_DEFAULT_FRAME_DELAY (100)
+#endif
+
+struct rf_gif_decoder
+{
+    stbi__context  context;
+    stbi__gif      gif;
+    rf_stbi_stream stream;      // Used when the gif is streamed from a file
+    const void*    data;        // Used when the gif is decoded from memory
+    rf_int         data_size;
+    void*          owned_data;  // Copy of the file when the io can't stream it
+    unsigned char* previous[2]; // The last two frames, a frame can be disposed back to the one before it
+    rf_allocator   allocator;
+};
+
+RF_INTERNAL void rf_gif_decoder_free_frames(struct rf_gif_decoder* decoder)
+{
+    RF_FREE(decoder->allocator, decoder->gif.out);
+    RF_FREE(decoder->allocator, decoder->gif.background);
+    RF_FREE(decoder->allocator, decoder->gif.history);
+    memset(&decoder->gif, 0, sizeof(decoder->gif));
+}
+
+// Goes back to the start of the gif, stb_image reads the header again with the first frame
+RF_INTERNAL bool rf_gif_decoder_start(struct rf_gif_decoder* decoder)
+{
+    rf_gif_decoder_free_frames(decoder);
+
+    if (decoder->stream.file)
+    {
+        stbi_io_callbacks callbacks = { rf_stbi_stream_read, rf_stbi_stream_skip, rf_stbi_stream_eof };
+
+        if (decoder->stream.position) RF_SKIP_STREAM(decoder->stream.io, decoder->stream.file, -decoder->stream.position);
+        decoder->stream.position = 0;
+
+        stbi__start_callbacks(&decoder->context, &callbacks, &decoder->stream);
+    }
+    else stbi__start_mem(&decoder->context, decoder->data, (int) decoder->data_size);
+
+    return stbi__gif_test(&decoder->context);
+}
+
+RF_INTERNAL bool rf_gif_decoder_load_next(struct rf_gif_decoder* decoder, unsigned char* two_back, bool* ended)
+{
+    int comp = 0;
+
+    RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(decoder->allocator);
+    stbi_uc* frame = stbi__gif_load_next(&decoder->context, &decoder->gif, &comp, 4, two_back);
+    RF_SET_GLOBAL_DEPENDENCIES_ALLOCATOR(RF_NULL_ALLOCATOR);
+
+    // stb_image returns the context to mark the end of the animation
+    *ended = frame == (stbi_uc*) &decoder->context;
+
+    return frame != NULL;
+}
+
+RF_INTERNAL rf_gif_player rf_gif_player_start(struct rf_gif_decoder* decoder)
+{
+    rf_gif_player result = {0};
+    bool ended = false;
+
+    if (rf_gif_decoder_start(decoder) && rf_gif_decoder_load_next(decoder, NULL, &ended) && !ended)
+    {
+        int frame_size = decoder->gif.w * decoder->gif.h * 4;
+
+        decoder->previous[0] = RF_ALLOC(decoder->allocator, frame_size * 2);
+
+        if (decoder->previous[0])
+        {
+            decoder->previous[1] = decoder->previous[0] + frame_size;
+
+            result = (rf_gif_player)
+            {
+                .frame = (rf_image)
+                {
+                    .data   = decoder->gif.out,
+                    .width  = decoder->gif.w,
+                    .height = decoder->gif.h,
+                    .format = RF_UNCOMPRESSED_R8G8B8A8,
+                    .valid  = true,
+                },
+                .frame_delay = decoder->gif.delay > 10 ? decoder->gif.delay : RF_GIF_DEFAULT_FRAME_DELAY,
+                .valid       = true,
+                .decoder     = decoder,
+            };
+        }
+        else RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed", frame_size * 2);
+    }
+    else RF_LOG_ERROR(RF_STBI_FAILED, "Gif could not be loaded. STB Image returned: %s", stbi_failure_reason());
+
+    if (!result.valid)
+    {
+        rf_unload_gif_player(&(rf_gif_player) { .decoder = decoder });
+    }
+
+    return result;
+}
+
+RF_API rf_gif_player rf_load_gif_player(const void* data, rf_int data_size, rf_allocator allocator)
+{
+    if (!data || data_size <= 0)
+    {
+        RF_LOG_ERROR(RF_BAD_ARGUMENT, "Argument `data` was null.");
+        return (rf_gif_player) {0};
+    }
+
+    struct rf_gif_decoder* decoder = RF_ALLOC(allocator, sizeof(struct rf_gif_decoder));
+
+    if (!decoder)
+    {
+        RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed", (int) sizeof(struct rf_gif_decoder));
+        return (rf_gif_player) {0};
+    }
+
+    memset(decoder, 0, sizeof(struct rf_gif_decoder));
+    decoder->data      = data;
+    decoder->data_size = data_size;
+    decoder->allocator = allocator;
+
+    return rf_gif_player_start(decoder);
+}
+
+RF_API rf_gif_player rf_load_gif_player_from_file(const char* filename, rf_allocator allocator, rf_io_callbacks io)
+{
+    struct rf_gif_decoder* decoder = RF_ALLOC(allocator, sizeof(struct rf_gif_decoder));
+
+    if (!decoder)
+    {
+        RF_LOG_ERROR(RF_BAD_ALLOC, "Allocation of size %d failed", (int) sizeof(struct rf_gif_decoder));
+        return (rf_gif_player) {0};
+    }
+
+    memset(decoder, 0, sizeof(struct rf_gif_decoder));
+    decoder->allocator = allocator;
+
+    if (RF_IO_SUPPORTS_STREAMING(io))
+    {
+        decoder->stream = (rf_stbi_stream) { io, RF_OPEN_FILE(io, filename), 0 };
+
+        if (!decoder->stream.file)
+        {
+            RF_LOG_ERROR(RF_BAD_IO, "Could not open file %s", filename);
+            RF_FREE(allocator, decoder);
+            return (rf_gif_player) {0};
+        }
+    }
+    else
+    {
+        rf_int file_size = RF_FILE_SIZE(io, filename);
+        decoder->owned_data = file_size > 0 ? RF_ALLOC(allocator, file_size) : NULL;
+
+        if (!decoder->owned_data || !RF_READ_FILE(io, filename, decoder->owned_data, file_size))
+        {
+            RF_LOG_ERROR(RF_BAD_IO, "Could not read file %s", filename);
+            RF_FREE(allocator, decoder->owned_data);
+            RF_FREE(allocator, decoder);
+            return (rf_gif_player) {0};
+        }
+
+        decoder->data      = decoder->owned_data;
+        decoder->data_size = file_size;
+    }
+
+    return rf_gif_player_start(decoder);
+}
+
+RF_API bool rf_gif_player_next_frame(rf_gif_player* player)
+{
+    if (!player || !player->valid) return false;
+
+    struct rf_gif_decoder* decoder = player->decoder;
+    int frame_size = decoder->gif.w * decoder->gif.h * 4;
+
+    // Keep the current frame, the frame after the next one may be disposed back to it
+    unsigned char* two_back = player->frame_index > 0 ? decoder->previous[(player->frame_index - 1) & 1] : NULL;
+    memcpy(decoder->previous[player->frame_index & 1], decoder->gif.out, frame_size);
+
+    bool ended = false;
+    bool success = rf_gif_decoder_load_next(decoder, two_back, &ended);
+
+    if (success && ended)
+    {
+        success = rf_gif_decoder_start(decoder) && rf_gif_decoder_load_next(decoder, NULL, &ended) && !ended;
+        player->frame_index = -1;
+    }
+
+    if (!success || decoder->gif.w != player->frame.width || decoder->gif.h != player->frame.height)
+    {
+        RF_LOG_ERROR(RF_STBI_FAILED, "Gif frame could not be decoded. STB Image returned: %s", stbi_failure_reason());
+        player->valid = false;
+        return false;
+    }
+
+    player->frame.data  = decoder->gif.out;
+    player->frame_index++;
+    player->frame_delay = decoder->gif.delay > 10 ? decoder->gif.delay : RF_GIF_DEFAULT_FRAME_DELAY;
+
+    return true;
+}
+
+RF_API bool rf_gif_player_update(rf_gif_player* player, float delta_time)
+{
+    bool changed = false;
+
+    if (player && player->valid)
+    {
+        player->frame_time += delta_time;
+
+        // Frames have to be decoded in order since each one is drawn over the previous ones
+        while (player->valid && player->frame_time * 1000.0f >= player->frame_delay)
+        {
+            player->frame_time -= player->frame_delay / 1000.0f;
+            changed |= rf_gif_player_next_frame(player);
+        }
+    }
+
+    return changed;
+}
+
+RF_API void rf_unload_gif_player(rf_gif_player* player)
+{
+    if (player && player->decoder)
+    {
+        struct rf_gif_decoder* decoder = player->decoder;
+        rf_allocator allocator = decoder->allocator;
+
+        rf_gif_decoder_free_frames(decoder);
+
+        if (decoder->stream.file) RF_CLOSE_FILE(decoder->stream.io, decoder->stream.file);
+
+        RF_FREE(allocator, decoder->previous[0]);
+        RF_FREE(allocator, decoder->owned_data);
+        RF_FREE(allocator, decoder);
+
+        *player = (rf_gif_player) {0};
+    }
+}
+
+#pragma endregion
+
 #pragma endregion
 /*** End of inlined file: rayfork-image.c ***/
 
@@ -18206,6 +23565,24 @@ RF_API rf_texture2d rf_load_texture_from_image_with_mipmaps(rf_mipmaps_image ima
     return result;
 }
 
+// Compress an image on the cpu and load it as a compressed texture, falls back to the uncompressed image when the gpu doesn't support the format
+RF_API rf_texture2d rf_load_compressed_texture_from_image(rf_image image, rf_compressed_pixel_format format, rf_allocator temp_allocator)
+{
+    // NOTE: A format whose extension is missing still comes back valid, only without an internal format
+    rf_gfx_pixel_format gfx_format = rf_gfx_get_internal_texture_formats(format);
+    if (!gfx_format.valid || !gfx_format.internal_format)
+    {
+        RF_LOG(RF_LOG_TYPE_WARNING, "Compressed texture format %d not supported, loading the texture uncompressed", format);
+        return rf_load_texture_from_image(image);
+    }
+
+    rf_image compressed = rf_image_compress(image, format, temp_allocator, temp_allocator);
+    rf_texture2d result = rf_load_texture_from_image(compressed.valid ? compressed : image);
+    rf_unload_image(compressed, temp_allocator);
+
+    return result;
+}
+
 // Load cubemap from image, multiple image cubemap layouts supported
 RF_API rf_texture_cubemap rf_load_texture_cubemap_from_image(rf_image image, rf_cubemap_layout_type layout_type, rf_allocator temp_allocator)
 {
@@ -18307,6 +23684,57 @@ RF_API void rf_update_texture(rf_texture2d texture, const void* pixels, rf_int p
     rf_gfx_update_texture(texture.id, texture.width, texture.height, texture.format, pixels, pixels_size);
 }
 
+// Update a region of a GPU texture, the region is clipped to the texture. Pixels data must match texture.format
+RF_API void rf_update_texture_rec(rf_texture2d texture, rf_rec rec, const void* pixels, rf_int pixels_size)
+{
+    int x = (int) rec.x;
+    int y = (int) rec.y;
+    int width = (int) rec.width;
+    int height = (int) rec.height;
+    int bpp = rf_bytes_per_pixel(texture.format);
+
+    if (width <= 0 || height <= 0) return;
+
+    // Pixels always holds the whole region, even when only a part of it is inside of the texture
+    if (!pixels || width * height * bpp > pixels_size)
+    {
+        RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expected a size of at least %d.", pixels_size, width * height * bpp);
+        return;
+    }
+
+    int left   = rf_max_i(x, 0);
+    int top    = rf_max_i(y, 0);
+    int right  = rf_min_i(x + width, texture.width);
+    int bottom = rf_min_i(y + height, texture.height);
+
+    if (left >= right || top >= bottom) return;
+
+    const unsigned char* src = (const unsigned char*) pixels + ((top - y) * width + (left - x)) * bpp;
+    int stride = width * bpp;
+
+    if (right - left == width)
+    {
+        rf_gfx_update_texture_rec(texture.id, left, top, width, bottom - top, texture.format, src, (bottom - top) * stride);
+    }
+    else
+    {
+        // The clipped rows are not contiguous in pixels so they are uploaded one at a time
+        for (int row = top; row < bottom; row++, src += stride)
+        {
+            rf_gfx_update_texture_rec(texture.id, left, row, right - left, 1, texture.format, src, (right - left) * bpp);
+        }
+    }
+}
+
+// Upload the current frame of a gif player without going through an intermediate image
+RF_API void rf_update_texture_from_gif_player(rf_texture2d texture, const rf_gif_player* player)
+{
+    if (player && player->valid)
+    {
+        rf_update_texture(texture, player->frame.data, rf_image_size(player->frame));
+    }
+}
+
 // Generate GPU mipmaps for a texture
 RF_API void rf_gen_texture_mipmaps(rf_texture2d* texture)
 {
@@ -37872,6 +43300,7 @@ RF_API rf_image rf_get_screen_data_ez()
     return result;
 }
 RF_API rf_base64_output rf_decode_base64_ez(const unsigned char* input) { return rf_decode_base64(input, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_spatial_grid rf_load_spatial_grid_ez(rf_rec bounds, float cell_size, int capacity) { return rf_load_spatial_grid(bounds, cell_size, capacity, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_image rf_gfx_read_texture_pixels_ez(rf_texture2d texture) { return rf_gfx_read_texture_pixels(texture, RF_DEFAULT_ALLOCATOR); }
 
 #pragma endregion
@@ -37881,7 +43310,9 @@ RF_API rf_image rf_gfx_read_texture_pixels_ez(rf_texture2d texture) { return rf_
 #pragma region extract image data functions
 RF_API rf_color* rf_image_pixels_to_rgba32_ez(rf_image image) { return rf_image_pixels_to_rgba32(image, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_vec4* rf_image_compute_pixels_to_normalized_ez(rf_image image) { return rf_image_compute_pixels_to_normalized(image, RF_DEFAULT_ALLOCATOR); }
-RF_API rf_palette rf_image_extract_palette_ez(rf_image image, int palette_size) { return rf_image_extract_palette(image, palette_size, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_palette rf_image_extract_palette_ez(rf_image image, int palette_size) { return rf_image_extract_palette(image, palette_size, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_palette rf_image_gen_palette_ez(rf_image image, int palette_size) { return rf_image_gen_palette(image, palette_size, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_image rf_image_quantize_ez(rf_image image, rf_palette palette, bool dither) { return rf_image_quantize(image, palette, dither, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
 #pragma endregion
 
 #pragma region loading & unloading functions
@@ -37905,9 +43336,14 @@ RF_API rf_image rf_image_alpha_clear_ez(rf_image image, rf_color color, float th
 RF_API rf_image rf_image_alpha_premultiply_ez(rf_image image) { return rf_image_alpha_premultiply(image, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_image rf_image_alpha_crop_ez(rf_image image, float threshold) { return rf_image_alpha_crop(image, threshold, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_image rf_image_dither_ez(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp) { return rf_image_dither(image, r_bpp, g_bpp, b_bpp, a_bpp, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_image rf_image_dither_ordered_ez(rf_image image, int r_bpp, int g_bpp, int b_bpp, int a_bpp) { return rf_image_dither_ordered(image, r_bpp, g_bpp, b_bpp, a_bpp, RF_DEFAULT_ALLOCATOR); }
 
 RF_API rf_image rf_image_flip_vertical_ez(rf_image image) { return rf_image_flip_vertical(image, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_image rf_image_flip_horizontal_ez(rf_image image) { return rf_image_flip_horizontal(image, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_image rf_image_rotate_cw_ez(rf_image image) { return rf_image_rotate_cw(image, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_image rf_image_rotate_ccw_ez(rf_image image) { return rf_image_rotate_ccw(image, RF_DEFAULT_ALLOCATOR); }
+
+RF_API rf_image rf_image_pipeline_execute_ez(const rf_image_pipeline* pipeline) { return rf_image_pipeline_execute(pipeline, RF_DEFAULT_ALLOCATOR); }
 
 RF_API rf_vec2 rf_get_seed_for_cellular_image_ez(int seeds_per_row, int tile_size, int i) { return rf_get_seed_for_cellular_image(
         seeds_per_row, tile_size, i, RF_DEFAULT_RAND_PROC); }
@@ -37929,9 +43365,19 @@ RF_API rf_image rf_gen_image_cellular_ez(int width, int height, int tile_size) {
 
 #pragma region mipmaps
 RF_API rf_mipmaps_image rf_image_gen_mipmaps_ez(rf_image image, int gen_mipmaps_count) { return rf_image_gen_mipmaps(image, gen_mipmaps_count, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_mipmaps_image rf_image_gen_srgb_mipmaps_ez(rf_image image, int gen_mipmaps_count) { return rf_image_gen_srgb_mipmaps(image, gen_mipmaps_count, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
 RF_API void rf_unload_mipmaps_image_ez(rf_mipmaps_image image) { rf_unload_mipmaps_image(image, RF_DEFAULT_ALLOCATOR); }
 #pragma endregion
 
+#pragma region block compression
+RF_API rf_image rf_image_compress_ez(rf_image image, rf_compressed_pixel_format dst_format) { return rf_image_compress(image, dst_format, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
+#pragma endregion
+
+#pragma region collision mask
+RF_API rf_collision_mask rf_collision_mask_from_image_ez(rf_image image, float threshold) { return rf_collision_mask_from_image(image, threshold, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
+RF_API void rf_unload_collision_mask_ez(rf_collision_mask mask) { rf_unload_collision_mask(mask, RF_DEFAULT_ALLOCATOR); }
+#pragma endregion
+
 #pragma region dds
 RF_API rf_mipmaps_image rf_load_dds_image_ez(const void* src, int src_size) { return rf_load_dds_image(src, src_size, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_mipmaps_image rf_load_dds_image_from_file_ez(const char* file) { return rf_load_dds_image_from_file(file, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_IO); }
@@ -37953,12 +43399,15 @@ RF_API rf_mipmaps_image rf_load_ktx_image_from_file_ez(const char* file) { retur
 RF_API rf_gif rf_load_animated_gif_ez(const void* data, int data_size) { return rf_load_animated_gif(data, data_size, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_gif rf_load_animated_gif_file_ez(const char* filename) { return rf_load_animated_gif_file(filename, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_IO); }
 RF_API void rf_unload_gif_ez(rf_gif gif) { rf_unload_gif(gif, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_gif_player rf_load_gif_player_ez(const void* data, int data_size) { return rf_load_gif_player(data, data_size, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_gif_player rf_load_gif_player_from_file_ez(const char* filename) { return rf_load_gif_player_from_file(filename, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_IO); }
 #pragma endregion
 
 #pragma region texture
 RF_API rf_texture2d rf_load_texture_from_file_ez(const char* filename) { return rf_load_texture_from_file(filename, RF_DEFAULT_ALLOCATOR, RF_DEFAULT_IO); }
 RF_API rf_texture2d rf_load_texture_from_file_data_ez(const void* dst, int dst_size) { return rf_load_texture_from_file_data(dst, dst_size, RF_DEFAULT_ALLOCATOR); }
 RF_API rf_texture_cubemap rf_load_texture_cubemap_from_image_ez(rf_image image, rf_cubemap_layout_type layout_type) { return rf_load_texture_cubemap_from_image(image, layout_type, RF_DEFAULT_ALLOCATOR); }
+RF_API rf_texture2d rf_load_compressed_texture_from_image_ez(rf_image image, rf_compressed_pixel_format format) { return rf_load_compressed_texture_from_image(image, format, RF_DEFAULT_ALLOCATOR); }
 #pragma endregion
 
 #pragma region font
@@ -40673,7 +46122,17 @@ RF_API unsigned int rf_gfx_load_texture_cubemap(void* data, int size, rf_pixel_f
 // NOTE: We don't know safely if internal texture format is the expected one...
 RF_API void rf_gfx_update_texture(unsigned int id, int width, int height, rf_pixel_format format, const void* pixels, int pixels_size)
 {
-    if (width * height * rf_bytes_per_pixel(format) <= pixels_size) return;
+    rf_gfx_update_texture_rec(id, 0, 0, width, height, format, pixels, pixels_size);
+}
+
+// Update a region of an already loaded texture, pixels holds only the rows of the region
+RF_API void rf_gfx_update_texture_rec(unsigned int id, int x, int y, int width, int height, rf_pixel_format format, const void* pixels, int pixels_size)
+{
+    if (width * height * rf_bytes_per_pixel(format) > pixels_size)
+    {
+        RF_LOG_ERROR(RF_BAD_BUFFER_SIZE, "Buffer is size %d but function expected a size of at least %d.", pixels_size, width * height * rf_bytes_per_pixel(format));
+        return;
+    }
 
     rf_gl.BindTexture(GL_TEXTURE_2D, id);
 
@@ -40681,9 +46140,11 @@ RF_API void rf_gfx_update_texture(unsigned int id, int width, int height, rf_pix
 
     if (gfx_format.valid && rf_is_uncompressed_format(format))
     {
-        rf_gl.TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, gfx_format.internal_format, gfx_format.type, (unsigned char*) pixels);
+        rf_gl.TexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, gfx_format.format, gfx_format.type, (unsigned char*) pixels);
     }
     else RF_LOG(RF_LOG_TYPE_WARNING, "rf_texture format updating not supported");
+
+    rf_gl.BindTexture(GL_TEXTURE_2D, 0);
 }
 
 // Get OpenGL internal formats and data type from raylib rf_pixel_format
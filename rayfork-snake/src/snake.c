@@ -16,8 +16,10 @@
 //----------------------------------------------------------------------------------
 // Some Defines
 //----------------------------------------------------------------------------------
-#define SNAKE_LENGTH   256
-#define SQUARE_SIZE     31
+#define MAX_GRID_COLUMNS    64      // The grid is clamped to this size on big windows
+#define MAX_GRID_ROWS       36
+#define SNAKE_LENGTH        (MAX_GRID_COLUMNS*MAX_GRID_ROWS)    // Enough to cover the whole grid
+#define SQUARE_SIZE         31
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -44,12 +46,20 @@ static bool gameOver = false;
 static bool pause = false;
 
 static Food fruit = { 0 };
-static Snake snake[SNAKE_LENGTH] = { 0 };
-static rf_vec2 snakePosition[SNAKE_LENGTH] = { 0 };
+static Snake snake[SNAKE_LENGTH] = { 0 };   // Ring buffer, the head is at snakeHead and the tail follows it
+static int snakeHead = 0;
 static bool allowMove = false;
 static rf_vec2 offset = { 0 };
 static int counterTail = 0;
 
+// Grid cells are numbered row by row
+static int gridColumns = 0;
+static int gridRows = 0;
+static uint32_t snakeCells[(SNAKE_LENGTH + 31)/32] = { 0 };   // Bit set for every cell covered by the snake
+static int freeCells[SNAKE_LENGTH] = { 0 };                     // Cells not covered by the snake, in any order
+static int freeCellSlots[SNAKE_LENGTH] = { 0 };                 // Index of every free cell in freeCells
+static int freeCellsCount = 0;
+
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
 //------------------------------------------------------------------------------------
@@ -59,6 +69,12 @@ static void DrawGame(void);                                      // Draw game (o
 static void UnloadGame(void);                                    // Unload game
 static void UpdateDrawFrame(const platform_input_state* input);  // Update and Draw (one frame)
 
+// Additional module functions
+static int GetCell(rf_vec2 position);
+static rf_vec2 GetCellPosition(int cell);
+static void OccupyCell(int cell);
+static void FreeCell(int cell);
+
 // Returns a random value between min and max (both included)
 int GetRandomValue(int min, int max)
 {
@@ -118,10 +134,18 @@ void InitGame(void)
     pause = false;
 
     counterTail = 1;
+    snakeHead = 0;
     allowMove = false;
 
-    offset.x = window.width % SQUARE_SIZE;
-    offset.y = window.height % SQUARE_SIZE;
+    // The grid is sized from the window once per game, the window may be resized while playing
+    gridColumns = window.width / SQUARE_SIZE;
+    gridRows = window.height / SQUARE_SIZE;
+
+    if (gridColumns > MAX_GRID_COLUMNS) gridColumns = MAX_GRID_COLUMNS;
+    if (gridRows > MAX_GRID_ROWS) gridRows = MAX_GRID_ROWS;
+
+    offset.x = window.width - gridColumns*SQUARE_SIZE;
+    offset.y = window.height - gridRows*SQUARE_SIZE;
 
     for (int i = 0; i < SNAKE_LENGTH; i++)
     {
@@ -133,11 +157,18 @@ void InitGame(void)
         else snake[i].color = RF_BLUE;
     }
 
-    for (int i = 0; i < SNAKE_LENGTH; i++)
+    // All cells start free but the one under the head
+    memset(snakeCells, 0, sizeof(snakeCells));
+
+    freeCellsCount = gridColumns*gridRows;
+    for (int i = 0; i < freeCellsCount; i++)
     {
-        snakePosition[i] = (rf_vec2){ 0.0f, 0.0f };
+        freeCells[i] = i;
+        freeCellSlots[i] = i;
     }
 
+    OccupyCell(GetCell(snake[snakeHead].position));
+
     fruit.size = (rf_vec2){ SQUARE_SIZE, SQUARE_SIZE };
     fruit.color = RF_SKYBLUE;
     fruit.active = false;
@@ -153,79 +184,86 @@ void UpdateGame(const platform_input_state* input)
         if (!pause)
         {
             // Player control
-            if (input->keys[KEYCODE_RIGHT] == KEY_PRESSED_DOWN && (snake[0].speed.x == 0) && allowMove)
+            if (input->keys[KEYCODE_RIGHT] == KEY_PRESSED_DOWN && (snake[snakeHead].speed.x == 0) && allowMove)
             {
-                snake[0].speed = (rf_vec2){ SQUARE_SIZE, 0 };
+                snake[snakeHead].speed = (rf_vec2){ SQUARE_SIZE, 0 };
                 allowMove = false;
             }
-            if (input->keys[KEYCODE_LEFT] == KEY_PRESSED_DOWN && (snake[0].speed.x == 0) && allowMove)
+            if (input->keys[KEYCODE_LEFT] == KEY_PRESSED_DOWN && (snake[snakeHead].speed.x == 0) && allowMove)
             {
-                snake[0].speed = (rf_vec2){ -SQUARE_SIZE, 0 };
+                snake[snakeHead].speed = (rf_vec2){ -SQUARE_SIZE, 0 };
                 allowMove = false;
             }
-            if (input->keys[KEYCODE_UP] == KEY_PRESSED_DOWN && (snake[0].speed.y == 0) && allowMove)
+            if (input->keys[KEYCODE_UP] == KEY_PRESSED_DOWN && (snake[snakeHead].speed.y == 0) && allowMove)
             {
-                snake[0].speed = (rf_vec2){ 0, -SQUARE_SIZE };
+                snake[snakeHead].speed = (rf_vec2){ 0, -SQUARE_SIZE };
                 allowMove = false;
             }
-            if (input->keys[KEYCODE_DOWN] == KEY_PRESSED_DOWN && (snake[0].speed.y == 0) && allowMove)
+            if (input->keys[KEYCODE_DOWN] == KEY_PRESSED_DOWN && (snake[snakeHead].speed.y == 0) && allowMove)
             {
-                snake[0].speed = (rf_vec2){ 0, SQUARE_SIZE };
+                snake[snakeHead].speed = (rf_vec2){ 0, SQUARE_SIZE };
                 allowMove = false;
             }
 
             // Snake movement
-            for (int i = 0; i < counterTail; i++) snakePosition[i] = snake[i].position;
+            bool moved = false;
 
             if ((framesCounter % 5) == 0)
             {
-                for (int i = 0; i < counterTail; i++)
-                {
-                    if (i == 0)
-                    {
-                        snake[0].position.x += snake[0].speed.x;
-                        snake[0].position.y += snake[0].speed.y;
-                        allowMove = true;
-                    }
-                    else snake[i].position = snakePosition[i - 1];
-                }
+                // The body stays in place, the head takes the slot before it and the tail slot is left behind
+                int headSlot = (snakeHead + SNAKE_LENGTH - 1) % SNAKE_LENGTH;
+                int tailSlot = (snakeHead + counterTail - 1) % SNAKE_LENGTH;
+
+                FreeCell(GetCell(snake[tailSlot].position));
+
+                snake[headSlot] = snake[snakeHead];
+                snake[headSlot].position.x += snake[headSlot].speed.x;
+                snake[headSlot].position.y += snake[headSlot].speed.y;
+                snake[snakeHead].color = RF_BLUE;
+
+                snakeHead = headSlot;
+                allowMove = true;
+                moved = true;
             }
 
             // Wall behaviour
-            if (((snake[0].position.x) > (window.width - offset.x)) ||
-                ((snake[0].position.y) > (window.height - offset.y)) ||
-                (snake[0].position.x < 0) || (snake[0].position.y < 0))
+            Snake* head = &snake[snakeHead];
+
+            if ((head->position.x < offset.x / 2) || (head->position.x >= offset.x / 2 + gridColumns*SQUARE_SIZE) ||
+                (head->position.y < offset.y / 2) || (head->position.y >= offset.y / 2 + gridRows*SQUARE_SIZE))
             {
                 gameOver = true;
             }
-
-            // Collision with yourself
-            for (int i = 1; i < counterTail; i++)
+            else if (moved)
             {
-                if ((snake[0].position.x == snake[i].position.x) && (snake[0].position.y == snake[i].position.y)) gameOver = true;
+                // Collision with yourself
+                int cell = GetCell(head->position);
+
+                if (snakeCells[cell/32] & (1u << (cell%32))) gameOver = true;
+                else OccupyCell(cell);
             }
 
             // Fruit position calculation
             if (!fruit.active)
             {
-                fruit.active = true;
-                fruit.position = (rf_vec2){ GetRandomValue(0, (window.width / SQUARE_SIZE) - 1) * SQUARE_SIZE + offset.x / 2, GetRandomValue(0, (window.height / SQUARE_SIZE) - 1) * SQUARE_SIZE + offset.y / 2 };
-
-                for (int i = 0; i < counterTail; i++)
+                // Pick any of the cells the snake doesn't cover, if there are none the snake fills the grid
+                if (freeCellsCount > 0)
                 {
-                    while ((fruit.position.x == snake[i].position.x) && (fruit.position.y == snake[i].position.y))
-                    {
-                        fruit.position = (rf_vec2){ GetRandomValue(0, (window.width / SQUARE_SIZE) - 1) * SQUARE_SIZE + offset.x / 2, GetRandomValue(0, (window.height / SQUARE_SIZE) - 1) * SQUARE_SIZE + offset.y / 2 };
-                        i = 0;
-                    }
+                    fruit.active = true;
+                    fruit.position = GetCellPosition(freeCells[GetRandomValue(0, freeCellsCount - 1)]);
                 }
+                else gameOver = true;
             }
 
             // Collision
-            if ((snake[0].position.x < (fruit.position.x + fruit.size.x) && (snake[0].position.x + snake[0].size.x) > fruit.position.x) &&
-                (snake[0].position.y < (fruit.position.y + fruit.size.y) && (snake[0].position.y + snake[0].size.y) > fruit.position.y))
+            if (fruit.active &&
+                (head->position.x < (fruit.position.x + fruit.size.x) && (head->position.x + head->size.x) > fruit.position.x) &&
+                (head->position.y < (fruit.position.y + fruit.size.y) && (head->position.y + head->size.y) > fruit.position.y))
             {
-                snake[counterTail].position = snakePosition[counterTail - 1];
+                // Grow back into the slot and cell the tail just left
+                int tailSlot = (snakeHead + counterTail) % SNAKE_LENGTH;
+
+                OccupyCell(GetCell(snake[tailSlot].position));
                 counterTail += 1;
                 fruit.active = false;
             }
@@ -253,18 +291,22 @@ void DrawGame()
         if (!gameOver)
         {
             // Draw grid lines
-            for (int i = 0; i < window.width / SQUARE_SIZE + 1; i++)
+            for (int i = 0; i < gridColumns + 1; i++)
             {
-                rf_draw_line_v((rf_vec2) { SQUARE_SIZE* i + offset.x / 2, offset.y / 2 }, (rf_vec2) { SQUARE_SIZE* i + offset.x / 2, window.height - offset.y / 2 }, RF_LIGHTGRAY);
+                rf_draw_line_v((rf_vec2) { SQUARE_SIZE* i + offset.x / 2, offset.y / 2 }, (rf_vec2) { SQUARE_SIZE* i + offset.x / 2, gridRows*SQUARE_SIZE + offset.y / 2 }, RF_LIGHTGRAY);
             }
 
-            for (int i = 0; i < window.width / SQUARE_SIZE + 1; i++)
+            for (int i = 0; i < gridRows + 1; i++)
             {
-                rf_draw_line_v((rf_vec2) { offset.x / 2, SQUARE_SIZE* i + offset.y / 2 }, (rf_vec2) { window.width - offset.x / 2, SQUARE_SIZE* i + offset.y / 2 }, RF_LIGHTGRAY);
+                rf_draw_line_v((rf_vec2) { offset.x / 2, SQUARE_SIZE* i + offset.y / 2 }, (rf_vec2) { gridColumns*SQUARE_SIZE + offset.x / 2, SQUARE_SIZE* i + offset.y / 2 }, RF_LIGHTGRAY);
             }
 
             // Draw snake
-            for (int i = 0; i < counterTail; i++) rf_draw_rectangle_v(snake[i].position, snake[i].size, snake[i].color);
+            for (int i = 0; i < counterTail; i++)
+            {
+                Snake* segment = &snake[(snakeHead + i) % SNAKE_LENGTH];
+                rf_draw_rectangle_v(segment->position, segment->size, segment->color);
+            }
 
             // Draw fruit to pick
             rf_draw_rectangle_v(fruit.position, fruit.size, fruit.color);
@@ -287,4 +329,47 @@ void UpdateDrawFrame(const platform_input_state* input)
 {
     UpdateGame(input);
     DrawGame();
+}
+
+//------------------------------------------------------------------------------------
+// Additional module functions
+//------------------------------------------------------------------------------------
+
+// Get the grid cell of a position aligned to the grid
+static int GetCell(rf_vec2 position)
+{
+    int x = (int)((position.x - offset.x / 2) / SQUARE_SIZE);
+    int y = (int)((position.y - offset.y / 2) / SQUARE_SIZE);
+
+    return y*gridColumns + x;
+}
+
+static rf_vec2 GetCellPosition(int cell)
+{
+    return (rf_vec2){ (cell%gridColumns) * SQUARE_SIZE + offset.x / 2, (cell/gridColumns) * SQUARE_SIZE + offset.y / 2 };
+}
+
+// Mark a cell as covered by the snake, swapping it out of the free cells list
+static void OccupyCell(int cell)
+{
+    if (snakeCells[cell/32] & (1u << (cell%32))) return;
+
+    snakeCells[cell/32] |= 1u << (cell%32);
+
+    int slot = freeCellSlots[cell];
+    int last = freeCells[--freeCellsCount];
+
+    freeCells[slot] = last;
+    freeCellSlots[last] = slot;
+}
+
+// Mark a cell as left by the snake, appending it to the free cells list
+static void FreeCell(int cell)
+{
+    if (!(snakeCells[cell/32] & (1u << (cell%32)))) return;
+
+    snakeCells[cell/32] &= ~(1u << (cell%32));
+
+    freeCells[freeCellsCount] = cell;
+    freeCellSlots[cell] = freeCellsCount++;
 }
\ No newline at end of file
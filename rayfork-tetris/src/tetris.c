@@ -27,26 +27,87 @@
 
 #define FADING_TIME             33
 
+#define PIECE_TYPES             7
+
+// Every grid row is a bitmask with column x stored at bit x + GRID_ROW_OFFSET, so a piece matrix
+// hanging past the left wall is never shifted by a negative amount. Bits outside of the grid are always set
+#define GRID_ROW_OFFSET         2
+#define GRID_ROW_INSIDE         (((1 << (GRID_HORIZONTAL_SIZE - 2)) - 1) << (GRID_ROW_OFFSET + 1))
+#define GRID_ROW_EMPTY          (0xFFFF & ~GRID_ROW_INSIDE)
+#define GRID_ROW_BLOCK          0xFFFF
+
+// Autoplayer tries every rotation at every column a piece matrix can take, from -1 to GRID_HORIZONTAL_SIZE - 3
+#define AUTOPLAY_COLUMNS        (GRID_HORIZONTAL_SIZE - 1)
+#define AUTOPLAY_PLACEMENTS     (4*AUTOPLAY_COLUMNS)
+#define AUTOPLAY_TOP_OUT_SCORE  -1000000.0f
+
+#define SOAK_FRAME_TIME         0.014   // Seconds of placements simulated every frame on soak mode
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 typedef enum GridSquare { EMPTY, MOVING, FULL, BLOCK, FADING } GridSquare;
 
+typedef struct Placement {
+    int rotation;
+    int x;
+    float score;
+} Placement;
+
+// Every job scores one placement of the current piece followed by the best placement of the incoming one
+typedef struct PlacementSearch {
+    const uint16_t* rows;
+    int type;
+    int nextType;
+    float scores[AUTOPLAY_PLACEMENTS];
+    bool valid[AUTOPLAY_PLACEMENTS];
+} PlacementSearch;
+
 //------------------------------------------------------------------------------------
 // Global Variables Declaration
 //------------------------------------------------------------------------------------
 static bool gameOver = false;
 static bool pause = false;
 
-// Matrices
-static GridSquare grid[GRID_HORIZONTAL_SIZE][GRID_VERTICAL_SIZE];
-static GridSquare piece[4][4];
-static GridSquare incomingPiece[4][4];
+// Pieces squares in their spawn rotation, as { x, y } inside the 4x4 piece matrix
+static const int pieceShapes[PIECE_TYPES][4][2] = {
+    { { 1, 1 }, { 2, 1 }, { 1, 2 }, { 2, 2 } },     // Cube
+    { { 1, 0 }, { 1, 1 }, { 1, 2 }, { 2, 2 } },     // L
+    { { 1, 2 }, { 2, 0 }, { 2, 1 }, { 2, 2 } },     // L inversa
+    { { 0, 1 }, { 1, 1 }, { 2, 1 }, { 3, 1 } },     // Recta
+    { { 1, 0 }, { 1, 1 }, { 1, 2 }, { 2, 1 } },     // Creu tallada
+    { { 1, 1 }, { 2, 1 }, { 2, 2 }, { 3, 2 } },     // S
+    { { 1, 2 }, { 2, 2 }, { 2, 1 }, { 3, 1 } },     // S inversa
+};
+
+// Bitmasks
+static uint16_t gridRows[GRID_VERTICAL_SIZE];           // Settled squares, walls and floor of every row
+static uint32_t fadingLines = 0;                        // Bit j is set while row j is being deleted
+static uint16_t pieceMasks[PIECE_TYPES][4][4];          // Rows of every piece matrix for each rotation
+
+// Active and incoming pieces
+static int pieceType = 0;
+static int pieceRotation = 0;
+static int incomingPieceType = 0;
 
 // Theese variables keep track of the active piece position
 static int piecePositionX = 0;
 static int piecePositionY = 0;
 
+// Autoplayer
+static bool autoplay = false;
+static bool soak = false;
+
+// Soak mode plays its own headless board as fast as possible
+static uint16_t soakRows[GRID_VERTICAL_SIZE];
+static int soakType = 0;
+static int soakNextType = 0;
+static long soakPlacements = 0;
+static long soakLines = 0;
+static long soakGames = 0;
+static double soakTime = 0;
+static int soakThreads = 1;     // Threads the placement search runs on, the speed is also shown per thread
+
 // Game parameters
 static rf_color fadingColor;
 //static int fallingSpeed;           // In frames
@@ -89,6 +150,19 @@ static bool ResolveTurnMovement(const platform_input_state* input);
 static void CheckDetection();
 static void CheckCompletion();
 static void DeleteCompleteLines();
+static void InitPieceMasks(void);
+static bool CheckPieceCollision(const uint16_t* rows, int type, int rotation, int x, int y);
+static GridSquare GetGridSquare(int x, int y);
+static int CountBits(unsigned int bits);
+static int DropPiece(const uint16_t* rows, int type, int rotation, int x);
+static int PlacePiece(uint16_t* rows, int type, int rotation, int x, int y);
+static float EvaluateBoard(const uint16_t* rows, int clearedLines);
+static void EvaluatePlacementJob(void* data, rf_int index);
+static bool SearchPlacement(const uint16_t* rows, int type, int nextType, Placement* best);
+static void ResolveAutoplayMovement(void);
+static int GetSearchThreads(void);
+static void InitSoak(void);
+static void UpdateSoak(void);
 
 // Formatting of text with variables to 'embed'
 // WARNING: String returned will expire after this function is called MAX_TEXTFORMAT_BUFFERS times
@@ -156,6 +230,9 @@ extern void game_init(rf_gfx_backend_data* gfx_data)
     batch = rf_create_default_render_batch(RF_DEFAULT_ALLOCATOR);
     rf_set_active_render_batch(&batch);
 
+    // Soak mode measures placements per second
+    stm_setup();
+
     InitGame();
 }
 
@@ -196,32 +273,34 @@ void InitGame(void)
     fadeLineCounter = 0;
     gravitySpeed = 30;
 
-    // Initialize grid matrices
-    for (int i = 0; i < GRID_HORIZONTAL_SIZE; i++)
-    {
-        for (int j = 0; j < GRID_VERTICAL_SIZE; j++)
-        {
-            if ((j == GRID_VERTICAL_SIZE - 1) || (i == 0) || (i == GRID_HORIZONTAL_SIZE - 1)) grid[i][j] = BLOCK;
-            else grid[i][j] = EMPTY;
-        }
-    }
+    // Initialize grid rows, the walls and the floor are always solid
+    for (int j = 0; j < GRID_VERTICAL_SIZE - 1; j++) gridRows[j] = GRID_ROW_EMPTY;
+    gridRows[GRID_VERTICAL_SIZE - 1] = GRID_ROW_BLOCK;
 
-    // Initialize incoming piece matrices
-    for (int i = 0; i < 4; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            incomingPiece[i][j] = EMPTY;
-        }
-    }
+    fadingLines = 0;
+
+    // Initialize pieces
+    InitPieceMasks();
+
+    pieceType = 0;
+    pieceRotation = 0;
+    incomingPieceType = 0;
 }
 
 // Update game (one frame)
 void UpdateGame(const platform_input_state* input)
 {
-    if (!gameOver)
+    if (input->keys[KEYCODE_S] == KEY_PRESSED_DOWN)
+    {
+        soak = !soak;
+        if (soak) InitSoak();
+    }
+
+    if (soak) UpdateSoak();
+    else if (!gameOver)
     {
         if (input->keys[KEYCODE_P] == KEY_PRESSED_DOWN) pause = !pause;
+        if (input->keys[KEYCODE_A] == KEY_PRESSED_DOWN) autoplay = !autoplay;
 
         if (!pause)
         {
@@ -232,6 +311,9 @@ void UpdateGame(const platform_input_state* input)
                     // Get another piece
                     pieceActive = Createpiece();
 
+                    // Let the autoplayer take the new piece to its best placement
+                    if (autoplay) ResolveAutoplayMovement();
+
                     // We leave a little time before starting the fast falling down
                     fastFallMovementCounter = 0;
                 }
@@ -248,7 +330,7 @@ void UpdateGame(const platform_input_state* input)
                     if (input->keys[KEYCODE_UP] == KEY_RELEASE) turnMovementCounter = TURNING_SPEED;
 
                     // Fall down
-                    if (input->keys[KEYCODE_DOWN] == KEY_HOLD_DOWN && (fastFallMovementCounter >= FAST_FALL_AWAIT_COUNTER))
+                    if ((input->keys[KEYCODE_DOWN] == KEY_HOLD_DOWN || autoplay) && (fastFallMovementCounter >= FAST_FALL_AWAIT_COUNTER))
                     {
                         // We make sure the piece is going to fall this frame
                         gravityMovementCounter += gravitySpeed;
@@ -286,13 +368,7 @@ void UpdateGame(const platform_input_state* input)
                 // Game over logic
                 for (int j = 0; j < 2; j++)
                 {
-                    for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
-                    {
-                        if (grid[i][j] == FULL)
-                        {
-                            gameOver = true;
-                        }
-                    }
+                    if (!(fadingLines & (1u << j)) && (gridRows[j] & GRID_ROW_INSIDE)) gameOver = true;
                 }
             }
             else
@@ -316,7 +392,7 @@ void UpdateGame(const platform_input_state* input)
     }
     else
     {
-        if (input->keys[KEYCODE_ENTER] == KEY_PRESSED_DOWN)
+        if (input->keys[KEYCODE_ENTER] == KEY_PRESSED_DOWN || autoplay)
         {
             InitGame();
             gameOver = false;
@@ -331,7 +407,20 @@ void DrawGame(void)
     {
         rf_clear(RF_RAYWHITE);
 
-        if (!gameOver)
+        if (soak)
+        {
+            int placementsPerSecond = (soakTime > 0)? (int)(soakPlacements/soakTime) : 0;
+            int placementsPerCore = placementsPerSecond/soakThreads;
+
+            rf_draw_text("AUTOPLAY SOAK", 20, 20, 40, RF_GRAY);
+            rf_draw_text(TextFormat("PLACEMENTS:   %li", soakPlacements), 20, 80, 20, RF_GRAY);
+            rf_draw_text(TextFormat("PLACEMENTS/S: %i", placementsPerSecond), 20, 110, 20, RF_GRAY);
+            rf_draw_text(TextFormat("PER CORE:     %i (%i THREADS)", placementsPerCore, soakThreads), 20, 140, 20, RF_GRAY);
+            rf_draw_text(TextFormat("LINES:        %li", soakLines), 20, 170, 20, RF_GRAY);
+            rf_draw_text(TextFormat("GAMES:        %li", soakGames), 20, 200, 20, RF_GRAY);
+            rf_draw_text("PRESS [S] TO STOP", 20, window.height - 40, 20, RF_GRAY);
+        }
+        else if (!gameOver)
         {
             // Draw gameplay area
             rf_vec2 offset;
@@ -346,8 +435,10 @@ void DrawGame(void)
             {
                 for (int i = 0; i < GRID_HORIZONTAL_SIZE; i++)
                 {
+                    GridSquare square = GetGridSquare(i, j);
+
                     // Draw each square of the grid
-                    if (grid[i][j] == EMPTY)
+                    if (square == EMPTY)
                     {
                         rf_draw_line(offset.x, offset.y, offset.x + SQUARE_SIZE, offset.y, RF_LIGHTGRAY);
                         rf_draw_line(offset.x, offset.y, offset.x, offset.y + SQUARE_SIZE, RF_LIGHTGRAY);
@@ -355,22 +446,22 @@ void DrawGame(void)
                         rf_draw_line(offset.x, offset.y + SQUARE_SIZE, offset.x + SQUARE_SIZE, offset.y + SQUARE_SIZE, RF_LIGHTGRAY);
                         offset.x += SQUARE_SIZE;
                     }
-                    else if (grid[i][j] == FULL)
+                    else if (square == FULL)
                     {
                         rf_draw_rectangle(offset.x, offset.y, SQUARE_SIZE, SQUARE_SIZE, RF_GRAY);
                         offset.x += SQUARE_SIZE;
                     }
-                    else if (grid[i][j] == MOVING)
+                    else if (square == MOVING)
                     {
                         rf_draw_rectangle(offset.x, offset.y, SQUARE_SIZE, SQUARE_SIZE, RF_DARKGRAY);
                         offset.x += SQUARE_SIZE;
                     }
-                    else if (grid[i][j] == BLOCK)
+                    else if (square == BLOCK)
                     {
                         rf_draw_rectangle(offset.x, offset.y, SQUARE_SIZE, SQUARE_SIZE, RF_LIGHTGRAY);
                         offset.x += SQUARE_SIZE;
                     }
-                    else if (grid[i][j] == FADING)
+                    else if (square == FADING)
                     {
                         rf_draw_rectangle(offset.x, offset.y, SQUARE_SIZE, SQUARE_SIZE, fadingColor);
                         offset.x += SQUARE_SIZE;
@@ -391,7 +482,10 @@ void DrawGame(void)
             {
                 for (int i = 0; i < 4; i++)
                 {
-                    if (incomingPiece[i][j] == EMPTY)
+                    // NOTE: There is no incoming piece until the first one is created
+                    bool incoming = !beginPlay && (pieceMasks[incomingPieceType][0][j] & (1 << i));
+
+                    if (!incoming)
                     {
                         rf_draw_line(offset.x, offset.y, offset.x + SQUARE_SIZE, offset.y, RF_LIGHTGRAY);
                         rf_draw_line(offset.x, offset.y, offset.x, offset.y + SQUARE_SIZE, RF_LIGHTGRAY);
@@ -399,7 +493,7 @@ void DrawGame(void)
                         rf_draw_line(offset.x, offset.y + SQUARE_SIZE, offset.x + SQUARE_SIZE, offset.y + SQUARE_SIZE, RF_LIGHTGRAY);
                         offset.x += SQUARE_SIZE;
                     }
-                    else if (incomingPiece[i][j] == MOVING)
+                    else
                     {
                         rf_draw_rectangle(offset.x, offset.y, SQUARE_SIZE, SQUARE_SIZE, RF_GRAY);
                         offset.x += SQUARE_SIZE;
@@ -412,6 +506,7 @@ void DrawGame(void)
 
             rf_draw_text("INCOMING:", offset.x, offset.y - 100, 10, RF_GRAY);
             rf_draw_text(TextFormat("LINES:      %04i", lines), offset.x, offset.y + 20, 10, RF_GRAY);
+            rf_draw_text(autoplay? "[A] AUTOPLAY: ON" : "[A] AUTOPLAY: OFF", offset.x, offset.y + 40, 10, RF_GRAY);
 
             if (pause) rf_draw_text("GAME PAUSED", window.width / 2 - rf_measure_text(rf_get_default_font(), "GAME PAUSED", 40, 0).width / 2, window.height / 2 - 40, 40, RF_GRAY);
         }
@@ -424,6 +519,9 @@ void DrawGame(void)
 void UnloadGame(void)
 {
     // TODO: Unload all dynamic loaded data (textures, sounds, models...)
+#if defined(RAYFORK_ENABLE_THREADS)
+    rf_threads_shutdown();
+#endif
 }
 
 // Update and Draw (one frame)
@@ -449,369 +547,420 @@ static bool Createpiece()
     }
 
     // We assign the incoming piece to the actual piece
-    for (int i = 0; i < 4; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            piece[i][j] = incomingPiece[i][j];
-        }
-    }
+    pieceType = incomingPieceType;
+    pieceRotation = 0;
 
     // We assign a random piece to the incoming one
     GetRandompiece();
 
-    // Assign the piece to the grid
-    for (int i = piecePositionX; i < piecePositionX + 4; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            if (piece[i - (int)piecePositionX][j] == MOVING) grid[i][j] = MOVING;
-        }
-    }
-
     return true;
 }
 
 static void GetRandompiece()
 {
-    int random = GetRandomValue(0, 6);
+    incomingPieceType = GetRandomValue(0, PIECE_TYPES - 1);
+}
 
-    for (int i = 0; i < 4; i++)
+static void ResolveFallingMovement(bool* detection, bool* pieceActive)
+{
+    // If we finished moving this piece, we stop it
+    if (*detection)
     {
+        // Settle the piece squares, empty piece rows may lie below the grid
         for (int j = 0; j < 4; j++)
         {
-            incomingPiece[i][j] = EMPTY;
+            uint16_t mask = pieceMasks[pieceType][pieceRotation][j];
+
+            if (mask != 0) gridRows[piecePositionY + j] |= mask << (piecePositionX + GRID_ROW_OFFSET);
         }
+
+        *detection = false;
+        *pieceActive = false;
+    }
+    else piecePositionY++;  // We move down the piece
+}
+
+static bool ResolveLateralMovement(const platform_input_state* input)
+{
+    bool collision = false;
+
+    // The piece could have been settled this same frame, then there is nothing to move
+    if (!pieceActive) return false;
+
+    // Piece movement
+    if (input->keys[KEYCODE_LEFT] == KEY_RELEASE)        // Move left
+    {
+        // Check if we are touching the left wall or we have a full square at the left
+        collision = CheckPieceCollision(gridRows, pieceType, pieceRotation, piecePositionX - 1, piecePositionY);
+
+        // If able, move left
+        if (!collision) piecePositionX--;
     }
+    else if (input->keys[KEYCODE_RIGHT] == KEY_RELEASE)  // Move right
+    {
+        // Check if we are touching the right wall or we have a full square at the right
+        collision = CheckPieceCollision(gridRows, pieceType, pieceRotation, piecePositionX + 1, piecePositionY);
+
+        // If able move right
+        if (!collision) piecePositionX++;
+    }
+
+    return collision;
+}
 
-    switch (random)
+static bool ResolveTurnMovement(const platform_input_state* input)
+{
+    // Input for turning the piece
+    if (input->keys[KEYCODE_UP] == KEY_HOLD_DOWN)
     {
-    case 0: { incomingPiece[1][1] = MOVING; incomingPiece[2][1] = MOVING; incomingPiece[1][2] = MOVING; incomingPiece[2][2] = MOVING; } break;    //Cube
-    case 1: { incomingPiece[1][0] = MOVING; incomingPiece[1][1] = MOVING; incomingPiece[1][2] = MOVING; incomingPiece[2][2] = MOVING; } break;    //L
-    case 2: { incomingPiece[1][2] = MOVING; incomingPiece[2][0] = MOVING; incomingPiece[2][1] = MOVING; incomingPiece[2][2] = MOVING; } break;    //L inversa
-    case 3: { incomingPiece[0][1] = MOVING; incomingPiece[1][1] = MOVING; incomingPiece[2][1] = MOVING; incomingPiece[3][1] = MOVING; } break;    //Recta
-    case 4: { incomingPiece[1][0] = MOVING; incomingPiece[1][1] = MOVING; incomingPiece[1][2] = MOVING; incomingPiece[2][1] = MOVING; } break;    //Creu tallada
-    case 5: { incomingPiece[1][1] = MOVING; incomingPiece[2][1] = MOVING; incomingPiece[2][2] = MOVING; incomingPiece[3][2] = MOVING; } break;    //S
-    case 6: { incomingPiece[1][2] = MOVING; incomingPiece[2][2] = MOVING; incomingPiece[2][1] = MOVING; incomingPiece[3][1] = MOVING; } break;    //S inversa
+        int rotation = (pieceRotation + 1) % 4;
+
+        // Turn only if the piece is still falling and the turned piece doesn't overlap any solid square
+        if (pieceActive && !CheckPieceCollision(gridRows, pieceType, rotation, piecePositionX, piecePositionY)) pieceRotation = rotation;
+
+        return true;
     }
+
+    return false;
 }
 
-static void ResolveFallingMovement(bool* detection, bool* pieceActive)
+static void CheckDetection(bool* detection)
 {
-    // If we finished moving this piece, we stop it
-    if (*detection)
+    if (CheckPieceCollision(gridRows, pieceType, pieceRotation, piecePositionX, piecePositionY + 1)) *detection = true;
+}
+
+static void CheckCompletion(bool* lineToDelete)
+{
+    for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
     {
-        for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
+        // Check if we completed the whole line and mark it
+        if ((gridRows[j] & GRID_ROW_INSIDE) == GRID_ROW_INSIDE)
         {
-            for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
-            {
-                if (grid[i][j] == MOVING)
-                {
-                    grid[i][j] = FULL;
-                    *detection = false;
-                    *pieceActive = false;
-                }
-            }
+            *lineToDelete = true;
+            fadingLines |= 1u << j;
         }
     }
-    else    // We move down the piece
+}
+
+static void DeleteCompleteLines()
+{
+    // Erase the completed lines from top to bottom, pulling down the rows above each one
+    for (int j = 0; j < GRID_VERTICAL_SIZE - 1; j++)
     {
-        for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
+        if (fadingLines & (1u << j))
         {
-            for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
-            {
-                if (grid[i][j] == MOVING)
-                {
-                    grid[i][j + 1] = MOVING;
-                    grid[i][j] = EMPTY;
-                }
-            }
+            memmove(&gridRows[1], &gridRows[0], j*sizeof(gridRows[0]));
+            gridRows[0] = GRID_ROW_EMPTY;
         }
-
-        piecePositionY++;
     }
+
+    fadingLines = 0;
 }
 
-static bool ResolveLateralMovement(const platform_input_state* input)
+static void InitPieceMasks(void)
 {
-    bool collision = false;
-
-    // Piece movement
-    if (input->keys[KEYCODE_LEFT] == KEY_RELEASE)        // Move left
+    for (int type = 0; type < PIECE_TYPES; type++)
     {
-        // Check if is possible to move to left
-        for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
+        memset(pieceMasks[type], 0, sizeof(pieceMasks[type]));
+
+        for (int k = 0; k < 4; k++) pieceMasks[type][0][pieceShapes[type][k][1]] |= 1 << pieceShapes[type][k][0];
+
+        // Every turn moves the square at (3 - y, x) to (x, y) inside the piece matrix
+        for (int rotation = 1; rotation < 4; rotation++)
         {
-            for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
+            for (int y = 0; y < 4; y++)
             {
-                if (grid[i][j] == MOVING)
+                for (int x = 0; x < 4; x++)
                 {
-                    // Check if we are touching the left wall or we have a full square at the left
-                    if ((i - 1 == 0) || (grid[i - 1][j] == FULL)) collision = true;
+                    if (pieceMasks[type][rotation - 1][x] & (1 << (3 - y))) pieceMasks[type][rotation][y] |= 1 << x;
                 }
             }
         }
+    }
+}
 
-        // If able, move left
-        if (!collision)
-        {
-            for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
-            {
-                for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)             // We check the matrix from left to right
-                {
-                    // Move everything to the left
-                    if (grid[i][j] == MOVING)
-                    {
-                        grid[i - 1][j] = MOVING;
-                        grid[i][j] = EMPTY;
-                    }
-                }
-            }
+// Check if a piece at (x, y) overlaps any solid square, rows below the grid are solid too
+static bool CheckPieceCollision(const uint16_t* rows, int type, int rotation, int x, int y)
+{
+    for (int j = 0; j < 4; j++)
+    {
+        int mask = pieceMasks[type][rotation][j] << (x + GRID_ROW_OFFSET);
 
-            piecePositionX--;
-        }
+        if (mask == 0) continue;
+        if ((y + j >= GRID_VERTICAL_SIZE) || (rows[y + j] & mask)) return true;
     }
-    else if (input->keys[KEYCODE_RIGHT] == KEY_RELEASE)  // Move right
+
+    return false;
+}
+
+// Get the square state drawn at grid position (x, y)
+static GridSquare GetGridSquare(int x, int y)
+{
+    if ((x == 0) || (x == GRID_HORIZONTAL_SIZE - 1) || (y == GRID_VERTICAL_SIZE - 1)) return BLOCK;
+    if (fadingLines & (1u << y)) return FADING;
+
+    int bit = 1 << (x + GRID_ROW_OFFSET);
+
+    if (pieceActive && (y >= piecePositionY) && (y < piecePositionY + 4) &&
+        ((pieceMasks[pieceType][pieceRotation][y - piecePositionY] << (piecePositionX + GRID_ROW_OFFSET)) & bit)) return MOVING;
+
+    if (gridRows[y] & bit) return FULL;
+
+    return EMPTY;
+}
+
+static int CountBits(unsigned int bits)
+{
+    int count = 0;
+
+    for (; bits; bits &= bits - 1) count++;
+
+    return count;
+}
+
+// Get the row where a piece dropped from the top comes to rest, -1 if it doesn't fit at the top
+static int DropPiece(const uint16_t* rows, int type, int rotation, int x)
+{
+    if (CheckPieceCollision(rows, type, rotation, x, 0)) return -1;
+
+    // Shift the piece rows once, then every step down is a few ANDs
+    int masks[4];
+    int height = 0;
+
+    for (int j = 0; j < 4; j++)
     {
-        // Check if is possible to move to right
-        for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
-        {
-            for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
-            {
-                if (grid[i][j] == MOVING)
-                {
-                    // Check if we are touching the right wall or we have a full square at the right
-                    if ((i + 1 == GRID_HORIZONTAL_SIZE - 1) || (grid[i + 1][j] == FULL))
-                    {
-                        collision = true;
+        masks[j] = pieceMasks[type][rotation][j] << (x + GRID_ROW_OFFSET);
+        if (masks[j] != 0) height = j + 1;
+    }
 
-                    }
-                }
-            }
-        }
+    // NOTE: The floor row is solid so the piece always stops inside the grid
+    int y = 0;
 
-        // If able move right
-        if (!collision)
-        {
-            for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
-            {
-                for (int i = GRID_HORIZONTAL_SIZE - 1; i >= 1; i--)             // We check the matrix from right to left
-                {
-                    // Move everything to the right
-                    if (grid[i][j] == MOVING)
-                    {
-                        grid[i + 1][j] = MOVING;
-                        grid[i][j] = EMPTY;
-                    }
-                }
-            }
+    for (;; y++)
+    {
+        bool collision = false;
 
-            piecePositionX++;
-        }
+        for (int j = 0; j < height; j++) collision |= (rows[y + 1 + j] & masks[j]) != 0;
+
+        if (collision) break;
     }
 
-    return collision;
+    return y;
 }
 
-static bool ResolveTurnMovement(const platform_input_state* input)
+// Settle a piece into the rows and remove the completed lines right away, returns the amount of lines removed
+static int PlacePiece(uint16_t* rows, int type, int rotation, int x, int y)
 {
-    // Input for turning the piece
-    if (input->keys[KEYCODE_UP] == KEY_HOLD_DOWN)
+    for (int j = 0; j < 4; j++)
     {
-        int aux = 0;
-        bool checker = false;
+        uint16_t mask = pieceMasks[type][rotation][j];
 
-        // Check all turning possibilities
-        if ((grid[piecePositionX + 3][piecePositionY] == MOVING) &&
-            (grid[piecePositionX][piecePositionY] != EMPTY) &&
-            (grid[piecePositionX][piecePositionY] != MOVING)) checker = true;
+        if (mask != 0) rows[y + j] |= mask << (x + GRID_ROW_OFFSET);
+    }
 
-        if ((grid[piecePositionX + 3][piecePositionY + 3] == MOVING) &&
-            (grid[piecePositionX + 3][piecePositionY] != EMPTY) &&
-            (grid[piecePositionX + 3][piecePositionY] != MOVING)) checker = true;
+    int clearedLines = 0;
 
-        if ((grid[piecePositionX][piecePositionY + 3] == MOVING) &&
-            (grid[piecePositionX + 3][piecePositionY + 3] != EMPTY) &&
-            (grid[piecePositionX + 3][piecePositionY + 3] != MOVING)) checker = true;
+    for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
+    {
+        if ((rows[j] & GRID_ROW_INSIDE) == GRID_ROW_INSIDE) clearedLines++;
+        else if (clearedLines > 0) rows[j + clearedLines] = rows[j];
+    }
 
-        if ((grid[piecePositionX][piecePositionY] == MOVING) &&
-            (grid[piecePositionX][piecePositionY + 3] != EMPTY) &&
-            (grid[piecePositionX][piecePositionY + 3] != MOVING)) checker = true;
+    for (int j = 0; j < clearedLines; j++) rows[j] = GRID_ROW_EMPTY;
 
-        if ((grid[piecePositionX + 1][piecePositionY] == MOVING) &&
-            (grid[piecePositionX][piecePositionY + 2] != EMPTY) &&
-            (grid[piecePositionX][piecePositionY + 2] != MOVING)) checker = true;
+    return clearedLines;
+}
 
-        if ((grid[piecePositionX + 3][piecePositionY + 1] == MOVING) &&
-            (grid[piecePositionX + 1][piecePositionY] != EMPTY) &&
-            (grid[piecePositionX + 1][piecePositionY] != MOVING)) checker = true;
+// Score a board with aggregate height, cleared lines, holes and bumpiness, weights taken from a tuned heuristic
+static float EvaluateBoard(const uint16_t* rows, int clearedLines)
+{
+    // Same game over rule as the game, squares left on the two top rows
+    if ((rows[0] | rows[1]) & GRID_ROW_INSIDE) return AUTOPLAY_TOP_OUT_SCORE;
 
-        if ((grid[piecePositionX + 2][piecePositionY + 3] == MOVING) &&
-            (grid[piecePositionX + 3][piecePositionY + 1] != EMPTY) &&
-            (grid[piecePositionX + 3][piecePositionY + 1] != MOVING)) checker = true;
+    int heights[GRID_HORIZONTAL_SIZE] = { 0 };
+    int covered = 0;
+    int holes = 0;
 
-        if ((grid[piecePositionX][piecePositionY + 2] == MOVING) &&
-            (grid[piecePositionX + 2][piecePositionY + 3] != EMPTY) &&
-            (grid[piecePositionX + 2][piecePositionY + 3] != MOVING)) checker = true;
+    for (int j = 0; j < GRID_VERTICAL_SIZE - 1; j++)
+    {
+        int row = rows[j] & GRID_ROW_INSIDE;
+        int tops = row & ~covered;
 
-        if ((grid[piecePositionX + 2][piecePositionY] == MOVING) &&
-            (grid[piecePositionX][piecePositionY + 1] != EMPTY) &&
-            (grid[piecePositionX][piecePositionY + 1] != MOVING)) checker = true;
+        // Every empty square below a covered one is a hole
+        holes += CountBits(covered & ~row);
 
-        if ((grid[piecePositionX + 3][piecePositionY + 2] == MOVING) &&
-            (grid[piecePositionX + 2][piecePositionY] != EMPTY) &&
-            (grid[piecePositionX + 2][piecePositionY] != MOVING)) checker = true;
+        for (int x = 1; tops && (x < GRID_HORIZONTAL_SIZE - 1); x++)
+        {
+            if (tops & (1 << (x + GRID_ROW_OFFSET))) heights[x] = GRID_VERTICAL_SIZE - 1 - j;
+        }
 
-        if ((grid[piecePositionX + 1][piecePositionY + 3] == MOVING) &&
-            (grid[piecePositionX + 3][piecePositionY + 2] != EMPTY) &&
-            (grid[piecePositionX + 3][piecePositionY + 2] != MOVING)) checker = true;
+        covered |= row;
+    }
 
-        if ((grid[piecePositionX][piecePositionY + 1] == MOVING) &&
-            (grid[piecePositionX + 1][piecePositionY + 3] != EMPTY) &&
-            (grid[piecePositionX + 1][piecePositionY + 3] != MOVING)) checker = true;
+    int height = 0;
+    int bumpiness = 0;
 
-        if ((grid[piecePositionX + 1][piecePositionY + 1] == MOVING) &&
-            (grid[piecePositionX + 1][piecePositionY + 2] != EMPTY) &&
-            (grid[piecePositionX + 1][piecePositionY + 2] != MOVING)) checker = true;
+    for (int x = 1; x < GRID_HORIZONTAL_SIZE - 1; x++)
+    {
+        height += heights[x];
+        if (x > 1) bumpiness += abs(heights[x] - heights[x - 1]);
+    }
 
-        if ((grid[piecePositionX + 2][piecePositionY + 1] == MOVING) &&
-            (grid[piecePositionX + 1][piecePositionY + 1] != EMPTY) &&
-            (grid[piecePositionX + 1][piecePositionY + 1] != MOVING)) checker = true;
+    return -0.510066f*height + 0.760666f*clearedLines - 0.35663f*holes - 0.184483f*bumpiness;
+}
 
-        if ((grid[piecePositionX + 2][piecePositionY + 2] == MOVING) &&
-            (grid[piecePositionX + 2][piecePositionY + 1] != EMPTY) &&
-            (grid[piecePositionX + 2][piecePositionY + 1] != MOVING)) checker = true;
+// NOTE: Runs on the job system threads, it only reads the search and writes its own slot
+static void EvaluatePlacementJob(void* data, rf_int index)
+{
+    PlacementSearch* search = (PlacementSearch*)data;
 
-        if ((grid[piecePositionX + 1][piecePositionY + 2] == MOVING) &&
-            (grid[piecePositionX + 2][piecePositionY + 2] != EMPTY) &&
-            (grid[piecePositionX + 2][piecePositionY + 2] != MOVING)) checker = true;
+    int rotation = (int)index/AUTOPLAY_COLUMNS;
+    int x = (int)index%AUTOPLAY_COLUMNS - 1;
 
-        if (!checker)
-        {
-            aux = piece[0][0];
-            piece[0][0] = piece[3][0];
-            piece[3][0] = piece[3][3];
-            piece[3][3] = piece[0][3];
-            piece[0][3] = aux;
-
-            aux = piece[1][0];
-            piece[1][0] = piece[3][1];
-            piece[3][1] = piece[2][3];
-            piece[2][3] = piece[0][2];
-            piece[0][2] = aux;
-
-            aux = piece[2][0];
-            piece[2][0] = piece[3][2];
-            piece[3][2] = piece[1][3];
-            piece[1][3] = piece[0][1];
-            piece[0][1] = aux;
-
-            aux = piece[1][1];
-            piece[1][1] = piece[2][1];
-            piece[2][1] = piece[2][2];
-            piece[2][2] = piece[1][2];
-            piece[1][2] = aux;
-        }
+    search->valid[index] = false;
 
-        for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
-        {
-            for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
-            {
-                if (grid[i][j] == MOVING)
-                {
-                    grid[i][j] = EMPTY;
-                }
-            }
-        }
+    // Rotations with the same squares as a previous one give the same placements
+    for (int r = 0; r < rotation; r++)
+    {
+        if (memcmp(pieceMasks[search->type][r], pieceMasks[search->type][rotation], sizeof(pieceMasks[0][0])) == 0) return;
+    }
 
-        for (int i = piecePositionX; i < piecePositionX + 4; i++)
+    int y = DropPiece(search->rows, search->type, rotation, x);
+    if (y < 0) return;
+
+    uint16_t board[GRID_VERTICAL_SIZE];
+    memcpy(board, search->rows, sizeof(board));
+
+    int clearedLines = PlacePiece(board, search->type, rotation, x, y);
+    float best = AUTOPLAY_TOP_OUT_SCORE;
+
+    for (int nextRotation = 0; nextRotation < 4; nextRotation++)
+    {
+        for (int nextX = -1; nextX < GRID_HORIZONTAL_SIZE - 2; nextX++)
         {
-            for (int j = piecePositionY; j < piecePositionY + 4; j++)
-            {
-                if (piece[i - piecePositionX][j - piecePositionY] == MOVING)
-                {
-                    grid[i][j] = MOVING;
-                }
-            }
-        }
+            int nextY = DropPiece(board, search->nextType, nextRotation, nextX);
+            if (nextY < 0) continue;
 
-        return true;
+            uint16_t nextBoard[GRID_VERTICAL_SIZE];
+            memcpy(nextBoard, board, sizeof(nextBoard));
+
+            int nextClearedLines = PlacePiece(nextBoard, search->nextType, nextRotation, nextX, nextY);
+            float score = EvaluateBoard(nextBoard, clearedLines + nextClearedLines);
+
+            if (score > best) best = score;
+        }
     }
 
-    return false;
+    search->scores[index] = best;
+    search->valid[index] = true;
 }
 
-static void CheckDetection(bool* detection)
+// Find the best placement for a piece looking ahead at the incoming one, false if the piece doesn't fit anywhere
+static bool SearchPlacement(const uint16_t* rows, int type, int nextType, Placement* best)
 {
-    for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
+    PlacementSearch search = { 0 };
+    search.rows = rows;
+    search.type = type;
+    search.nextType = nextType;
+
+    // Use the job system set on the context, same as rayfork does
+    rf_job_system jobs = ctx.job_system.parallel_for_proc? ctx.job_system : RF_DEFAULT_JOB_SYSTEM;
+    jobs.parallel_for_proc(jobs.user_data, EvaluatePlacementJob, &search, AUTOPLAY_PLACEMENTS);
+
+    // Pick the first best candidate so the result doesn't depend on the job order
+    bool found = false;
+
+    for (int i = 0; i < AUTOPLAY_PLACEMENTS; i++)
     {
-        for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
+        if (search.valid[i] && (!found || (search.scores[i] > best->score)))
         {
-            if ((grid[i][j] == MOVING) && ((grid[i][j + 1] == FULL) || (grid[i][j + 1] == BLOCK))) *detection = true;
+            best->rotation = i/AUTOPLAY_COLUMNS;
+            best->x = i%AUTOPLAY_COLUMNS - 1;
+            best->score = search.scores[i];
+            found = true;
         }
     }
+
+    return found;
 }
 
-static void CheckCompletion(bool* lineToDelete)
+static void ResolveAutoplayMovement(void)
 {
-    int calculator = 0;
+    Placement placement;
 
-    for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
+    // The search drops pieces from the spawn row, so turn and move the new piece there and let it fall
+    if (SearchPlacement(gridRows, pieceType, incomingPieceType, &placement))
     {
-        calculator = 0;
-        for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
-        {
-            // Count each square of the line
-            if (grid[i][j] == FULL)
-            {
-                calculator++;
-            }
+        pieceRotation = placement.rotation;
+        piecePositionX = placement.x;
+    }
+}
 
-            // Check if we completed the whole line
-            if (calculator == GRID_HORIZONTAL_SIZE - 2)
-            {
-                *lineToDelete = true;
-                calculator = 0;
-                // points++;
+// Threads a placement search runs on, only known for the thread pool of rayfork, other job systems count as one
+static int GetSearchThreads(void)
+{
+    int threads = 1;
 
-                // Mark the completed line
-                for (int z = 1; z < GRID_HORIZONTAL_SIZE - 1; z++)
-                {
-                    grid[z][j] = FADING;
-                }
-            }
-        }
+#if defined(RAYFORK_ENABLE_THREADS)
+    rf_job_system jobs = ctx.job_system.parallel_for_proc? ctx.job_system : RF_DEFAULT_JOB_SYSTEM;
+
+    if (jobs.parallel_for_proc == rf_threads_parallel_for)
+    {
+        threads = rf_threads_count();
+        if (jobs.user_data && (*(int*)jobs.user_data < threads)) threads = *(int*)jobs.user_data;
+        if (threads > AUTOPLAY_PLACEMENTS) threads = AUTOPLAY_PLACEMENTS;
+        if (threads < 1) threads = 1;
     }
+#endif
+
+    return threads;
 }
 
-static void DeleteCompleteLines()
+static void InitSoak(void)
 {
-    // Erase the completed line
-    for (int j = GRID_VERTICAL_SIZE - 2; j >= 0; j--)
+    for (int j = 0; j < GRID_VERTICAL_SIZE - 1; j++) soakRows[j] = GRID_ROW_EMPTY;
+    soakRows[GRID_VERTICAL_SIZE - 1] = GRID_ROW_BLOCK;
+
+    soakType = GetRandomValue(0, PIECE_TYPES - 1);
+    soakNextType = GetRandomValue(0, PIECE_TYPES - 1);
+
+    soakPlacements = 0;
+    soakLines = 0;
+    soakGames = 0;
+    soakTime = 0;
+    soakThreads = GetSearchThreads();
+}
+
+static void UpdateSoak(void)
+{
+    uint64_t start = stm_now();
+
+    do
     {
-        while (grid[1][j] == FADING)
+        Placement placement;
+        bool topOut = !SearchPlacement(soakRows, soakType, soakNextType, &placement);
+
+        if (!topOut)
         {
-            for (int i = 1; i < GRID_HORIZONTAL_SIZE - 1; i++)
-            {
-                grid[i][j] = EMPTY;
-            }
+            int y = DropPiece(soakRows, soakType, placement.rotation, placement.x);
 
-            for (int j2 = j - 1; j2 >= 0; j2--)
-            {
-                for (int i2 = 1; i2 < GRID_HORIZONTAL_SIZE - 1; i2++)
-                {
-                    if (grid[i2][j2] == FULL)
-                    {
-                        grid[i2][j2 + 1] = FULL;
-                        grid[i2][j2] = EMPTY;
-                    }
-                    else if (grid[i2][j2] == FADING)
-                    {
-                        grid[i2][j2 + 1] = FADING;
-                        grid[i2][j2] = EMPTY;
-                    }
-                }
-            }
+            soakLines += PlacePiece(soakRows, soakType, placement.rotation, placement.x, y);
+            soakPlacements++;
+
+            topOut = (soakRows[0] | soakRows[1]) & GRID_ROW_INSIDE;
+        }
+
+        // Start over on an empty board when the autoplayer loses
+        if (topOut)
+        {
+            for (int j = 0; j < GRID_VERTICAL_SIZE - 1; j++) soakRows[j] = GRID_ROW_EMPTY;
+            soakGames++;
         }
+
+        soakType = soakNextType;
+        soakNextType = GetRandomValue(0, PIECE_TYPES - 1);
     }
-}
\ No newline at end of file
+    while (stm_sec(stm_since(start)) < SOAK_FRAME_TIME);
+
+    soakTime += stm_sec(stm_since(start));
+}